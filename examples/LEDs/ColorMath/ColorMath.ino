@@ -0,0 +1,199 @@
+/* -*- mode: c++ -*-
+ * ColorMath -- Benchmark of the fixed point color math
+ * Copyright (C) 2025  Keyboard.io, Inc
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Every five seconds, this sketch converts a few hundred pixels with the color
+// math of `kaleidoscope::color_math`, and with the code it replaced, and prints
+// how many CPU cycles each took per pixel, over Serial.
+
+#include <Kaleidoscope.h>
+#include <Kaleidoscope-LEDControl.h>
+
+// clang-format off
+KEYMAPS(
+  [0] = KEYMAP_STACKED
+  (
+    Key_NoKey,    Key_1, Key_2, Key_3, Key_4, Key_5, Key_NoKey,
+    Key_Backtick, Key_Q, Key_W, Key_E, Key_R, Key_T, Key_Tab,
+    Key_PageUp,   Key_A, Key_S, Key_D, Key_F, Key_G,
+    Key_PageDown,   Key_Z, Key_X, Key_C, Key_V, Key_B, Key_Escape,
+
+    Key_LeftControl, Key_Backspace, Key_LeftGui, Key_LeftShift,
+    Key_skip,
+
+    Key_skip,  Key_6, Key_7, Key_8,     Key_9,      Key_0,         Key_skip,
+    Key_Enter, Key_Y, Key_U, Key_I,     Key_O,      Key_P,         Key_Equals,
+               Key_H, Key_J, Key_K,     Key_L,      Key_Semicolon, Key_Quote,
+    Key_skip,  Key_N, Key_M, Key_Comma, Key_Period, Key_Slash,     Key_Minus,
+
+    Key_RightShift, Key_RightAlt, Key_Spacebar, Key_RightControl,
+    Key_skip),
+)
+// clang-format on
+
+KALEIDOSCOPE_INIT_PLUGINS(LEDControl, LEDOff);
+
+namespace color_math = kaleidoscope::color_math;
+
+static constexpr uint16_t pixels = 256;
+static volatile uint8_t sink;
+
+static void consume(cRGB color) {
+  sink = color.r ^ color.g ^ color.b;
+}
+
+// The code the color math replaced, to compare with.
+namespace reference {
+
+cRGB hsvToRgb(uint16_t h, uint16_t s, uint16_t v) {
+  cRGB color;
+  uint16_t region, fpart, p, q, t;
+
+  if (s == 0) {
+    color.r = color.g = color.b = v;
+    return color;
+  }
+
+  region = (h * 6) >> 8;
+  fpart  = (h * 6) - (region << 8);
+
+  p = (v * (255 - s)) >> 8;
+  q = (v * (255 - ((s * fpart) >> 8))) >> 8;
+  t = (v * (255 - ((s * (255 - fpart)) >> 8))) >> 8;
+
+  switch (region) {
+  case 0:
+    color.r = v, color.g = t, color.b = p;
+    break;
+  case 1:
+    color.r = q, color.g = v, color.b = p;
+    break;
+  case 2:
+    color.r = p, color.g = v, color.b = t;
+    break;
+  case 3:
+    color.r = p, color.g = q, color.b = v;
+    break;
+  case 4:
+    color.r = t, color.g = p, color.b = v;
+    break;
+  default:
+    color.r = v, color.g = p, color.b = q;
+    break;
+  }
+  return color;
+}
+
+uint8_t breath(uint8_t i) {
+  if (i & 0x80)
+    i = 255 - i;
+  i           = i << 1;
+  uint8_t ii  = (i * i) >> 8;
+  uint8_t iii = (ii * i) >> 8;
+  return (((3 * (uint16_t)(ii)) - (2 * (uint16_t)(iii))) / 2) + 80;
+}
+
+cRGB paletteColor(const cRGB *palette, uint8_t length, float v) {
+  float fb = 0;
+  uint8_t idx1, idx2;
+
+  if (v <= 0) {
+    idx1 = idx2 = 0;
+  } else if (v >= 1) {
+    idx1 = idx2 = length - 1;
+  } else {
+    float val = v * (length - 1);
+    idx1      = static_cast<int>(val);
+    idx2      = idx1 + 1;
+    fb        = val - static_cast<float>(idx1);
+  }
+
+  cRGB color;
+  color.r = (pgm_read_byte(&palette[idx2].r) - pgm_read_byte(&palette[idx1].r)) * fb + pgm_read_byte(&palette[idx1].r);
+  color.g = (pgm_read_byte(&palette[idx2].g) - pgm_read_byte(&palette[idx1].g)) * fb + pgm_read_byte(&palette[idx1].g);
+  color.b = (pgm_read_byte(&palette[idx2].b) - pgm_read_byte(&palette[idx1].b)) * fb + pgm_read_byte(&palette[idx1].b);
+  return color;
+}
+
+}  // namespace reference
+
+static const cRGB palette[] PROGMEM = {
+  CRGB(0, 0, 0),
+  CRGB(25, 255, 25),
+  CRGB(255, 255, 25),
+  CRGB(255, 25, 25),
+};
+
+static void report(const __FlashStringHelper *name, uint32_t reference_us, uint32_t fixed_us) {
+  constexpr uint8_t cycles_per_us = F_CPU / 1000000;
+
+  Serial.print(name);
+  Serial.print(F(": "));
+  Serial.print(reference_us * cycles_per_us / pixels);
+  Serial.print(F(" -> "));
+  Serial.print(fixed_us * cycles_per_us / pixels);
+  Serial.println(F(" cycles per pixel"));
+}
+
+static void benchmark() {
+  uint32_t start, reference_us, fixed_us;
+
+  start = micros();
+  for (uint16_t i = 0; i < pixels; i++)
+    consume(reference::hsvToRgb(i & 0xff, 255 - i / 4, 200));
+  reference_us = micros() - start;
+  start        = micros();
+  for (uint16_t i = 0; i < pixels; i++)
+    consume(color_math::hsvToRgb(i & 0xff, 255 - i / 4, 200));
+  fixed_us = micros() - start;
+  report(F("hsvToRgb"), reference_us, fixed_us);
+
+  start = micros();
+  for (uint16_t i = 0; i < pixels; i++)
+    consume(reference::hsvToRgb(170, 255, reference::breath(i)));
+  reference_us = micros() - start;
+  start        = micros();
+  for (uint16_t i = 0; i < pixels; i++)
+    consume(color_math::hsvToRgb(170, 255, color_math::breath8(i)));
+  fixed_us = micros() - start;
+  report(F("breath"), reference_us, fixed_us);
+
+  start = micros();
+  for (uint16_t i = 0; i < pixels; i++)
+    consume(reference::paletteColor(palette, 4, static_cast<float>(i & 0xff) / 255));
+  reference_us = micros() - start;
+  start        = micros();
+  for (uint16_t i = 0; i < pixels; i++)
+    consume(color_math::paletteColor(palette, 4, i & 0xff));
+  fixed_us = micros() - start;
+  report(F("palette"), reference_us, fixed_us);
+}
+
+void setup() {
+  Kaleidoscope.serialPort().begin(9600);
+  Kaleidoscope.setup();
+}
+
+void loop() {
+  static uint16_t last_benchmark = 0;
+
+  Kaleidoscope.loop();
+
+  if (kaleidoscope::Runtime.hasTimeExpired(last_benchmark, uint16_t(5000))) {
+    benchmark();
+    last_benchmark = kaleidoscope::Runtime.millisAtCycleStart();
+  }
+}
@@ -0,0 +1,108 @@
+/* -*- mode: c++ -*-
+ * FrameSlices -- Benchmark of the longest cycle of costly LED modes
+ * Copyright (C) 2025  Keyboard.io, Inc
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This sketch runs `LEDOff`, `Wavepool` and `Heatmap` for five seconds each, in
+// turn, and prints the longest and the average cycle each of them took over
+// Serial, in microseconds. `LEDOff` is the baseline, the cost of a cycle
+// without an LED mode painting anything. It only uses the public API, so it
+// builds with releases from before LED modes could paint their frames in
+// slices too, to compare with.
+
+#include <Kaleidoscope.h>
+#include <Kaleidoscope-LEDControl.h>
+#include <Kaleidoscope-LED-Wavepool.h>
+#include <Kaleidoscope-Heatmap.h>
+
+// clang-format off
+KEYMAPS(
+  [0] = KEYMAP_STACKED
+  (
+    Key_NoKey,    Key_1, Key_2, Key_3, Key_4, Key_5, Key_NoKey,
+    Key_Backtick, Key_Q, Key_W, Key_E, Key_R, Key_T, Key_Tab,
+    Key_PageUp,   Key_A, Key_S, Key_D, Key_F, Key_G,
+    Key_PageDown,   Key_Z, Key_X, Key_C, Key_V, Key_B, Key_Escape,
+
+    Key_LeftControl, Key_Backspace, Key_LeftGui, Key_LeftShift,
+    Key_skip,
+
+    Key_skip,  Key_6, Key_7, Key_8,     Key_9,      Key_0,         Key_skip,
+    Key_Enter, Key_Y, Key_U, Key_I,     Key_O,      Key_P,         Key_Equals,
+               Key_H, Key_J, Key_K,     Key_L,      Key_Semicolon, Key_Quote,
+    Key_skip,  Key_N, Key_M, Key_Comma, Key_Period, Key_Slash,     Key_Minus,
+
+    Key_RightShift, Key_RightAlt, Key_Spacebar, Key_RightControl,
+    Key_skip),
+)
+// clang-format on
+
+KALEIDOSCOPE_INIT_PLUGINS(LEDControl, LEDOff, WavepoolEffect, HeatmapEffect);
+
+static uint32_t longest_us;
+static uint32_t total_us;
+static uint32_t cycles;
+
+static void report(const __FlashStringHelper *name) {
+  Serial.print(name);
+  Serial.print(F(": longest "));
+  Serial.print(longest_us);
+  Serial.print(F(" us, average "));
+  Serial.print(total_us / cycles);
+  Serial.println(F(" us per cycle"));
+
+  longest_us = 0;
+  total_us   = 0;
+  cycles     = 0;
+}
+
+void setup() {
+  Kaleidoscope.serialPort().begin(9600);
+  Kaleidoscope.setup();
+  LEDOff.activate();
+}
+
+void loop() {
+  static uint16_t last_benchmark = 0;
+  static uint8_t mode            = 0;
+
+  uint32_t start = micros();
+  Kaleidoscope.loop();
+  uint32_t cycle_us = micros() - start;
+
+  if (cycle_us > longest_us)
+    longest_us = cycle_us;
+  total_us += cycle_us;
+  cycles++;
+
+  if (kaleidoscope::Runtime.hasTimeExpired(last_benchmark, uint16_t(5000))) {
+    switch (mode) {
+    case 0:
+      report(F("LEDOff"));
+      WavepoolEffect.activate();
+      break;
+    case 1:
+      report(F("Wavepool"));
+      HeatmapEffect.activate();
+      break;
+    default:
+      report(F("Heatmap"));
+      LEDOff.activate();
+      break;
+    }
+    mode           = (mode + 1) % 3;
+    last_benchmark = kaleidoscope::Runtime.millisAtCycleStart();
+  }
+}
@@ -281,6 +281,7 @@ class AutoShiftConfig : public Plugin {
  public:
   EventHandlerResult onSetup();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
   void disableAutoShiftIfUnconfigured();
 
  private:
@@ -47,6 +47,11 @@ void AutoShiftConfig::disableAutoShiftIfUnconfigured() {
     ::AutoShift.disable();
 }
 
+FOCUS_COMMANDS(AutoShiftConfig,
+               "autoshift.enabled",
+               "autoshift.timeout",
+               "autoshift.categories")
+
 EventHandlerResult AutoShiftConfig::onFocusEvent(const char *input) {
   enum {
     ENABLED,
@@ -54,12 +59,9 @@ EventHandlerResult AutoShiftConfig::onFocusEvent(const char *input) {
     CATEGORIES,
   } subCommand;
 
-  const char *cmd_enabled    = PSTR("autoshift.enabled");
-  const char *cmd_timeout    = PSTR("autoshift.timeout");
-  const char *cmd_categories = PSTR("autoshift.categories");
-
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_enabled, cmd_timeout, cmd_categories);
+  const auto cmd_enabled    = FOCUS_COMMAND("autoshift.enabled");
+  const auto cmd_timeout    = FOCUS_COMMAND("autoshift.timeout");
+  const auto cmd_categories = FOCUS_COMMAND("autoshift.categories");
 
   if (::Focus.inputMatchesCommand(input, cmd_enabled))
     subCommand = ENABLED;
@@ -21,7 +21,7 @@
  */
 #include "kaleidoscope/plugin/Chord.h"
 
-#include <Arduino.h>  // for PROGMEM
+#include <Arduino.h>  // for PROGMEM, pgm_read_byte
 #include <stdint.h>   // for uint8_t, uint16_t, int8_t
 
 #include "kaleidoscope/KeyAddr.h"               // for KeyAddr
@@ -56,7 +56,7 @@ EventHandlerResult Chord::onKeyswitchEvent(KeyEvent &event) {
   Key target_key = getChord();
 
   if (target_key == Key_NoKey) {
-    potential_chord_size_--;
+    dropLastEvent();
     resolveOrArpeggiate();
     return EventHandlerResult::OK;
   }
@@ -95,88 +95,83 @@ void Chord::resolve(Key target_key) {
   Runtime.handleKeyEvent(restored_event);
 }
 
-bool Chord::inChord(uint8_t index, Key key) {
-  for (uint8_t i = index; index < chord_defs_size_ - 1; i++) {
-    Key chord_key = cloneFromProgmem(chord_defs_[i]);
-    if (chord_key == Key_NoKey) {
-      return false;
-    }
-    if (chord_key == key) {
-      return true;
-    }
-  }
-  return false;
-}
-
 bool Chord::isChordStrictSubset() {
-  uint8_t c = 0;
-  while (c < chord_defs_size_) {
-    uint8_t cs = chordSize(c);
-    if (isChordStrictSubsetOf(c, cs)) {
-      return true;
-    }
-    c += cs + 2;
-  }
-  return false;
+  return findCandidate(true) < chord_count_;
 }
 
-bool Chord::isChordStrictSubsetOf(uint8_t c, uint8_t cs) {
-  if (cs <= potential_chord_size_) {
-    return false;
-  }
-  for (uint8_t i = 0; i < potential_chord_size_; i++) {
-    if (!inChord(c, potential_chord_[i].key)) {
-      return false;
-    }
-  }
-  return true;
+Key Chord::getChord() {
+  uint8_t c = findCandidate(false);
+  if (c == chord_count_)
+    return Key_NoKey;
+  return cloneFromProgmem(results_[c]);
 }
 
-uint8_t Chord::chordSize(uint8_t index) {
-  uint8_t size = 0;
-  uint8_t i    = index;
-  while (i < chord_defs_size_ - 1) {
-    Key key = cloneFromProgmem(chord_defs_[i]);
-    if (key == Key_NoKey) {
-      break;
+// Returns the index of the first chord that contains all of the keys in
+// `potential_chord_`, and either has exactly as many keys (if `larger` is
+// `false`), or more keys (if it's `true`). Returns `chord_count_` if there is
+// no such chord.
+uint8_t Chord::findCandidate(bool larger) {
+  if (potential_chord_size_ == 0)
+    return chord_count_;
+
+  for (uint8_t i = 0; i < mask_bytes_; i++) {
+    uint8_t bits = candidates_[i];
+    for (uint8_t c = i * 8; bits != 0; c++, bits >>= 1) {
+      if (!(bits & 1))
+        continue;
+      uint8_t size = pgm_read_byte(&sizes_[c]);
+      if (larger ? size > potential_chord_size_ : size == potential_chord_size_)
+        return c;
     }
-    size++;
-    i++;
   }
-  return size;
+  return chord_count_;
 }
 
-bool Chord::isChord(uint8_t c, uint8_t cs) {
-  if (cs != potential_chord_size_) {
-    return false;
-  }
-  for (uint8_t i = 0; i < potential_chord_size_; i++) {
-    if (!inChord(c, potential_chord_[i].key)) {
-      return false;
+// Returns the index of `key` in the table's sorted list of chord keys, or
+// `key_count_` if it isn't part of any chord.
+uint8_t Chord::keyIndex(Key key) {
+  uint8_t lo = 0;
+  uint8_t hi = key_count_;
+  while (lo < hi) {
+    uint8_t mid = lo + (hi - lo) / 2;
+    Key mid_key = cloneFromProgmem(keys_[mid]);
+    if (mid_key == key)
+      return mid;
+    if (mid_key < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
   }
-  return true;
+  return key_count_;
 }
 
-Key Chord::getChord() {
-  uint8_t c = 0;
-  while (c < chord_defs_size_) {
-    uint8_t cs = chordSize(c);
-    if (isChord(c, cs)) {
-      return cloneFromProgmem(chord_defs_[c + cs + 1]);
-    }
-    c += cs + 2;
+// Removes from the candidate chords any that don't contain `key`. If `first` is
+// `true`, the candidates are instead reset to the chords containing `key`.
+void Chord::narrowCandidates(Key key, bool first) {
+  uint8_t k = keyIndex(key);
+  for (uint8_t i = 0; i < mask_bytes_; i++) {
+    uint8_t bits = 0;
+    if (k < key_count_)
+      bits = pgm_read_byte(&members_[k * mask_bytes_ + i]);
+    candidates_[i] = first ? bits : candidates_[i] & bits;
   }
-  return Key_NoKey;
 }
 
 void Chord::appendEvent(KeyEvent event) {
   if (potential_chord_size_ < kMaxChordSize) {
+    narrowCandidates(event.key, potential_chord_size_ == 0);
     potential_chord_[potential_chord_size_] = event;
     potential_chord_size_++;
   }
 }
 
+void Chord::dropLastEvent() {
+  potential_chord_size_--;
+  for (uint8_t i = 0; i < potential_chord_size_; i++)
+    narrowCandidates(potential_chord_[i].key, i == 0);
+}
+
 void Chord::arpeggiate() {
   for (uint8_t i = 0; i < potential_chord_size_; i++) {
     KeyEvent event          = potential_chord_[i];
@@ -24,14 +24,14 @@
 #include <Arduino.h>  // for PROGMEM
 #include <stdint.h>   // for uint8_t, uint16_t, int8_t
 
-#include "kaleidoscope/KeyAddr.h"               // for KeyAddr
-#include "kaleidoscope/KeyEvent.h"              // for KeyEvent
-#include "kaleidoscope/KeyEventTracker.h"       // for KeyEventTracker
-#include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
-#include "kaleidoscope/plugin.h"                // for Plugin
-#include "kaleidoscope/key_defs.h"              // for Key, Key_Transparent
-#include "kaleidoscope/progmem_helpers.h"       // for cloneFromProgmem
-
+#include "kaleidoscope/KeyAddr.h"                  // for KeyAddr
+#include "kaleidoscope/KeyEvent.h"                 // for KeyEvent
+#include "kaleidoscope/KeyEventTracker.h"          // for KeyEventTracker
+#include "kaleidoscope/event_handler_result.h"     // for EventHandlerResult
+#include "kaleidoscope/plugin.h"                   // for Plugin
+#include "kaleidoscope/key_defs.h"                 // for Key, Key_Transparent
+#include "kaleidoscope/plugin/Chord/ChordTable.h"  // for Table, countChords, countKeys
+#include "kaleidoscope/progmem_helpers.h"          // for cloneFromProgmem
 
 namespace kaleidoscope {
 namespace plugin {
@@ -41,22 +41,32 @@ class Chord : public kaleidoscope::Plugin {
   EventHandlerResult afterEachCycle();
   void setTimeout(uint8_t timeout);
 
-  template<uint8_t _chord_defs_size>
-  void configure(Key const (&chords)[_chord_defs_size]) {
-    chord_defs_      = chords;
-    chord_defs_size_ = _chord_defs_size;
+  /// Use the chords in `table`, which must be stored in PROGMEM
+  ///
+  /// `candidates` must have room for `_Table::mask_bytes` bytes. This is called
+  /// by the `CHORDS()` macro, which also builds the table.
+  template<typename _Table>
+  void configure(_Table const &table, uint8_t *candidates) {
+    keys_        = table.keys;
+    members_     = &table.members[0][0];
+    sizes_       = table.sizes;
+    results_     = table.results;
+    key_count_   = _Table::key_count;
+    chord_count_ = _Table::chord_count;
+    mask_bytes_  = _Table::mask_bytes;
+    candidates_  = candidates;
   }
 
  private:
   void resolveOrArpeggiate();
   void resolve(Key target_key);
-  bool inChord(uint8_t index, Key key);
   bool isChordStrictSubset();
-  bool isChordStrictSubsetOf(uint8_t c, uint8_t cs);
-  uint8_t chordSize(uint8_t index);
-  bool isChord(uint8_t c, uint8_t cs);
   Key getChord();
+  uint8_t findCandidate(bool larger);
+  uint8_t keyIndex(Key key);
+  void narrowCandidates(Key key, bool first);
   void appendEvent(KeyEvent event);
+  void dropLastEvent();
   void arpeggiate();
 
   KeyEventTracker event_tracker_;
@@ -66,8 +76,17 @@ class Chord : public kaleidoscope::Plugin {
   KeyEvent potential_chord_[kMaxChordSize];
   uint8_t potential_chord_size_{0};
 
-  Key const *chord_defs_{nullptr};
-  uint8_t chord_defs_size_{0};
+  // The chord table (see `chord::Table`), in PROGMEM
+  Key const *keys_{nullptr};
+  uint8_t const *members_{nullptr};
+  uint8_t const *sizes_{nullptr};
+  Key const *results_{nullptr};
+  uint8_t key_count_{0};
+  uint8_t chord_count_{0};
+  uint8_t mask_bytes_{0};
+
+  // A bitmap of the chords that contain every key in `potential_chord_`
+  uint8_t *candidates_{nullptr};
 
   uint8_t timeout_ = 50;
 };
@@ -76,9 +95,15 @@ class Chord : public kaleidoscope::Plugin {
 
 extern kaleidoscope::plugin::Chord Chord;
 
-#define CHORDS(chord_defs...)                            \
-  {                                                      \
-    static Key const chord_def[] PROGMEM = {chord_defs}; \
-    Chord.configure(chord_def);                          \
+#define CHORDS(chord_defs...)                                                       \
+  {                                                                                 \
+    static constexpr Key chord_def[] = {chord_defs};                                \
+    typedef ::kaleidoscope::plugin::chord::Table<                                   \
+      ::kaleidoscope::plugin::chord::countChords(chord_def),                        \
+      ::kaleidoscope::plugin::chord::countKeys(chord_def)>                          \
+      ChordTable;                                                                   \
+    static constexpr ChordTable chord_table PROGMEM = ChordTable(chord_def);        \
+    static uint8_t chord_candidates[ChordTable::mask_bytes];                        \
+    Chord.configure(chord_table, chord_candidates);                                 \
   }
 #define CHORD(chord_keys...) chord_keys, Key_NoKey
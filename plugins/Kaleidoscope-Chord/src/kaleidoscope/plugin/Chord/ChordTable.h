@@ -0,0 +1,142 @@
+/* Kaleidoscope-Chord -- Chord keys for Kaleidoscope
+ * Copyright (C) 2013-2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>  // for uint8_t, uint16_t
+
+#include "kaleidoscope/key_defs.h"  // for Key, Key_NoKey
+
+namespace kaleidoscope {
+namespace plugin {
+namespace chord {
+
+// The `CHORDS()` macro defines the chords as a flat list of keys, in which each
+// chord is a sequence of keys terminated by `Key_NoKey`, followed by the
+// resulting key. The functions below are only used at compile time, to turn
+// that list into a `Table`.
+
+template<uint16_t _size>
+constexpr uint16_t countChords(Key const (&defs)[_size]) {
+  uint16_t count = 0;
+  for (uint16_t i = 0; i < _size; ++i) {
+    if (defs[i] == Key_NoKey) {
+      // Skip the result key
+      ++i;
+      ++count;
+    }
+  }
+  return count;
+}
+
+template<uint16_t _size>
+constexpr bool isFirstOccurrence(Key const (&defs)[_size], uint16_t index) {
+  for (uint16_t i = 0; i < index; ++i) {
+    if (defs[i] == Key_NoKey) {
+      ++i;
+    } else if (defs[i] == defs[index]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Counts the distinct keys that are part of any chord.
+template<uint16_t _size>
+constexpr uint16_t countKeys(Key const (&defs)[_size]) {
+  uint16_t count = 0;
+  for (uint16_t i = 0; i < _size; ++i) {
+    if (defs[i] == Key_NoKey) {
+      ++i;
+    } else if (isFirstOccurrence(defs, i)) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+/// The chord definitions, indexed by key
+///
+/// Each chord is numbered in the order it was defined. For every distinct key
+/// that is part of any chord, `members` holds a bitmap of the chords that key
+/// belongs to, so the set of chords that contain all of the keys pressed so far
+/// can be found with one bitwise AND per key. The size and resulting key of each
+/// chord are stored separately, so a chord can be checked for an exact match
+/// (or for having more keys than have been pressed) without reading its keys.
+///
+/// The keys themselves are sorted by their raw values, to be found by binary
+/// search. The whole table is computed at compile time, and stored in PROGMEM.
+template<uint16_t _chord_count, uint16_t _key_count>
+struct Table {
+  static_assert(_chord_count > 0 && _chord_count <= 255,
+                "CHORDS() must define between 1 and 255 chords");
+  static_assert(_key_count <= 255,
+                "CHORDS() can't use more than 255 different keys");
+
+  static constexpr uint8_t chord_count = _chord_count;
+  static constexpr uint8_t key_count   = _key_count;
+  static constexpr uint8_t mask_bytes  = (_chord_count + 7) / 8;
+
+  Key keys[_key_count];
+  uint8_t members[_key_count][mask_bytes];
+  uint8_t sizes[_chord_count];
+  Key results[_chord_count];
+
+  template<uint16_t _size>
+  constexpr explicit Table(Key const (&defs)[_size])
+    : keys{}, members{}, sizes{}, results{} {
+    // Collect the distinct keys, in sorted order (insertion sort).
+    uint8_t n = 0;
+    for (uint16_t i = 0; i < _size; ++i) {
+      if (defs[i] == Key_NoKey) {
+        ++i;
+        continue;
+      }
+      if (!isFirstOccurrence(defs, i))
+        continue;
+      uint8_t j = n++;
+      while (j > 0 && defs[i].getRaw() < keys[j - 1].getRaw()) {
+        keys[j] = keys[j - 1];
+        --j;
+      }
+      keys[j] = defs[i];
+    }
+
+    // Record each chord's size, result, and membership bits.
+    uint8_t c = 0;
+    for (uint16_t i = 0; i < _size; ++i) {
+      if (defs[i] == Key_NoKey) {
+        results[c++] = (i + 1 < _size) ? defs[++i] : Key_NoKey;
+        continue;
+      }
+      ++sizes[c];
+      uint8_t k = 0;
+      while (keys[k] != defs[i])
+        ++k;
+      members[k][c / 8] |= 1 << (c % 8);
+    }
+  }
+};
+
+}  // namespace chord
+}  // namespace plugin
+}  // namespace kaleidoscope
@@ -60,26 +60,26 @@ bool ColormapOverlay::hasOverlay(KeyAddr k) {
 }
 
 EventHandlerResult ColormapOverlay::onSetup() {
+  ::LEDControl.addOverlay(*this);
   return EventHandlerResult::OK;
 }
 
-void ColormapOverlay::setLEDOverlayColors() {
-  if (!Runtime.has_leds)
-    return;
-
-  for (auto key_addr : KeyAddr::all()) {
-    if (ColormapOverlay::hasOverlay(key_addr)) {
-      ::LEDControl.setCrgbAt(KeyAddr(key_addr), selectedColor);
-    } else {
-      ::LEDControl.refreshAt(KeyAddr(key_addr));
-    }
+// Covers every key that has an overlay on any layer. Which of them are lit
+// depends on the active layers, and is decided while compositing.
+void ColormapOverlay::coverOverlays() {
+  uncoverAll();
+  for (uint8_t i{0}; i < overlay_count_; ++i) {
+    if (overlays_[i].addr.isValid())
+      cover(overlays_[i].addr);
   }
 }
 
-EventHandlerResult ColormapOverlay::beforeSyncingLeds() {
-  setLEDOverlayColors();
+bool ColormapOverlay::overlayColorAt(KeyAddr key_addr, cRGB &color) {
+  if (!hasOverlay(key_addr))
+    return false;
 
-  return EventHandlerResult::OK;
+  color = selectedColor;
+  return true;
 }
 
 }  // namespace plugin
@@ -30,6 +30,7 @@
 #include "kaleidoscope/key_defs.h"              // for Key, KEY_FLAGS, Key_NoKey, LockLayer
 #include "kaleidoscope/layers.h"                // for Layer, Layer_
 #include "kaleidoscope/plugin/LEDControl.h"     // for LEDControl
+#include "kaleidoscope/plugin/LEDOverlay.h"     // for LEDOverlay
 #include <Kaleidoscope-LED-Palette-Theme.h>     // for LEDPaletteTheme
 
 namespace kaleidoscope {
@@ -51,7 +52,8 @@ struct Overlay {
     : layer(layer), addr(k), palette_index(palette_index) {}
 };
 
-class ColormapOverlay : public kaleidoscope::Plugin {
+class ColormapOverlay : public kaleidoscope::Plugin,
+                        public LEDOverlay {
  public:
   static void setup();
   // Function for defining the array of overlays. It's a template function that
@@ -73,6 +75,7 @@ class ColormapOverlay : public kaleidoscope::Plugin {
 
     overlays_      = new_overlays;
     overlay_count_ = _overlay_count;
+    coverOverlays();
   }
 
   template<uint8_t _layer_count>
@@ -112,13 +115,13 @@ class ColormapOverlay : public kaleidoscope::Plugin {
     // Update member variables
     overlays_      = new_overlays;
     overlay_count_ = count;
+    coverOverlays();
   }
   // A wildcard value for an overlay that applies on every layer.
   static constexpr int8_t layer_wildcard{-1};
   static constexpr int8_t no_color_overlay{-1};
 
   EventHandlerResult onSetup();
-  EventHandlerResult beforeSyncingLeds();
 
   ~ColormapOverlay() {
     if (overlays_ != nullptr) {
@@ -126,13 +129,16 @@ class ColormapOverlay : public kaleidoscope::Plugin {
     }
   }
 
+ protected:
+  bool overlayColorAt(KeyAddr key_addr, cRGB &color) final;
+
  private:
   Overlay *overlays_;
   uint8_t overlay_count_;
   cRGB selectedColor;
 
   bool hasOverlay(KeyAddr k);
-  void setLEDOverlayColors();
+  void coverOverlays();
 };
 
 // clang-format off
@@ -83,6 +83,8 @@ EventHandlerResult ColormapEffect::onLayerChange() {
   return EventHandlerResult::OK;
 }
 
+FOCUS_COMMANDS(ColormapEffect, "colormap.map")
+
 EventHandlerResult ColormapEffect::onFocusEvent(const char *input) {
   return ::LEDPaletteTheme.themeFocusEvent(input, PSTR("colormap.map"), map_base_, max_layers_);
 }
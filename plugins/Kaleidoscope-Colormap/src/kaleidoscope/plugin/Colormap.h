@@ -45,6 +45,7 @@ class ColormapEffect : public Plugin,
   EventHandlerResult onLayerChange();
   EventHandlerResult onNameQuery();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 
   static bool isUninitialized();
   static void updateColorIndexAtPosition(uint8_t layer, uint16_t position, uint8_t palette_index);
@@ -64,14 +64,13 @@ void DefaultColormap::install() {
   ::LEDControl.refreshAll();
 }
 
+FOCUS_COMMANDS(DefaultColormap, "colormap.install")
+
 EventHandlerResult DefaultColormap::onFocusEvent(const char *input) {
   if (!Runtime.has_leds)
     return EventHandlerResult::OK;
 
-  const char *cmd = PSTR("colormap.install");
-
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd);
+  const auto cmd = FOCUS_COMMAND("colormap.install");
 
   if (!::Focus.inputMatchesCommand(input, cmd))
     return EventHandlerResult::OK;
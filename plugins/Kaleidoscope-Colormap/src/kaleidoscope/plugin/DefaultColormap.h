@@ -76,6 +76,7 @@ class DefaultColormap : public Plugin {
   static void install();
 
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 };
 
 }  // namespace plugin
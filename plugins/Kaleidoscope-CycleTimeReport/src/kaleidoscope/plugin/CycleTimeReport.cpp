@@ -26,8 +26,10 @@
 #include <Kaleidoscope-FocusSerial.h>  // for Focus, FocusSerial
 #include <stdint.h>                    // for uint16_t, uint32_t
 
+#include "kaleidoscope/HookProfile.h"           // for HookProfile, HookStats
 #include "kaleidoscope/Runtime.h"               // for Runtime, Runtime_
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult, EventHandlerResult::OK
+#include "kaleidoscope/plugin/LEDControl.h"     // for LEDControl
 
 namespace kaleidoscope {
 namespace plugin {
@@ -56,6 +58,44 @@ EventHandlerResult CycleTimeReport::beforeEachCycle() {
   return EventHandlerResult::OK;
 }
 
+FOCUS_COMMANDS(CycleTimeReport, "profile.hooks", "profile.leds", "profile.reset")
+
+EventHandlerResult CycleTimeReport::onFocusEvent(const char *input) {
+  const auto cmd_hooks = FOCUS_COMMAND("profile.hooks");
+  const auto cmd_leds  = FOCUS_COMMAND("profile.leds");
+  const auto cmd_reset = FOCUS_COMMAND("profile.reset");
+
+  if (::Focus.inputMatchesCommand(input, cmd_hooks)) {
+    // One line per handler: plugin, hook, calls, and min, mean and max time in
+    // microseconds. There's nothing to send unless the sketch was built with
+    // `KALEIDOSCOPE_PROFILE_HOOKS` defined.
+    for (auto stats = profiling::HookProfile::first(); stats != nullptr; stats = stats->next) {
+      if (stats->calls == 0)
+        continue;
+      ::Focus.send(stats->plugin,
+                   stats->hook,
+                   stats->calls,
+                   stats->min_us,
+                   stats->total_us / stats->calls,
+                   stats->max_us,
+                   Focus.NEWLINE);
+    }
+  } else if (::Focus.inputMatchesCommand(input, cmd_leds)) {
+    // LED frames drawn in the last second, frames that overran the budget of
+    // their LED mode, and frames deferred by key events since the last reset.
+    ::Focus.send(LEDControl::framesPerSecond(),
+                 LEDControl::frameOverruns(),
+                 LEDControl::deferredFrames());
+  } else if (::Focus.inputMatchesCommand(input, cmd_reset)) {
+    profiling::HookProfile::reset();
+    LEDControl::resetFrameStats();
+  } else {
+    return EventHandlerResult::OK;
+  }
+
+  return EventHandlerResult::EVENT_CONSUMED;
+}
+
 __attribute__((weak)) void CycleTimeReport::report(uint16_t mean_cycle_time) {
   Focus.send(Focus.COMMENT,
              F("mean cycle time:"),
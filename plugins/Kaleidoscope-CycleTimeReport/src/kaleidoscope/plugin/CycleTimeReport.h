@@ -41,6 +41,8 @@ namespace plugin {
 class CycleTimeReport : public kaleidoscope::Plugin {
  public:
   EventHandlerResult beforeEachCycle();
+  EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 
 #ifndef NDEPRECATED
   DEPRECATED(CYCLETIMEREPORT_AVG_TIME)
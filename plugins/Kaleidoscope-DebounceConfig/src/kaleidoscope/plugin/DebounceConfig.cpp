@@ -0,0 +1,78 @@
+/* Kaleidoscope-DebounceConfig -- Debounce time configuration, with EEPROM persistence
+ * Copyright 2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kaleidoscope/plugin/DebounceConfig.h"
+
+#include <Arduino.h>                       // for PSTR, F
+#include <Kaleidoscope-EEPROM-Settings.h>  // for EEPROMSettings
+#include <Kaleidoscope-FocusSerial.h>      // for Focus, FocusSerial
+#include <stdint.h>                        // for uint8_t, uint16_t
+
+#include "kaleidoscope/Runtime.h"               // for Runtime, Runtime_
+#include "kaleidoscope/device/device.h"         // for VirtualProps::Storage, Base<>::Storage
+#include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult, EventHandlerResult::OK
+
+namespace kaleidoscope {
+namespace plugin {
+
+uint16_t DebounceConfig::settings_base_;
+struct DebounceConfig::settings DebounceConfig::settings_;
+
+EventHandlerResult DebounceConfig::onSetup() {
+  // Until one is set, the key scanner keeps the debounce time of the board.
+  if (!::EEPROMSettings.requestSliceAndLoadData(&settings_base_, &settings_)) {
+    settings_.debounce_ms = Runtime.device().debounceTime();
+  }
+  Runtime.device().setDebounceTime(settings_.debounce_ms);
+
+  return EventHandlerResult::OK;
+}
+
+FOCUS_COMMANDS(DebounceConfig, "keyscanner.debounce")
+
+EventHandlerResult DebounceConfig::onFocusEvent(const char *command) {
+  const auto cmd = FOCUS_COMMAND("keyscanner.debounce");
+
+  if (!::Focus.inputMatchesCommand(command, cmd)) return EventHandlerResult::OK;
+
+  if (::Focus.isEOL()) {
+    ::Focus.send(Runtime.device().debounceTime());
+  } else {
+    ::Focus.read(settings_.debounce_ms);
+    Runtime.device().setDebounceTime(settings_.debounce_ms);
+    // The key scanner may not be able to debounce for that long.
+    settings_.debounce_ms = Runtime.device().debounceTime();
+    Runtime.storage().put(settings_base_, settings_);
+    Runtime.storage().commit();
+  }
+
+  return EventHandlerResult::EVENT_CONSUMED;
+}
+
+EventHandlerResult DebounceConfig::onNameQuery() {
+  return ::Focus.sendName(F("DebounceConfig"));
+}
+
+}  // namespace plugin
+}  // namespace kaleidoscope
+
+kaleidoscope::plugin::DebounceConfig DebounceConfig;
@@ -46,11 +46,10 @@ EventHandlerResult DefaultLEDModeConfig::onSetup() {
   return EventHandlerResult::OK;
 }
 
-EventHandlerResult DefaultLEDModeConfig::onFocusEvent(const char *input) {
-  const char *cmd = PSTR("led_mode.default");
+FOCUS_COMMANDS(DefaultLEDModeConfig, "led_mode.default")
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd);
+EventHandlerResult DefaultLEDModeConfig::onFocusEvent(const char *input) {
+  const auto cmd = FOCUS_COMMAND("led_mode.default");
 
   if (!::Focus.inputMatchesCommand(input, cmd))
     return EventHandlerResult::OK;
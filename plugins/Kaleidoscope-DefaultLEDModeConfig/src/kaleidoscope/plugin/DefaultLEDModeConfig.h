@@ -36,6 +36,7 @@ class DefaultLEDModeConfig : public kaleidoscope::Plugin {
   EventHandlerResult onSetup();
   EventHandlerResult onNameQuery();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 
   void activateLEDModeIfUnconfigured(LEDModeInterface *plugin);
 
@@ -45,9 +45,13 @@ class DynamicMacros : public kaleidoscope::Plugin {
   EventHandlerResult onNameQuery();
   EventHandlerResult onKeyEvent(KeyEvent &event);
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
   EventHandlerResult beforeReportingState(const KeyEvent &event) {
     return ::MacroSupport.beforeReportingState(event);
   }
+  EventHandlerResult afterEachCycle() {
+    return ::MacroSupport.afterEachCycle();
+  }
 
   void reserve_storage(uint16_t size);
 
@@ -61,10 +65,13 @@ class DynamicMacros : public kaleidoscope::Plugin {
   uint8_t macro_count_;
   uint8_t updateDynamicMacroCache();
 
-  inline void press(Key key) { ::MacroSupport.press(key); }
-  inline void release(Key key) { ::MacroSupport.release(key); }
-  inline void tap(Key key) const { ::MacroSupport.tap(key); }
-  inline void clear() { ::MacroSupport.clear(); }
+  // Where the next byte of a `macros.map` upload goes.
+  static uint16_t upload_pos_;
+  static void uploadValue(uint16_t value);
+  static void uploadFrame(const uint8_t *data, uint8_t size);
+  static void uploadEnd();
+  static void uploadAbort();
+
 };
 
 }  // namespace plugin
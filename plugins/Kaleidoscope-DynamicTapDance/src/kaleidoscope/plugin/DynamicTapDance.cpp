@@ -93,11 +93,25 @@ EventHandlerResult DynamicTapDance::onNameQuery() {
   return ::Focus.sendName(F("DynamicTapDance"));
 }
 
-EventHandlerResult DynamicTapDance::onFocusEvent(const char *input) {
-  const char *cmd_map = PSTR("tapdance.map");
+uint16_t DynamicTapDance::upload_pos_;
+
+void DynamicTapDance::uploadValue(uint16_t value) {
+  if (upload_pos_ + sizeof(Key) > ::DynamicTapDance.storage_size_)
+    return;
+
+  Runtime.storage().put(::DynamicTapDance.storage_base_ + upload_pos_, Key(value));
+  upload_pos_ += sizeof(Key);
+}
+
+void DynamicTapDance::uploadEnd() {
+  Runtime.storage().commit();
+  ::DynamicTapDance.updateDynamicTapDanceCache();
+}
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_map);
+FOCUS_COMMANDS(DynamicTapDance, "tapdance.map")
+
+EventHandlerResult DynamicTapDance::onFocusEvent(const char *input) {
+  const auto cmd_map = FOCUS_COMMAND("tapdance.map");
 
   if (!::Focus.inputMatchesCommand(input, cmd_map))
     return EventHandlerResult::OK;
@@ -109,17 +123,8 @@ EventHandlerResult DynamicTapDance::onFocusEvent(const char *input) {
       ::Focus.send(k);
     }
   } else {
-    uint16_t pos = 0;
-
-    while (!::Focus.isEOL()) {
-      Key k;
-      ::Focus.read(k);
-
-      Runtime.storage().put(storage_base_ + pos, k);
-      pos += 2;
-    }
-    Runtime.storage().commit();
-    updateDynamicTapDanceCache();
+    upload_pos_ = 0;
+    ::Focus.streamArguments(uploadValue, nullptr, uploadEnd);
   }
 
   return EventHandlerResult::EVENT_CONSUMED;
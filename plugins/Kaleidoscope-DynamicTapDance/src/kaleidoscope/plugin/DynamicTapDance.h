@@ -32,6 +32,7 @@ class DynamicTapDance : public kaleidoscope::Plugin {
  public:
   EventHandlerResult onNameQuery();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 
   void setup(uint8_t dynamic_offset, uint16_t size);
 
@@ -45,6 +46,11 @@ class DynamicTapDance : public kaleidoscope::Plugin {
   uint8_t dance_count_;
   uint8_t offset_;
   void updateDynamicTapDanceCache();
+
+  // Where the next key of a `tapdance.map` upload goes.
+  static uint16_t upload_pos_;
+  static void uploadValue(uint16_t value);
+  static void uploadEnd();
 };
 
 }  // namespace plugin
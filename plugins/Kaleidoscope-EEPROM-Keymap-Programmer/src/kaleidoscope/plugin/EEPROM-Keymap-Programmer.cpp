@@ -54,6 +54,7 @@ void EEPROMKeymapProgrammer::nextState() {
   case WAIT_FOR_SOURCE_KEY:
     ::EEPROMKeymap.updateKey(update_position_, new_key_);
     Runtime.storage().commit();
+    Layer.updateLayerMasks();
     cancel();
     break;
   }
@@ -111,11 +112,10 @@ EventHandlerResult EEPROMKeymapProgrammer::onKeyEvent(KeyEvent &event) {
   return EventHandlerResult::EVENT_CONSUMED;
 }
 
-EventHandlerResult EEPROMKeymapProgrammer::onFocusEvent(const char *input) {
-  const char *cmd = PSTR("keymap.toggleProgrammer");
+FOCUS_COMMANDS(EEPROMKeymapProgrammer, "keymap.toggleProgrammer")
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd);
+EventHandlerResult EEPROMKeymapProgrammer::onFocusEvent(const char *input) {
+  const auto cmd = FOCUS_COMMAND("keymap.toggleProgrammer");
 
   if (!::Focus.inputMatchesCommand(input, cmd))
     return EventHandlerResult::OK;
@@ -47,6 +47,7 @@ class EEPROMKeymapProgrammer : public kaleidoscope::Plugin {
 
   EventHandlerResult onKeyEvent(KeyEvent &event);
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 
  private:
   typedef enum {
@@ -26,13 +26,17 @@
 #include <Kaleidoscope-EEPROM-Settings.h>  // for EEPROMSettings
 #include <Kaleidoscope-FocusSerial.h>      // for Focus, FocusSerial
 #include <stdint.h>                        // for uint8_t, uint16_t
+#include <string.h>                        // for memcpy
 
 #include "kaleidoscope/KeyAddr.h"               // for KeyAddr, MatrixAddr, MatrixAddr<>::Range
+#include "kaleidoscope/KeyAddrBitfield.h"       // for KeyAddrBitfield
 #include "kaleidoscope/Runtime.h"               // for Runtime, Runtime_
+#include "kaleidoscope/SparseKeymap.h"          // for fillKey, countKeys, popcountBelow
 #include "kaleidoscope/device/device.h"         // for VirtualProps::Storage, Device, Base<>::St...
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult, EventHandlerResult::OK
 #include "kaleidoscope/key_defs.h"              // for Key, Key_NoKey
 #include "kaleidoscope/layers.h"                // for Layer_, Layer, layer_count
+#include "kaleidoscope_internal/device.h"       // for device
 
 namespace kaleidoscope {
 namespace plugin {
@@ -40,11 +44,39 @@ uint16_t EEPROMKeymap::keymap_base_;
 uint8_t EEPROMKeymap::max_layers_;
 uint8_t EEPROMKeymap::progmem_layers_;
 
+uint16_t EEPROMKeymap::sparse_size_;
+uint8_t EEPROMKeymap::write_layer_;
+uint16_t EEPROMKeymap::write_pos_;
+uint16_t EEPROMKeymap::parked_pos_;
+uint16_t EEPROMKeymap::park_distance_;
+uint8_t EEPROMKeymap::unwritten_layers_;
+bool EEPROMKeymap::writing_layers_;
+
+Key EEPROMKeymap::upload_keys_[kaleidoscope_internal::device.numKeys()];
+uint8_t EEPROMKeymap::upload_index_;
+bool EEPROMKeymap::has_upload_byte_;
+uint8_t EEPROMKeymap::upload_byte_;
+EEPROMKeymap::SparseField EEPROMKeymap::sparse_field_;
+uint8_t EEPROMKeymap::sparse_left_;
+
+#if EEPROM_KEYMAP_CACHED_LAYERS
+Key EEPROMKeymap::cache_[EEPROM_KEYMAP_CACHED_LAYERS][kaleidoscope_internal::device.numKeys()];
+uint8_t EEPROMKeymap::cached_layers_[EEPROM_KEYMAP_CACHED_LAYERS];
+uint8_t EEPROMKeymap::cache_lru_[EEPROM_KEYMAP_CACHED_LAYERS];
+uint16_t EEPROMKeymap::cache_crc_;
+#endif
+
 EventHandlerResult EEPROMKeymap::onSetup() {
   progmem_layers_ = layer_count;
   return EventHandlerResult::OK;
 }
 
+EventHandlerResult EEPROMKeymap::onStorageChange() {
+  flushCache();
+  Layer.updateLayerMasks();
+  return EventHandlerResult::OK;
+}
+
 EventHandlerResult EEPROMKeymap::onNameQuery() {
   return ::Focus.sendName(F("EEPROMKeymap"));
 }
@@ -60,19 +92,350 @@ void EEPROMKeymap::setup(uint8_t max) {
   max_layers(max);
 }
 
+void EEPROMKeymap::setupSparse(uint8_t max, uint16_t size) {
+  // Make sure there's room for every layer, even if they're all empty.
+  if (size < max * (SPARSE_HEADER_SIZE + 2))
+    size = max * (SPARSE_HEADER_SIZE + 2);
+  sparse_size_ = size;
+  setup(max);
+}
+
 void EEPROMKeymap::max_layers(uint8_t max) {
-  max_layers_  = max;
-  keymap_base_ = ::EEPROMSettings.requestSlice(max_layers_ * Runtime.device().numKeys() * 2);
+  max_layers_ = max;
+
+  if (!sparse_size_) {
+    keymap_base_ = ::EEPROMSettings.requestSlice(max_layers_ * Runtime.device().numKeys() * 2);
+    flushCache();
+    return;
+  }
+
+  keymap_base_ = ::EEPROMSettings.requestSlice(sparse_size_);
+  flushCache();
+
+  // If the slice has never been written, or doesn't hold `max_layers_` sparse
+  // layers (because it was used for something else before), start over with
+  // empty layers: a `Key_Transparent` fill key, and no other keys.
+  if (Runtime.storage().isSliceUninitialized(keymap_base_, sparse_size_) ||
+      !sparseLayersValid()) {
+    uint16_t offset = max_layers_ * 2;
+    for (uint8_t layer = 0; layer < max_layers_; layer++) {
+      Runtime.storage().put(keymap_base_ + layer * 2, offset);
+      updateStorageKey(keymap_base_ + offset, Key_Transparent);
+      Runtime.storage().fill(keymap_base_ + offset + 2, 0, KeyAddrBitfield::total_blocks);
+      offset += SPARSE_HEADER_SIZE;
+    }
+    Runtime.storage().commit();
+  }
+}
+
+// Keys are stored flags first, so they can't be copied to and from `Key`
+// objects directly.
+Key EEPROMKeymap::readStorageKey(uint16_t pos) {
+  uint8_t bytes[2];
+  Runtime.storage().readBlock(pos, bytes, sizeof(bytes));
+  return Key(bytes[1], bytes[0]);
+}
+
+void EEPROMKeymap::updateStorageKey(uint16_t pos, Key key) {
+  uint8_t bytes[2] = {key.getFlags(), key.getKeyCode()};
+  Runtime.storage().writeBlock(pos, bytes, sizeof(bytes));
 }
 
 Key EEPROMKeymap::getKey(uint8_t layer, KeyAddr key_addr) {
   if (layer >= max_layers_)
     return Key_NoKey;
 
-  uint16_t pos = ((layer * Runtime.device().numKeys()) + key_addr.toInt()) * 2;
+#if EEPROM_KEYMAP_CACHED_LAYERS
+  Key *cached = cachedLayer(layer);
+  if (cached)
+    return cached[key_addr.toInt()];
+#endif
+
+  if (sparse_size_)
+    return readStorageKey(sparseKeyPos(sparseLayerPos(layer), key_addr));
+
+  uint16_t base_pos = (layer * Runtime.device().numKeys()) + key_addr.toInt();
+  return readStorageKey(keymap_base_ + base_pos * 2);
+}
+
+void EEPROMKeymap::readLayer(uint8_t layer, Key *keys) {
+  if (sparse_size_) {
+    readSparseLayer(sparseLayerPos(layer), keys);
+    return;
+  }
+
+  // Read the layer a few keys at a time
+  uint16_t pos = keymap_base_ + layer * Runtime.device().numKeys() * 2;
+  uint8_t bytes[16];
+  for (uint8_t i = 0; i < Runtime.device().numKeys(); i += sizeof(bytes) / 2) {
+    uint8_t count = Runtime.device().numKeys() - i;
+    if (count > sizeof(bytes) / 2)
+      count = sizeof(bytes) / 2;
+
+    Runtime.storage().readBlock(pos + i * 2, bytes, count * 2);
+    for (uint8_t k = 0; k < count; k++)
+      keys[i + k] = Key(bytes[k * 2 + 1], bytes[k * 2]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Sparse layers
+//
+// In sparse mode, the layers are stored back to back, each as its fill key, the
+// `KeyAddrBitfield` of the keys that differ from it, and those keys (see
+// `kaleidoscope/SparseKeymap.h`). The size of a layer depends on its contents,
+// so they are preceded by an index, at `keymap_base_`, of their offsets from
+// there. Changing the size of a layer means moving the ones after it.
+
+uint16_t EEPROMKeymap::sparseLayerEnd(uint16_t pos) {
+  uint8_t blocks[KeyAddrBitfield::total_blocks];
+  Runtime.storage().readBlock(pos + 2, blocks, sizeof(blocks));
+
+  uint16_t end = pos + SPARSE_HEADER_SIZE;
+  for (uint8_t b = 0; b < KeyAddrBitfield::total_blocks; b++)
+    end += __builtin_popcount(blocks[b]) * 2;
+  return end;
+}
+
+uint16_t EEPROMKeymap::sparseLayerPos(uint8_t layer) {
+  uint16_t offset;
+  Runtime.storage().get(keymap_base_ + layer * 2, offset);
+
+  // While layers are being rewritten, the ones that weren't yet are parked at
+  // the end of the slice, and their offsets not updated until they're moved
+  // back. Keys may be looked up in the meantime, as uploads take more than one
+  // cycle.
+  if (writing_layers_ && layer >= write_layer_)
+    offset += park_distance_;
+  return keymap_base_ + offset;
+}
+
+bool EEPROMKeymap::sparseLayersValid() {
+  uint16_t pos = keymap_base_ + max_layers_ * 2;
+  for (uint8_t layer = 0; layer < max_layers_; layer++) {
+    if (sparseLayerPos(layer) != pos)
+      return false;
+    pos = sparseLayerEnd(pos);
+  }
+  return pos <= keymap_base_ + sparse_size_;
+}
+
+uint16_t EEPROMKeymap::sparseKeyPos(uint16_t pos, KeyAddr key_addr) {
+  uint8_t block_index = KeyAddrBitfield::blockIndex(key_addr);
+  uint8_t bit_index   = KeyAddrBitfield::bitIndex(key_addr);
+  uint8_t blocks[KeyAddrBitfield::total_blocks];
+  Runtime.storage().readBlock(pos + 2, blocks, block_index + 1);
+
+  // A key that isn't stored on its own is the fill key.
+  if (!bitRead(blocks[block_index], bit_index))
+    return pos;
+
+  uint8_t index = sparse_keymap::popcountBelow(blocks[block_index], bit_index);
+  for (uint8_t b = 0; b < block_index; b++)
+    index += __builtin_popcount(blocks[b]);
+
+  return pos + SPARSE_HEADER_SIZE + index * 2;
+}
+
+void EEPROMKeymap::readSparseLayer(uint16_t pos, Key *keys) {
+  Key fill         = readStorageKey(pos);
+  uint16_t key_pos = pos + SPARSE_HEADER_SIZE;
+  uint8_t blocks[KeyAddrBitfield::total_blocks];
+  Runtime.storage().readBlock(pos + 2, blocks, sizeof(blocks));
+
+  for (auto key_addr : KeyAddr::all()) {
+    if (bitRead(blocks[KeyAddrBitfield::blockIndex(key_addr)], KeyAddrBitfield::bitIndex(key_addr))) {
+      keys[key_addr.toInt()] = readStorageKey(key_pos);
+      key_pos += 2;
+    } else {
+      keys[key_addr.toInt()] = fill;
+    }
+  }
+}
+
+uint16_t EEPROMKeymap::writeSparseLayer(uint16_t pos, const Key *keys) {
+  Key fill         = sparse_keymap::fillKey(keys, Runtime.device().numKeys());
+  uint16_t key_pos = pos + SPARSE_HEADER_SIZE;
+  uint8_t block    = 0;
+
+  updateStorageKey(pos, fill);
+  for (auto key_addr : KeyAddr::all()) {
+    uint8_t bit_index = KeyAddrBitfield::bitIndex(key_addr);
+
+    if (keys[key_addr.toInt()] != fill) {
+      bitSet(block, bit_index);
+      updateStorageKey(key_pos, keys[key_addr.toInt()]);
+      key_pos += 2;
+    }
+
+    if (bit_index == KeyAddrBitfield::block_size - 1 ||
+        key_addr.toInt() == Runtime.device().numKeys() - 1) {
+      Runtime.storage().update(pos + 2 + KeyAddrBitfield::blockIndex(key_addr), block);
+      block = 0;
+    }
+  }
+
+  return key_pos;
+}
+
+void EEPROMKeymap::moveStorage(uint16_t to, uint16_t from, uint16_t length) {
+  // Move a block at a time, starting from the end the data moves towards, so
+  // that overlapping ranges are handled like `memmove()` would.
+  uint8_t buffer[16];
+
+  if (to < from) {
+    for (uint16_t i = 0; i < length; i += sizeof(buffer)) {
+      uint8_t size = (length - i < sizeof(buffer)) ? length - i : sizeof(buffer);
+      Runtime.storage().readBlock(from + i, buffer, size);
+      Runtime.storage().writeBlock(to + i, buffer, size);
+    }
+  } else if (to > from) {
+    uint16_t i = length;
+    while (i > 0) {
+      uint8_t size = (i < sizeof(buffer)) ? i : sizeof(buffer);
+      i -= size;
+      Runtime.storage().readBlock(from + i, buffer, size);
+      Runtime.storage().writeBlock(to + i, buffer, size);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Rewriting layers
+//
+// To rewrite sparse layers in place, we first move ("park") every layer from
+// the first one to be written to the end of the slice. Each layer is then
+// written right after the previous one, and the parked ones that weren't
+// rewritten are moved back down at the end. Because a layer is only written
+// if it doesn't reach into the parked layers that come after it, a keymap that
+// doesn't fit in the slice loses updates, not layers.
+
+void EEPROMKeymap::beginLayerWrites(uint8_t layer) {
+  write_layer_      = layer;
+  unwritten_layers_ = 0;
+  if (!sparse_size_)
+    return;
+
+  write_pos_   = sparseLayerPos(layer);
+  uint16_t end = sparseLayerEnd(sparseLayerPos(max_layers_ - 1));
 
-  return Key(Runtime.storage().read(keymap_base_ + pos + 1),  // key_code
-             Runtime.storage().read(keymap_base_ + pos));     // flags
+  park_distance_ = keymap_base_ + sparse_size_ - end;
+  parked_pos_    = write_pos_ + park_distance_;
+  moveStorage(parked_pos_, write_pos_, end - write_pos_);
+  writing_layers_ = true;
+}
+
+void EEPROMKeymap::nextLayer(Key *keys) {
+  if (sparse_size_) {
+    readSparseLayer(parked_pos_, keys);
+  } else {
+    readLayer(write_layer_, keys);
+  }
+}
+
+bool EEPROMKeymap::writeLayer(const Key *keys) {
+  bool written = true;
+
+  if (sparse_size_) {
+    uint16_t parked_end = sparseLayerEnd(parked_pos_);
+    uint16_t key_count  = sparse_keymap::countKeys(keys, Runtime.device().numKeys());
+    uint16_t size       = SPARSE_HEADER_SIZE + key_count * 2;
+
+    Runtime.storage().put(keymap_base_ + write_layer_ * 2, (uint16_t)(write_pos_ - keymap_base_));
+    if (write_pos_ + size <= parked_end) {
+      write_pos_ = writeSparseLayer(write_pos_, keys);
+    } else {
+      // Out of space: keep the layer as it was.
+      moveStorage(write_pos_, parked_pos_, parked_end - parked_pos_);
+      write_pos_ += parked_end - parked_pos_;
+      written = false;
+      unwritten_layers_++;
+    }
+    parked_pos_ = parked_end;
+  } else {
+    uint16_t pos = keymap_base_ + write_layer_ * Runtime.device().numKeys() * 2;
+    for (auto key_addr : KeyAddr::all())
+      updateStorageKey(pos + key_addr.toInt() * 2, keys[key_addr.toInt()]);
+  }
+  if (written)
+    updateCache(write_layer_, 0, keys, Runtime.device().numKeys());
+
+  write_layer_++;
+  return written;
+}
+
+void EEPROMKeymap::endLayerWrites() {
+  if (sparse_size_) {
+    // Move the layers that weren't rewritten back down, right after the last
+    // one that was, and update their offsets.
+    uint16_t distance = parked_pos_ - write_pos_;
+    moveStorage(write_pos_, parked_pos_, keymap_base_ + sparse_size_ - parked_pos_);
+
+    for (uint8_t layer = write_layer_; layer < max_layers_; layer++) {
+      uint16_t offset;
+      Runtime.storage().get(keymap_base_ + layer * 2, offset);
+      Runtime.storage().put(keymap_base_ + layer * 2, (uint16_t)(offset + park_distance_ - distance));
+    }
+    writing_layers_ = false;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Layer cache
+
+#if EEPROM_KEYMAP_CACHED_LAYERS
+Key *EEPROMKeymap::cachedLayer(uint8_t layer) {
+  // We only cache anything once EEPROMSettings has sealed the storage layout,
+  // and found it to match the one in storage. Should the CRC ever change, the
+  // layout did too, and nothing we have cached can be trusted.
+  uint16_t crc = ::EEPROMSettings.crc();
+  if (crc != cache_crc_) {
+    flushCache();
+    cache_crc_ = crc;
+  }
+  if (cache_crc_ == 0 || !::EEPROMSettings.isValid())
+    return nullptr;
+
+  // Look for the layer from the most recently used slot onwards. If it isn't
+  // cached, we end up at the least recently used slot, which we evict.
+  uint8_t i = 0;
+  while (i < EEPROM_KEYMAP_CACHED_LAYERS - 1 && cached_layers_[cache_lru_[i]] != layer)
+    i++;
+
+  uint8_t slot = cache_lru_[i];
+  for (; i > 0; i--)
+    cache_lru_[i] = cache_lru_[i - 1];
+  cache_lru_[0] = slot;
+
+  if (cached_layers_[slot] != layer) {
+    readLayer(layer, cache_[slot]);
+    cached_layers_[slot] = layer;
+  }
+
+  return cache_[slot];
+}
+#endif
+
+void EEPROMKeymap::updateCache(uint8_t layer, uint8_t index, const Key *keys, uint8_t count) {
+#if EEPROM_KEYMAP_CACHED_LAYERS
+  // The slots are only initialized once the cache is first used.
+  if (cache_crc_ == 0)
+    return;
+
+  for (uint8_t slot = 0; slot < EEPROM_KEYMAP_CACHED_LAYERS; slot++) {
+    if (cached_layers_[slot] == layer)
+      memcpy(cache_[slot] + index, keys, count * sizeof(Key));
+  }
+#endif
+}
+
+void EEPROMKeymap::flushCache() {
+#if EEPROM_KEYMAP_CACHED_LAYERS
+  for (uint8_t slot = 0; slot < EEPROM_KEYMAP_CACHED_LAYERS; slot++) {
+    cached_layers_[slot] = UNCACHED_LAYER;
+    cache_lru_[slot]     = slot;
+  }
+#endif
 }
 
 Key EEPROMKeymap::getKeyExtended(uint8_t layer, KeyAddr key_addr) {
@@ -91,8 +454,33 @@ uint16_t EEPROMKeymap::keymap_base() {
 }
 
 void EEPROMKeymap::updateKey(uint16_t base_pos, Key key) {
-  Runtime.storage().update(keymap_base_ + base_pos * 2, key.getFlags());
-  Runtime.storage().update(keymap_base_ + base_pos * 2 + 1, key.getKeyCode());
+  uint8_t layer = base_pos / Runtime.device().numKeys();
+  uint8_t index = base_pos % Runtime.device().numKeys();
+
+  if (sparse_size_) {
+    if (layer >= max_layers_)
+      return;
+
+    // A key stored on its own is updated in place. Otherwise, the layer
+    // changes size, unless the key is its fill key, and has to be rewritten.
+    uint16_t pos     = sparseLayerPos(layer);
+    uint16_t key_pos = sparseKeyPos(pos, KeyAddr(index));
+    if (key_pos != pos) {
+      updateStorageKey(key_pos, key);
+    } else if (key != readStorageKey(key_pos)) {
+      Key keys[kaleidoscope_internal::device.numKeys()];
+
+      beginLayerWrites(layer);
+      nextLayer(keys);
+      keys[index] = key;
+      writeLayer(keys);
+      endLayerWrites();
+      return;
+    }
+  } else {
+    updateStorageKey(keymap_base_ + base_pos * 2, key);
+  }
+  updateCache(layer, index, &key, 1);
 }
 
 void EEPROMKeymap::dumpKeymap(uint8_t layers, Key (*getkey)(uint8_t, KeyAddr)) {
@@ -105,13 +493,121 @@ void EEPROMKeymap::dumpKeymap(uint8_t layers, Key (*getkey)(uint8_t, KeyAddr)) {
   }
 }
 
-EventHandlerResult EEPROMKeymap::onFocusEvent(const char *input) {
-  const char *cmd_custom     = PSTR("keymap.custom");
-  const char *cmd_default    = PSTR("keymap.default");
-  const char *cmd_onlyCustom = PSTR("keymap.onlyCustom");
+void EEPROMKeymap::dumpSparseKeymap() {
+  Key keys[kaleidoscope_internal::device.numKeys()];
+
+  for (uint8_t layer = 0; layer < max_layers_; layer++) {
+    readLayer(layer, keys);
+
+    Key fill = sparse_keymap::fillKey(keys, Runtime.device().numKeys());
+    ::Focus.send(fill, (uint8_t)sparse_keymap::countKeys(keys, Runtime.device().numKeys()));
+    for (auto key_addr : KeyAddr::all()) {
+      if (keys[key_addr.toInt()] != fill)
+        ::Focus.send(key_addr.toInt(), keys[key_addr.toInt()]);
+    }
+  }
+}
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_custom, cmd_default, cmd_onlyCustom);
+void EEPROMKeymap::uploadKey(Key key) {
+  if (write_layer_ >= max_layers_)
+    return;
+
+  upload_keys_[upload_index_++] = key;
+  if (upload_index_ == Runtime.device().numKeys()) {
+    writeLayer(upload_keys_);
+    upload_index_ = 0;
+    if (write_layer_ < max_layers_)
+      nextLayer(upload_keys_);
+  }
+}
+
+void EEPROMKeymap::uploadValue(uint16_t value) {
+  uploadKey(Key(value));
+}
+
+void EEPROMKeymap::uploadFrame(const uint8_t *data, uint8_t size) {
+  // Keys are sent as their raw value, least significant byte first, and may
+  // straddle frames.
+  for (uint8_t i = 0; i < size; i++) {
+    if (!has_upload_byte_) {
+      upload_byte_     = data[i];
+      has_upload_byte_ = true;
+    } else {
+      uploadKey(Key(upload_byte_ | (data[i] << 8)));
+      has_upload_byte_ = false;
+    }
+  }
+}
+
+void EEPROMKeymap::uploadEnd() {
+  // A partial layer keeps the rest of its keys.
+  if (upload_index_ > 0)
+    writeLayer(upload_keys_);
+  if (unwritten_layers_)
+    ::Focus.sendRaw(F("error: no room for "), unwritten_layers_, F(" layers"), ::Focus.NEWLINE);
+  endLayerWrites();
+  Runtime.storage().commit();
+  Layer.updateLayerMasks();
+}
+
+void EEPROMKeymap::uploadAbort() {
+  // Nothing more is stored or committed, but the layers that were moved out of
+  // the way still have to be put back.
+  endLayerWrites();
+  Layer.updateLayerMasks();
+}
+
+void EEPROMKeymap::uploadSparseValue(uint16_t value) {
+  if (write_layer_ >= max_layers_)
+    return;
+
+  switch (sparse_field_) {
+  case SparseField::Fill:
+    for (auto key_addr : KeyAddr::all())
+      upload_keys_[key_addr.toInt()] = Key(value);
+    sparse_field_ = SparseField::Count;
+    return;
+  case SparseField::Count:
+    sparse_left_  = value;
+    sparse_field_ = SparseField::Index;
+    break;
+  case SparseField::Index:
+    upload_index_ = value;
+    sparse_field_ = SparseField::Key;
+    return;
+  case SparseField::Key:
+    if (upload_index_ < Runtime.device().numKeys())
+      upload_keys_[upload_index_] = Key(value);
+    sparse_left_--;
+    sparse_field_ = SparseField::Index;
+    break;
+  }
+
+  if (sparse_left_ == 0) {
+    writeLayer(upload_keys_);
+    sparse_field_ = SparseField::Fill;
+  }
+}
+
+void EEPROMKeymap::uploadSparseEnd() {
+  // A partial layer is written as far as it was sent.
+  if (sparse_field_ != SparseField::Fill && write_layer_ < max_layers_)
+    writeLayer(upload_keys_);
+  upload_index_ = 0;
+  uploadEnd();
+}
+
+FOCUS_COMMANDS(EEPROMKeymap,
+               "keymap.custom",
+               "keymap.default",
+               "keymap.onlyCustom",
+               "keymap.sparse")
+
+EventHandlerResult EEPROMKeymap::onFocusEvent(const char *input) {
+  const auto cmd_custom     = FOCUS_COMMAND("keymap.custom");
+  const auto cmd_default    = FOCUS_COMMAND("keymap.default");
+  const auto cmd_onlyCustom = FOCUS_COMMAND("keymap.onlyCustom");
+  const auto cmd_sparse     = FOCUS_COMMAND("keymap.sparse");
 
   if (::Focus.inputMatchesCommand(input, cmd_onlyCustom)) {
     if (::Focus.isEOL()) {
@@ -143,26 +639,37 @@ EventHandlerResult EEPROMKeymap::onFocusEvent(const char *input) {
     return EventHandlerResult::EVENT_CONSUMED;
   }
 
+  if (::Focus.inputMatchesCommand(input, cmd_sparse)) {
+    if (::Focus.isEOL()) {
+      dumpSparseKeymap();
+      return EventHandlerResult::EVENT_CONSUMED;
+    }
+
+    beginLayerWrites(0);
+    sparse_field_ = SparseField::Fill;
+    ::Focus.streamArguments(uploadSparseValue, nullptr, uploadSparseEnd);
+    return EventHandlerResult::EVENT_CONSUMED;
+  }
+
   if (!::Focus.inputMatchesCommand(input, cmd_custom))
     return EventHandlerResult::OK;
 
   if (::Focus.isEOL()) {
-    // By using a cast to the appropriate function type,
-    // tell the compiler which overload of getKey
-    // we actually want.
-    //
-    dumpKeymap(max_layers_, static_cast<Key (*)(uint8_t, KeyAddr)>(getKey));
-  } else {
-    uint16_t i = 0;
-
-    while (!::Focus.isEOL() && (i < (uint16_t)Runtime.device().numKeys() * max_layers_)) {
-      Key k;
+    Key keys[kaleidoscope_internal::device.numKeys()];
 
-      ::Focus.read(k);
-      updateKey(i, k);
-      i++;
+    for (uint8_t layer = 0; layer < max_layers_; layer++) {
+      readLayer(layer, keys);
+      for (auto key_addr : KeyAddr::all())
+        ::Focus.send(keys[key_addr.toInt()]);
     }
-    Runtime.storage().commit();
+  } else {
+    // Layers are rewritten whole, so start from their current contents, in
+    // case the input ends halfway through one.
+    beginLayerWrites(0);
+    nextLayer(upload_keys_);
+    upload_index_    = 0;
+    has_upload_byte_ = false;
+    ::Focus.streamArguments(uploadValue, uploadFrame, uploadEnd, uploadAbort);
   }
 
   return EventHandlerResult::EVENT_CONSUMED;
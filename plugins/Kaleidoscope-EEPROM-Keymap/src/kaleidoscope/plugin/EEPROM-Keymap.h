@@ -24,11 +24,38 @@
 
 #include <stdint.h>  // for uint8_t, uint16_t
 
+#ifdef __AVR__
+#include <avr/io.h>  // for RAMEND, RAMSTART
+#endif
+
 #include "kaleidoscope/KeyAddr.h"               // for KeyAddr
+#include "kaleidoscope/KeyAddrBitfield.h"       // for KeyAddrBitfield
+#include "kaleidoscope/device/device.h"         // for Device
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
 #include "kaleidoscope/key_defs.h"              // for Key
 #include "kaleidoscope/plugin.h"                // for Plugin
 
+// The number of custom layers EEPROMKeymap keeps decoded in RAM, so that
+// looking a key up on them costs no more than a PROGMEM lookup, instead of two
+// reads from storage (which, on flash-emulated EEPROM, are not cheap). Each one
+// takes two bytes per key of RAM. When there are more custom layers than this,
+// the least recently used one is evicted to make room. Set it to 0 to disable
+// the cache entirely. On AVR, the default is one layer per 2KiB of SRAM, but
+// only if that makes for at least two: with a single slot, looking keys up on
+// two custom layers in turn would reload a whole layer for every lookup. The
+// ATmega32U4 has no cache by default.
+#ifndef EEPROM_KEYMAP_CACHED_LAYERS
+#if defined(__AVR__)
+#if (RAMEND - RAMSTART + 1) / 2048 >= 2
+#define EEPROM_KEYMAP_CACHED_LAYERS ((RAMEND - RAMSTART + 1) / 2048)
+#else
+#define EEPROM_KEYMAP_CACHED_LAYERS 0
+#endif
+#else
+#define EEPROM_KEYMAP_CACHED_LAYERS 8
+#endif
+#endif
+
 namespace kaleidoscope {
 namespace plugin {
 class EEPROMKeymap : public kaleidoscope::Plugin {
@@ -39,11 +66,21 @@ class EEPROMKeymap : public kaleidoscope::Plugin {
   };
 
   EventHandlerResult onSetup();
+  EventHandlerResult onStorageChange();
   EventHandlerResult onNameQuery();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 
   static void setup(uint8_t max);
 
+  // Like `setup()`, but stores the layers in the sparse encoding (see
+  // `kaleidoscope/SparseKeymap.h`), in a slice of `size` bytes. Each layer takes
+  // `SPARSE_HEADER_SIZE` bytes, two for its offset, and two for every key that
+  // isn't its fill key.
+  static void setupSparse(uint8_t max, uint16_t size);
+
+  static constexpr uint8_t SPARSE_HEADER_SIZE = 2 + KeyAddrBitfield::total_blocks;
+
   static void max_layers(uint8_t max);
 
   static uint16_t keymap_base();
@@ -53,14 +90,103 @@ class EEPROMKeymap : public kaleidoscope::Plugin {
 
   static void updateKey(uint16_t base_pos, Key key);
 
+  // Drops every cached layer, so that they will be read from storage again. Code
+  // that writes to the keymap's slice of storage without going through
+  // `updateKey()` or Focus has to call this, unless it calls the
+  // `onStorageChange()` hook.
+  static void flushCache();
+
  private:
   static uint16_t keymap_base_;
   static uint8_t max_layers_;
   static uint8_t progmem_layers_;
 
+  // The size of the slice holding sparse layers, or 0 if layers are stored in
+  // full.
+  static uint16_t sparse_size_;
+
+  // The state of a rewrite of layers (see `beginLayerWrites()`): the next layer
+  // to write, where in storage to write it, for sparse layers, where its
+  // current contents were moved, and how far, and the number of layers that
+  // didn't fit.
+  static uint8_t write_layer_;
+  static uint16_t write_pos_;
+  static uint16_t parked_pos_;
+  static uint16_t park_distance_;
+  static bool writing_layers_;
+  static uint8_t unwritten_layers_;
+
+  // The state of a `keymap.custom` upload: the keys of the layer being
+  // received, the index of the next one, and for binary uploads, the first
+  // byte of that key, if it was received already.
+  static Key upload_keys_[kaleidoscope_internal::device.numKeys()];
+  static uint8_t upload_index_;
+  static bool has_upload_byte_;
+  static uint8_t upload_byte_;
+
+  // A `keymap.sparse` upload sends each layer as its fill key, the number of
+  // other keys, and the index and value of each of those. It uses
+  // `upload_index_` for the index.
+  enum class SparseField : uint8_t {
+    Fill,
+    Count,
+    Index,
+    Key,
+  };
+  static SparseField sparse_field_;
+  static uint8_t sparse_left_;
+
+#if EEPROM_KEYMAP_CACHED_LAYERS
+  static constexpr uint8_t UNCACHED_LAYER = 0xff;
+
+  // The decoded keys of each cache slot, and the custom layer each slot holds.
+  static Key cache_[EEPROM_KEYMAP_CACHED_LAYERS][kaleidoscope_internal::device.numKeys()];
+  static uint8_t cached_layers_[EEPROM_KEYMAP_CACHED_LAYERS];
+  // The slots, ordered from the most to the least recently used.
+  static uint8_t cache_lru_[EEPROM_KEYMAP_CACHED_LAYERS];
+  // The `EEPROMSettings.crc()` the cache was filled with.
+  static uint16_t cache_crc_;
+
+  static Key *cachedLayer(uint8_t layer);
+#endif
+
+  // Writes `count` keys, from `index` on, through to the cached copies of
+  // `layer`.
+  static void updateCache(uint8_t layer, uint8_t index, const Key *keys, uint8_t count);
+
+  static Key readStorageKey(uint16_t pos);
+  static void updateStorageKey(uint16_t pos, Key key);
+  static void readLayer(uint8_t layer, Key *keys);
+
+  static uint16_t sparseLayerEnd(uint16_t pos);
+  static uint16_t sparseLayerPos(uint8_t layer);
+  static bool sparseLayersValid();
+  static uint16_t sparseKeyPos(uint16_t pos, KeyAddr key_addr);
+  static void readSparseLayer(uint16_t pos, Key *keys);
+  static uint16_t writeSparseLayer(uint16_t pos, const Key *keys);
+  static void moveStorage(uint16_t to, uint16_t from, uint16_t length);
+
+  // Rewrites whole layers, starting with `layer`: `nextLayer()` loads the
+  // current contents of the next layer to write, `writeLayer()` writes it (and
+  // returns false if a sparse layer didn't fit), and `endLayerWrites()` must be
+  // called once done.
+  static void beginLayerWrites(uint8_t layer);
+  static void nextLayer(Key *keys);
+  static bool writeLayer(const Key *keys);
+  static void endLayerWrites();
+
+  static void uploadKey(Key key);
+  static void uploadValue(uint16_t value);
+  static void uploadFrame(const uint8_t *data, uint8_t size);
+  static void uploadEnd();
+  static void uploadAbort();
+  static void uploadSparseValue(uint16_t value);
+  static void uploadSparseEnd();
+
   static Key parseKey();
   static void printKey(Key key);
   static void dumpKeymap(uint8_t layers, Key (*getkey)(uint8_t, KeyAddr));
+  static void dumpSparseKeymap();
 };
 
 }  // namespace plugin
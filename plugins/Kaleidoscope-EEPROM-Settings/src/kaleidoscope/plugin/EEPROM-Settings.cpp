@@ -30,6 +30,7 @@
 #include "kaleidoscope/Runtime.h"                     // for Runtime, Runtime_
 #include "kaleidoscope/device/device.h"               // for VirtualProps::Storage, Base<>::Storage
 #include "kaleidoscope/event_handler_result.h"        // for EventHandlerResult, EventHandlerRes...
+#include "kaleidoscope/hooks.h"                       // for Hooks
 #include "kaleidoscope/layers.h"                      // for Layer, Layer_, layer_count
 #include "kaleidoscope/plugin/EEPROM-Settings/crc.h"  // for CRCCalculator, CRC_
 
@@ -180,14 +181,17 @@ bool EEPROMSettings::isSliceValid(uint16_t start, size_t size) {
 }
 
 /** Focus **/
-EventHandlerResult FocusSettingsCommand::onFocusEvent(const char *input) {
-  const char *cmd_defaultLayer = PSTR("settings.defaultLayer");
-  const char *cmd_isValid      = PSTR("settings.valid?");
-  const char *cmd_version      = PSTR("settings.version");
-  const char *cmd_crc          = PSTR("settings.crc");
+FOCUS_COMMANDS(FocusSettingsCommand,
+               "settings.defaultLayer",
+               "settings.valid?",
+               "settings.version",
+               "settings.crc")
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_defaultLayer, cmd_isValid, cmd_version, cmd_crc);
+EventHandlerResult FocusSettingsCommand::onFocusEvent(const char *input) {
+  const auto cmd_defaultLayer = FOCUS_COMMAND("settings.defaultLayer");
+  const auto cmd_isValid      = FOCUS_COMMAND("settings.valid?");
+  const auto cmd_version      = FOCUS_COMMAND("settings.version");
+  const auto cmd_crc          = FOCUS_COMMAND("settings.crc");
 
   if (::Focus.inputMatchesCommand(input, cmd_defaultLayer)) {
     if (::Focus.isEOL()) {
@@ -210,27 +214,61 @@ EventHandlerResult FocusSettingsCommand::onFocusEvent(const char *input) {
   return EventHandlerResult::EVENT_CONSUMED;
 }
 
-EventHandlerResult FocusEEPROMCommand::onFocusEvent(const char *input) {
-  const char *cmd_contents = PSTR("eeprom.contents");
-  const char *cmd_free     = PSTR("eeprom.free");
-  const char *cmd_erase    = PSTR("eeprom.erase");
+uint16_t FocusEEPROMCommand::upload_pos_;
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_contents, cmd_free, cmd_erase);
+void FocusEEPROMCommand::uploadValue(uint16_t value) {
+  uint8_t b = value;
+  uploadFrame(&b, 1);
+}
+
+void FocusEEPROMCommand::uploadFrame(const uint8_t *data, uint8_t size) {
+  uint16_t length = Runtime.storage().length();
+  if (upload_pos_ >= length)
+    return;
+
+  if (size > length - upload_pos_)
+    size = length - upload_pos_;
+  Runtime.storage().writeBlock(upload_pos_, data, size);
+  upload_pos_ += size;
+}
+
+void FocusEEPROMCommand::uploadEnd() {
+  Runtime.storage().commit();
+  uploadAbort();
+}
+
+void FocusEEPROMCommand::uploadAbort() {
+  // Plugins that cache what they store have to know it changed under them
+  kaleidoscope::Hooks::onStorageChange();
+}
+
+FOCUS_COMMANDS(FocusEEPROMCommand,
+               "eeprom.contents",
+               "eeprom.free",
+               "eeprom.erase",
+               "storage.flush")
+
+EventHandlerResult FocusEEPROMCommand::onFocusEvent(const char *input) {
+  const auto cmd_contents = FOCUS_COMMAND("eeprom.contents");
+  const auto cmd_free     = FOCUS_COMMAND("eeprom.free");
+  const auto cmd_erase    = FOCUS_COMMAND("eeprom.erase");
+  const auto cmd_flush    = FOCUS_COMMAND("storage.flush");
 
   if (::Focus.inputMatchesCommand(input, cmd_contents)) {
     if (::Focus.isEOL()) {
-      for (uint16_t i = 0; i < Runtime.storage().length(); i++) {
-        uint8_t d = Runtime.storage().read(i);
-        ::Focus.send(d);
+      // The contents are sent through a small buffer, a block at a time.
+      uint8_t buffer[16];
+      uint16_t length = Runtime.storage().length();
+
+      for (uint16_t pos = 0; pos < length; pos += sizeof(buffer)) {
+        uint8_t size = (length - pos < sizeof(buffer)) ? length - pos : sizeof(buffer);
+        Runtime.storage().readBlock(pos, buffer, size);
+        for (uint8_t i = 0; i < size; i++)
+          ::Focus.send(buffer[i]);
       }
     } else {
-      for (uint16_t i = 0; i < Runtime.storage().length() && !::Focus.isEOL(); i++) {
-        uint8_t d;
-        ::Focus.read(d);
-        Runtime.storage().update(i, d);
-      }
-      Runtime.storage().commit();
+      upload_pos_ = 0;
+      ::Focus.streamArguments(uploadValue, uploadFrame, uploadEnd, uploadAbort);
     }
   } else if (::Focus.inputMatchesCommand(input, cmd_free)) {
     ::Focus.send(Runtime.storage().length() - ::EEPROMSettings.used());
@@ -238,6 +276,8 @@ EventHandlerResult FocusEEPROMCommand::onFocusEvent(const char *input) {
 
     Runtime.storage().erase();
     Runtime.device().rebootBootloader();
+  } else if (::Focus.inputMatchesCommand(input, cmd_flush)) {
+    Runtime.storage().flush();
   } else {
     return EventHandlerResult::OK;
   }
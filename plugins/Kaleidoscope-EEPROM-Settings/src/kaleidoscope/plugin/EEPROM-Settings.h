@@ -115,11 +115,21 @@ class EEPROMSettings : public kaleidoscope::Plugin {
 class FocusSettingsCommand : public kaleidoscope::Plugin {
  public:
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 };
 
 class FocusEEPROMCommand : public kaleidoscope::Plugin {
  public:
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
+
+ private:
+  // Where the next byte of an `eeprom.contents` upload goes.
+  static uint16_t upload_pos_;
+  static void uploadValue(uint16_t value);
+  static void uploadFrame(const uint8_t *data, uint8_t size);
+  static void uploadEnd();
+  static void uploadAbort();
 };
 
 }  // namespace plugin
@@ -49,11 +49,10 @@ EventHandlerResult EscapeOneShotConfig::onNameQuery() {
   return ::Focus.sendName(F("EscapeOneShot"));
 }
 
-EventHandlerResult EscapeOneShotConfig::onFocusEvent(const char *input) {
-  const char *cmd_cancel_key = PSTR("escape_oneshot.cancel_key");
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_cancel_key);
+FOCUS_COMMANDS(EscapeOneShotConfig, "escape_oneshot.cancel_key")
 
+EventHandlerResult EscapeOneShotConfig::onFocusEvent(const char *input) {
+  const auto cmd_cancel_key = FOCUS_COMMAND("escape_oneshot.cancel_key");
   if (!::Focus.inputMatchesCommand(input, cmd_cancel_key))
     return EventHandlerResult::OK;
 
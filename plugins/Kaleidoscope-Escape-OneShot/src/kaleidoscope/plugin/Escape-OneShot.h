@@ -62,6 +62,7 @@ class EscapeOneShotConfig : public Plugin {
  public:
   EventHandlerResult onSetup();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
   EventHandlerResult onNameQuery();
 
  private:
@@ -99,17 +99,16 @@ EventHandlerResult FingerPainter::onKeyEvent(KeyEvent &event) {
   return EventHandlerResult::EVENT_CONSUMED;
 }
 
+FOCUS_COMMANDS(FingerPainter, "fingerpainter.toggle", "fingerpainter.clear")
+
 EventHandlerResult FingerPainter::onFocusEvent(const char *input) {
   enum {
     TOGGLE,
     CLEAR,
   } sub_command;
 
-  const char *cmd_toggle = PSTR("fingerpainter.toggle");
-  const char *cmd_clear  = PSTR("fingerpainter.clear");
-
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_toggle, cmd_clear);
+  const auto cmd_toggle = FOCUS_COMMAND("fingerpainter.toggle");
+  const auto cmd_clear  = FOCUS_COMMAND("fingerpainter.clear");
 
   if (::Focus.inputMatchesCommand(input, cmd_toggle))
     sub_command = TOGGLE;
@@ -123,6 +122,7 @@ EventHandlerResult FingerPainter::onFocusEvent(const char *input) {
       Runtime.storage().update(color_base_ + i, 0);
     }
     Runtime.storage().commit();
+    ::LEDPaletteTheme.flushCache();
     return EventHandlerResult::OK;
   }
 
@@ -45,6 +45,7 @@ class FingerPainter : public LEDMode {
 
   EventHandlerResult onKeyEvent(KeyEvent &event);
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
   EventHandlerResult onSetup();
   EventHandlerResult onNameQuery();
 
@@ -55,11 +55,10 @@ EventHandlerResult FirmwareDump::onSetup() {
   return EventHandlerResult::OK;
 }
 
-EventHandlerResult FirmwareDump::onFocusEvent(const char *input) {
-  const char *cmd = PSTR("firmware.dump");
+FOCUS_COMMANDS(FirmwareDump, "firmware.dump")
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd);
+EventHandlerResult FirmwareDump::onFocusEvent(const char *input) {
+  const auto cmd = FOCUS_COMMAND("firmware.dump");
 
   if (!::Focus.inputMatchesCommand(input, cmd))
     return EventHandlerResult::OK;
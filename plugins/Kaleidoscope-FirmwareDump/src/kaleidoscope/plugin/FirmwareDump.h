@@ -40,6 +40,7 @@ class FirmwareDump : public kaleidoscope::Plugin {
  public:
   EventHandlerResult onSetup();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 
  private:
   uint16_t bootloader_size_;
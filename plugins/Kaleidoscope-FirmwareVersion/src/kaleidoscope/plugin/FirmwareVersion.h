@@ -37,12 +37,7 @@ namespace plugin {
 class FirmwareVersion : public Plugin {
  public:
   EventHandlerResult onFocusEvent(const char *input) {
-    const char *cmd_version = PSTR("version");
-
-    if (::Focus.inputMatchesHelp(input))
-      return ::Focus.printHelp(cmd_version);
-
-    if (!::Focus.inputMatchesCommand(input, cmd_version))
+    if (!::Focus.inputMatchesCommand(input, FOCUS_COMMAND("version")))
       return EventHandlerResult::OK;
 
 #ifdef KALEIDOSCOPE_FIRMWARE_VERSION
@@ -53,8 +48,11 @@ class FirmwareVersion : public Plugin {
 
     return EventHandlerResult::OK;
   }
+  static bool focusCommand(uint16_t hash, const char *command);
 };
 
+inline FOCUS_COMMANDS(FirmwareVersion, "version")
+
 }  // namespace plugin
 }  // namespace kaleidoscope
 
@@ -22,13 +22,14 @@
 
 #include "kaleidoscope/plugin/FocusSerial.h"
 
-#include <Arduino.h>         // for PSTR, F, strcmp_P
+#include <Arduino.h>         // for PSTR, F, micros, millis, strcmp_P
 #include <HardwareSerial.h>  // for HardwareSerial
 #include <string.h>          // for memset
 
 #include "kaleidoscope/Runtime.h"               // for Runtime, Runtime_
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult, EventHandlerResult::OK
 #include "kaleidoscope/hooks.h"                 // for Hooks
+#include "kaleidoscope/util/crc16.h"            // for _crc16_update
 
 #ifdef __AVR__
 #include <avr/pgmspace.h>
@@ -38,65 +39,248 @@ namespace kaleidoscope {
 namespace plugin {
 
 EventHandlerResult FocusSerial::afterEachCycle() {
-  int c;
   // GD32 doesn't currently autoflush the very last packet. So manually flush here
   Runtime.serialPort().flush();
-  // If the serial buffer is empty, we don't have any work to do
-  if (Runtime.serialPort().available() == 0) {
+  // If the serial buffer is empty, we don't have any work to do, unless the
+  // host stopped sending in the middle of a command.
+  if (!inputAvailable()) {
+    if (state_ != State::Command &&
+        Runtime.hasTimeExpired(last_input_at_, input_timeout_ms_)) {
+      if (state_ == State::Arguments) {
+        // What arrived is all there is to the arguments.
+        dispatch();
+        while (args_pos_ < args_len_)
+          processInput();
+      }
+      if (state_ == State::Binary || state_ == State::Discard) {
+        abortStream();
+      } else if (state_ != State::EndOfLine) {
+        endStream();
+      }
+      endCommand();
+    }
     return EventHandlerResult::OK;
   }
+  last_input_at_ = Runtime.millisAtCycleStart();
 
-  do {
-    // If there's a newline pending, don't read it
-    if (peek() == NEWLINE) {
-      break;
-    }
-    c = Runtime.serialPort().read();
-    // Don't store the separator; just stash it
-    if (c == SEPARATOR) {
-      break;
+  // Only process so much input per cycle, so that a host streaming a large
+  // upload doesn't hold up the rest of the keyboard. Storing what's uploaded
+  // may take a while, so the time spent counts as well.
+  uint32_t start = micros();
+  for (uint8_t n = 0;
+       n < bytes_per_cycle_ && inputAvailable() && micros() - start < us_per_cycle_;
+       n++)
+    processInput();
+  return EventHandlerResult::OK;
+}
+
+void FocusSerial::processInput() {
+  switch (state_) {
+  case State::Command:
+    processCommand(Runtime.serialPort().peek());
+    break;
+  case State::Arguments:
+    processArgument(Runtime.serialPort().peek());
+    break;
+  case State::EndOfLine:
+    // newline serves as an end-of-command marker
+    if (readInput() == NEWLINE)
+      endCommand();
+    break;
+  case State::Text:
+    processText(readInput());
+    break;
+  case State::Characters: {
+    char c = readInput();
+    if (c == NEWLINE) {
+      endStream();
+      endCommand();
+    } else {
+      on_char_(c);
     }
-    input_[buf_cursor_++] = c;
-  } while (buf_cursor_ < (sizeof(input_) - 1) && Runtime.serialPort().available());
+    break;
+  }
+  case State::Binary:
+    processFrame(readInput());
+    break;
+  case State::Discard:
+    // We can't tell where a broken transfer ends, so drop everything until
+    // the host stops sending.
+    readInput();
+    break;
+  }
+}
 
-  if ((c != SEPARATOR) && (Runtime.serialPort().peek() != NEWLINE) && buf_cursor_ < (sizeof(input_) - 1)) {
-    // We don't have enough command to work with yet.
-    // Let's leave the buffer around for another cycle
-    return EventHandlerResult::OK;
+void FocusSerial::processCommand(char c) {
+  // If there's a newline pending, don't read it, the command may look for it
+  if (c == NEWLINE) {
+    dispatch();
+    return;
+  }
+  Runtime.serialPort().read();
+  // Don't store the separator; the arguments follow it
+  if (c == SEPARATOR) {
+    state_ = State::Arguments;
+    return;
   }
+  input_[buf_cursor_++] = c;
+  if (buf_cursor_ == sizeof(input_) - 1)
+    dispatch();
+}
 
-  // Then process the command
-  Runtime.onFocusEvent(input_);
-  while (Runtime.serialPort().available()) {
-    c = Runtime.serialPort().read();
-    if (c == NEWLINE) {
-      // newline serves as an end-of-command marker
-      // don't drain the buffer past there
-      break;
-    }
+void FocusSerial::processArgument(char c) {
+  // The newline is left for the command, like above.
+  if (c == NEWLINE) {
+    dispatch();
+    return;
   }
-  // End of command processing is signalled with a CRLF followed by a single period
-  Runtime.serialPort().println(F("\r\n."));
+  // A binary transfer is streamed, so the command is dispatched as soon as it
+  // starts. So is a command whose arguments don't fit in the buffer, it either
+  // streams them, or reads the rest from the serial port.
+  if (c == BINARY && args_len_ == 0) {
+    args_overflow_ = true;
+    dispatch();
+    return;
+  }
+  args_[args_len_++] = Runtime.serialPort().read();
+  if (args_len_ == sizeof(args_)) {
+    args_overflow_ = true;
+    dispatch();
+  }
+}
+
+void FocusSerial::dispatch() {
+  state_      = State::EndOfLine;
+  input_hash_ = hashInput(input_);
+  Hooks::onFocusCommand(input_, input_hash_, inputMatchesHelp(input_));
   buf_cursor_ = 0;
   memset(input_, 0, sizeof(input_));
-  return EventHandlerResult::OK;
+}
+
+void FocusSerial::endCommand() {
+  // End of command processing is signalled with a CRLF followed by a single period
+  Runtime.serialPort().println(F("\r\n."));
+  state_         = State::Command;
+  args_len_      = 0;
+  args_pos_      = 0;
+  args_overflow_ = false;
+}
+
+void FocusSerial::streamArguments(ValueHandler on_value,
+                                  FrameHandler on_frame,
+                                  EndHandler on_end,
+                                  EndHandler on_abort) {
+  on_value_  = on_value;
+  on_frame_  = on_frame;
+  on_end_    = on_end;
+  on_abort_  = on_abort;
+  has_value_ = false;
+
+  if (on_frame && peekArgument() == BINARY) {
+    readArgument();
+    frame_pos_       = 0;
+    binary_received_ = 0;
+    state_           = State::Binary;
+  } else {
+    state_ = State::Text;
+  }
+}
+
+void FocusSerial::streamCharacters(CharHandler on_char, EndHandler on_end) {
+  on_char_   = on_char;
+  on_end_    = on_end;
+  has_value_ = false;
+  state_     = State::Characters;
+}
+
+void FocusSerial::processText(char c) {
+  if (c >= '0' && c <= '9') {
+    value_     = (has_value_ ? value_ * 10 : 0) + c - '0';
+    has_value_ = true;
+    return;
+  }
+
+  // Anything else separates arguments
+  if (has_value_) {
+    on_value_(value_);
+    has_value_ = false;
+  }
+  if (c == NEWLINE) {
+    endStream();
+    endCommand();
+  }
+}
+
+void FocusSerial::processFrame(uint8_t b) {
+  frame_[frame_pos_++] = b;
+
+  // A frame is a size byte, the payload, and the CRC16 of both.
+  uint8_t size = frame_[0];
+  if (size > binary_frame_size) {
+    state_ = State::Discard;
+    return;
+  }
+  if (frame_pos_ < size + 3)
+    return;
+  frame_pos_ = 0;
+
+  uint16_t crc = 0xffff;
+  for (uint8_t i = 0; i < size + 1; i++)
+    crc = _crc16_update(crc, frame_[i]);
+  if (crc != (frame_[size + 1] | (frame_[size + 2] << 8))) {
+    state_ = State::Discard;
+    return;
+  }
+
+  // An empty frame ends the transfer, the host ends the line after it.
+  if (size == 0) {
+    endStream();
+    state_ = State::EndOfLine;
+    return;
+  }
+  binary_received_ += size;
+  on_frame_(frame_ + 1, size);
+}
+
+void FocusSerial::endStream() {
+  if (has_value_)
+    on_value_(value_);
+  has_value_ = false;
+  if (on_end_)
+    on_end_();
+  if (state_ == State::Binary)
+    send(binary_received_);
+}
+
+void FocusSerial::abortStream() {
+  // A binary transfer that broke, or stopped before its empty frame, is
+  // incomplete. The command isn't told it ended, so that it doesn't store
+  // what it received of it, only that it was aborted.
+  has_value_ = false;
+  if (on_abort_)
+    on_abort_();
+  sendRaw(F("error: transfer aborted after "), binary_received_, F(" bytes"), NEWLINE);
 }
 
 void sendLedModeCallback_(const char *name) {
   Runtime.serialPort().println(name);
 }
 
-EventHandlerResult FocusSerial::onFocusEvent(const char *input) {
-  const char *cmd_help      = PSTR("help");
-  const char *cmd_reset     = PSTR("device.reset");
-  const char *cmd_led_modes = PSTR("led.modes");
-  const char *cmd_plugins   = PSTR("plugins");
+FOCUS_COMMANDS(FocusSerial,
+               "help",
+               "device.reset",
+               "led.modes",
+               "plugins",
+               "focus.binary")
 
-  if (inputMatchesHelp(input))
-    return printHelp(cmd_help, cmd_reset, cmd_led_modes, cmd_plugins);
+EventHandlerResult FocusSerial::onFocusEvent(const char *input) {
+  const auto cmd_reset     = FOCUS_COMMAND("device.reset");
+  const auto cmd_led_modes = FOCUS_COMMAND("led.modes");
+  const auto cmd_plugins   = FOCUS_COMMAND("plugins");
+  const auto cmd_binary    = FOCUS_COMMAND("focus.binary");
 
   if (inputMatchesCommand(input, cmd_reset)) {
-    Runtime.device().rebootBootloader();
+    Runtime.rebootBootloader();
     return EventHandlerResult::EVENT_CONSUMED;
   }
   if (inputMatchesCommand(input, cmd_led_modes)) {
@@ -107,6 +291,12 @@ EventHandlerResult FocusSerial::onFocusEvent(const char *input) {
     kaleidoscope::Hooks::onNameQuery();
     return EventHandlerResult::EVENT_CONSUMED;
   }
+  if (inputMatchesCommand(input, cmd_binary)) {
+    // Lets hosts find out if binary transfers are supported, and how large
+    // their frames may be.
+    send(binary_frame_size);
+    return EventHandlerResult::EVENT_CONSUMED;
+  }
 
   return EventHandlerResult::OK;
 }
@@ -116,30 +306,107 @@ void FocusSerial::printBool(bool b) {
 }
 
 bool FocusSerial::inputMatchesHelp(const char *input) {
-  return inputMatchesCommand(input, PSTR("help"));
+  // Compare the hash first, the name only if that matches.
+  return inputMatchesCommand(input, FOCUS_COMMAND("help")) &&
+         inputMatchesCommand(input, PSTR("help"));
+}
+
+bool FocusSerial::inputMatchesCommand(const char *input, const Command &expected) {
+  // The input is normally the command being dispatched, which is hashed
+  // already.
+  uint16_t hash = (input == input_) ? input_hash_ : hashInput(input);
+  return hash == expected.hash;
+}
+
+bool FocusSerial::commandTableEntry(uint16_t hash,
+                                    const char *command,
+                                    uint16_t entry_hash,
+                                    const char *entry_name) {
+  if (command == nullptr) {
+    ::Focus.printHelp(entry_name);
+    return false;
+  }
+  return hash == entry_hash && strcmp_P(command, entry_name) == 0;
 }
 
 bool FocusSerial::inputMatchesCommand(const char *input, const char *expected) {
   return strcmp_P(input, expected) == 0;
 }
 
+uint16_t FocusSerial::hashInput(const char *input) {
+  // The same as `commandHash()`, without the recursion.
+  uint16_t hash = 5381;
+  for (; *input; input++)
+    hash = (uint16_t)(hash * 33) ^ (uint8_t)*input;
+  return hash;
+}
 
-bool FocusSerial::isEOL() {
-  int c        = -1;
-  auto timeout = 1000;  // Runtime.serialPort().getTimeout(); // TODO nrf core doesn't expose getTimeout
-  auto start   = millis();
 
+bool FocusSerial::inputAvailable() {
+  // The arguments collected before the command was dispatched are read first.
+  return (state_ > State::Arguments && args_pos_ < args_len_) ||
+         Runtime.serialPort().available();
+}
+
+char FocusSerial::readInput() {
+  if (args_pos_ < args_len_)
+    return args_[args_pos_++];
+  return Runtime.serialPort().read();
+}
+
+int FocusSerial::peekArgument() {
+  if (args_pos_ < args_len_)
+    return args_[args_pos_];
+  // Once the collected arguments are read, the newline is all that's left,
+  // unless they didn't fit. The rest of those is waited for, like before.
+  if (!args_overflow_)
+    return -1;
 
-  // Duplicate some of Stream::timedPeek because it's protected
+  auto start = millis();
   do {
-    c = peek();
-    if (c == NEWLINE) {
-      return true;
-    } else if (c >= 0) {
-      return false;
-    }
-  } while ((millis() - start) < timeout);
-  return true;
+    int c = Runtime.serialPort().peek();
+    if (c == NEWLINE)
+      return -1;
+    if (c >= 0)
+      return c;
+  } while ((millis() - start) < input_timeout_ms_);
+  return -1;
+}
+
+int FocusSerial::readArgument() {
+  int c = peekArgument();
+  if (c >= 0)
+    readInput();
+  return c;
+}
+
+long FocusSerial::parseArgument() {
+  // Like `Stream::parseInt()`: skips anything but a number, then reads that.
+  int c = peekArgument();
+  while (c >= 0 && c != '-' && (c < '0' || c > '9')) {
+    readArgument();
+    c = peekArgument();
+  }
+
+  bool negative = (c == '-');
+  if (negative) {
+    readArgument();
+    c = peekArgument();
+  }
+
+  long value = 0;
+  while (c >= '0' && c <= '9') {
+    value = value * 10 + c - '0';
+    readArgument();
+    c = peekArgument();
+  }
+  return negative ? -value : value;
+}
+
+bool FocusSerial::isEOL() {
+  while (peekArgument() == SEPARATOR)
+    readArgument();
+  return peekArgument() < 0;
 }
 
 }  // namespace plugin
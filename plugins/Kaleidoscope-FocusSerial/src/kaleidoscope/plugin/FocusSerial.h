@@ -22,7 +22,7 @@
 
 #pragma once
 
-#include <Arduino.h>         // for __FlashStringHelper, delayMicroseconds
+#include <Arduino.h>         // for __FlashStringHelper, delayMicroseconds, PSTR
 #include <HardwareSerial.h>  // for HardwareSerial
 #include <stdint.h>          // for uint8_t, uint16_t
 
@@ -30,6 +30,7 @@
 #include "kaleidoscope/device/device.h"         // for cRGB
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult, EventHandlerResult::OK
 #include "kaleidoscope/key_defs.h"              // for Key
+#include "kaleidoscope/macro_map.h"             // for MAP, MAP_LIST
 #include "kaleidoscope/plugin.h"                // for Plugin
 
 // IWYU pragma: no_include "WString.h"
@@ -41,8 +42,59 @@ class FocusSerial : public kaleidoscope::Plugin {
   static constexpr char COMMENT   = '#';
   static constexpr char SEPARATOR = ' ';
   static constexpr char NEWLINE   = '\n';
+  // Starts a binary transfer, in place of a command's first argument.
+  static constexpr char BINARY = '\x02';
+  // The largest payload of a binary frame.
+  static constexpr uint8_t binary_frame_size = 32;
+
+  // Plugins list the commands they handle in a table, with
+  // `FOCUS_COMMANDS(Plugin, "name", ...)` in their source file, along with a
+  // `static bool focusCommand(uint16_t hash, const char *command);` declaration
+  // in their class. `KALEIDOSCOPE_INIT_PLUGINS()` builds the dispatch from
+  // these tables, so each command is only offered to the plugins that have it
+  // in theirs, and `help` lists the tables. The names are stored in PROGMEM,
+  // along with hashes computed at compile time, so that finding the command
+  // mostly compares hashes.
+  //
+  // As the dispatch checks names, a plugin's `onFocusEvent()` tells its
+  // commands apart by their hash alone, comparing `FOCUS_COMMAND("name")` to
+  // its input with `inputMatchesCommand()`. That is only safe if no two
+  // commands in a table have the same hash, which `FOCUS_COMMANDS()` checks
+  // at compile time.
+  struct Command {
+    uint16_t hash;
+  };
+  static constexpr uint16_t commandHash(const char *name, uint16_t hash = 5381) {
+    return *name ? commandHash(name + 1, (uint16_t)(hash * 33) ^ (uint8_t)*name) : hash;
+  }
+  template<uint16_t _hash>
+  struct ConstantHash {
+    static constexpr uint16_t value = _hash;
+  };
+  static constexpr bool hashIsUnique(uint16_t /*hash*/) {
+    return true;
+  }
+  template<typename... Hashes>
+  static constexpr bool hashIsUnique(uint16_t hash, uint16_t other, Hashes... rest) {
+    return hash != other && hashIsUnique(hash, rest...);
+  }
+  static constexpr bool hashesAreDistinct() {
+    return true;
+  }
+  template<typename... Hashes>
+  static constexpr bool hashesAreDistinct(uint16_t hash, Hashes... rest) {
+    return hashIsUnique(hash, rest...) && hashesAreDistinct(rest...);
+  }
+  // One entry of a `FOCUS_COMMANDS()` table: returns whether `command` is the
+  // entry, or, if `command` is null, prints the entry's name.
+  static bool commandTableEntry(uint16_t hash,
+                                const char *command,
+                                uint16_t entry_hash,
+                                const char *entry_name);
+  static bool focusCommand(uint16_t hash, const char *command);
 
   bool inputMatchesHelp(const char *input);
+  bool inputMatchesCommand(const char *input, const Command &expected);
   bool inputMatchesCommand(const char *input, const char *expected);
 
   EventHandlerResult printHelp() {
@@ -98,44 +150,124 @@ class FocusSerial : public kaleidoscope::Plugin {
   }
 
   const char peek() {
-    return Runtime.serialPort().peek();
+    return peekArgument();
   }
 
   void read(Key &key) {
-    key.setRaw(Runtime.serialPort().parseInt());
+    key.setRaw(parseArgument());
   }
   void read(cRGB &color) {
-    color.r = Runtime.serialPort().parseInt();
-    color.g = Runtime.serialPort().parseInt();
-    color.b = Runtime.serialPort().parseInt();
+    color.r = parseArgument();
+    color.g = parseArgument();
+    color.b = parseArgument();
   }
   void read(char &c) {
-    Runtime.serialPort().readBytes(&c, 1);
+    int b = readArgument();
+    if (b >= 0)
+      c = b;
   }
   void read(uint8_t &u8) {
-    u8 = Runtime.serialPort().parseInt();
+    u8 = parseArgument();
   }
   void read(uint16_t &u16) {
-    u16 = Runtime.serialPort().parseInt();
+    u16 = parseArgument();
   }
   void read(int8_t &i8) {
-    i8 = Runtime.serialPort().parseInt();
+    i8 = parseArgument();
   }
   void read(int16_t &i16) {
-    i16 = Runtime.serialPort().parseInt();
+    i16 = parseArgument();
   }
 
   bool isEOL();
 
+  // Streamed arguments, for commands that take a lot of them: instead of
+  // reading its arguments, such a command calls `streamArguments()` and
+  // returns. The arguments are then parsed as they arrive, a few bytes every
+  // cycle, so that a slow host never stalls the keyboard. `on_value` is called
+  // with each argument sent as text, `on_frame` with the payload of each frame
+  // of a binary transfer (see the README), and `on_end` once the arguments are
+  // over. A binary transfer is replied to with the number of bytes received
+  // intact. One that breaks, or stops before its end, is replied to with an
+  // error instead, and `on_abort`, if not null, is called instead of `on_end`. Commands that don't take binary transfers pass a null
+  // `on_frame`, and those with nothing left to do at the end a null `on_end`.
+  typedef void (*ValueHandler)(uint16_t value);
+  typedef void (*FrameHandler)(const uint8_t *data, uint8_t size);
+  typedef void (*EndHandler)();
+  void streamArguments(ValueHandler on_value,
+                       FrameHandler on_frame,
+                       EndHandler on_end,
+                       EndHandler on_abort = nullptr);
+  // Like `streamArguments()`, for commands whose arguments aren't numbers:
+  // `on_char` is called with every character of the line but the newline.
+  typedef void (*CharHandler)(char c);
+  void streamCharacters(CharHandler on_char, EndHandler on_end);
+
   /* Hooks */
   EventHandlerResult afterEachCycle();
   EventHandlerResult onFocusEvent(const char *input);
 
  private:
+  enum class State : uint8_t {
+    Command,    // Reading the command
+    Arguments,  // Waiting for the arguments to start arriving
+    EndOfLine,  // Skipping whatever the command didn't read
+    Text,       // Streaming arguments sent as text
+    Characters, // Streaming the characters of the arguments
+    Binary,     // Streaming the frames of a binary transfer
+    Discard,    // Dropping a broken binary transfer
+  };
+
+  // How many bytes of input are processed per cycle at most, for how long, in
+  // microseconds, and how long, in milliseconds, the host may pause in the
+  // middle of a command.
+  static constexpr uint8_t bytes_per_cycle_   = 64;
+  static constexpr uint16_t us_per_cycle_     = 500;
+  static constexpr uint16_t input_timeout_ms_ = 1000;
+
   char input_[32];
   uint8_t buf_cursor_ = 0;
   void printBool(bool b);
 
+  // The arguments are collected as they arrive, and the command is only
+  // dispatched once they're over, so that reading them doesn't have to wait
+  // for the host. Arguments that don't fit are read from the serial port as
+  // before, commands that take more should stream them instead.
+  char args_[32];
+  uint8_t args_len_   = 0;
+  uint8_t args_pos_   = 0;
+  bool args_overflow_ = false;
+
+  uint16_t input_hash_      = 0;
+  State state_              = State::Command;
+  uint32_t last_input_at_   = 0;
+  ValueHandler on_value_    = nullptr;
+  FrameHandler on_frame_    = nullptr;
+  EndHandler on_end_        = nullptr;
+  EndHandler on_abort_      = nullptr;
+  CharHandler on_char_      = nullptr;
+  uint16_t value_           = 0;
+  bool has_value_           = false;
+  uint8_t frame_pos_        = 0;
+  uint16_t binary_received_ = 0;
+  uint8_t frame_[binary_frame_size + 3];
+
+  static uint16_t hashInput(const char *input);
+  bool inputAvailable();
+  char readInput();
+  int peekArgument();
+  int readArgument();
+  long parseArgument();
+  void processInput();
+  void processCommand(char c);
+  void processArgument(char c);
+  void processText(char c);
+  void processFrame(uint8_t b);
+  void dispatch();
+  void endStream();
+  void abortStream();
+  void endCommand();
+
   // This is a hacky workaround for the host seemingly dropping characters
   // when a client spams its serial port too quickly
   // Verified on GD32 and macOS 12.3 2022-03-29
@@ -146,4 +278,28 @@ class FocusSerial : public kaleidoscope::Plugin {
 }  // namespace plugin
 }  // namespace kaleidoscope
 
+#define FOCUS_COMMAND(name)                            \
+  (::kaleidoscope::plugin::FocusSerial::Command{       \
+    ::kaleidoscope::plugin::FocusSerial::ConstantHash< \
+      ::kaleidoscope::plugin::FocusSerial::commandHash(name)>::value})
+
+#define _FOCUS_COMMANDS_ENTRY(name)                                   \
+  || ::kaleidoscope::plugin::FocusSerial::commandTableEntry(          \
+    hash, command,                                                    \
+    ::kaleidoscope::plugin::FocusSerial::ConstantHash<                \
+      ::kaleidoscope::plugin::FocusSerial::commandHash(name)>::value, \
+    PSTR(name))
+
+#define _FOCUS_COMMANDS_HASH(name) \
+  ::kaleidoscope::plugin::FocusSerial::commandHash(name)
+
+#define FOCUS_COMMANDS(PLUGIN, ...)                                        \
+  bool PLUGIN::focusCommand(uint16_t hash, const char *command) {          \
+    static_assert(::kaleidoscope::plugin::FocusSerial::hashesAreDistinct(  \
+                    MAP_LIST(_FOCUS_COMMANDS_HASH, __VA_ARGS__)),          \
+                  "Two Focus commands of " #PLUGIN " have the same hash, " \
+                  "or are listed twice; please rename one of them");       \
+    return false MAP(_FOCUS_COMMANDS_ENTRY, __VA_ARGS__);                  \
+  }
+
 extern kaleidoscope::plugin::FocusSerial Focus;
@@ -107,13 +107,13 @@ void __attribute__((optimize(3))) ErgoDox::readMatrix() {
 
 void __attribute__((optimize(3))) ErgoDox::actOnMatrixScan() {
   for (uint8_t row = 0; row < matrix_rows; row++) {
-    for (uint8_t col = 0; col < matrix_columns; col++) {
+    // Only keys that toggled on or off make an event, so we only visit those.
+    for (uint8_t changes = previousKeyState_[row] ^ keyState_[row]; changes != 0; changes &= changes - 1) {
+      uint8_t col       = __builtin_ctz(changes);
       uint8_t key_state = (bitRead(previousKeyState_[row], col) << 0) |
                           (bitRead(keyState_[row], col) << 1);
-      if (keyToggledOn(key_state) || keyToggledOff(key_state)) {
-        auto event = KeyEvent::next(KeyAddr(row, col), key_state);
-        kaleidoscope::Runtime.handleKeyswitchEvent(event);
-      }
+      auto event        = KeyEvent::next(KeyAddr(row, col), key_state);
+      kaleidoscope::Runtime.handleKeyswitchEvent(event);
     }
     previousKeyState_[row] = keyState_[row];
   }
@@ -70,6 +70,13 @@ class ErgoDox : public kaleidoscope::device::ATmega32U4Keyboard<ErgoDoxProps> {
   bool isKeyswitchPressed(KeyAddr key_addr);
   bool isKeyswitchPressed(uint8_t keyIndex);
   uint8_t pressedKeyswitchCount();
+  template<typename _Callback>
+  void forEachPressedKeyswitch(_Callback callback) {
+    for (uint8_t row = 0; row < matrix_rows; row++) {
+      for (uint8_t pressed = keyState_[row]; pressed != 0; pressed &= pressed - 1)
+        callback(KeyAddr(row, __builtin_ctz(pressed)));
+    }
+  }
 
   bool wasKeyswitchPressed(KeyAddr key_addr);
 
@@ -30,13 +30,18 @@
 #include "kaleidoscope/driver/bootloader/gd32/Base.h"
 #include "kaleidoscope/driver/hid/Keyboardio.h"
 #include "kaleidoscope/driver/mcu/GD32.h"
-#include "kaleidoscope/driver/storage/GD32Flash.h"
+#include "kaleidoscope/driver/storage/GD32FlashPages.h"
+#include "kaleidoscope/driver/storage/JournaledFlash.h"
 
 namespace kaleidoscope {
 namespace device {
 namespace gd32 {
 
-struct EvalStorageProps : kaleidoscope::driver::storage::GD32FlashProps {};
+// The storage is journaled into the last 44KiB of the GD32F303CC's 256KiB of
+// flash, so that flushes are spread over cycles, a page at a time.
+struct EvalStorageProps : kaleidoscope::driver::storage::JournaledFlashProps {
+  typedef kaleidoscope::driver::storage::GD32FlashPages<0x08035000, 2048, 22> Flash;
+};
 
 struct EvalProps : kaleidoscope::device::BaseProps {
   typedef kaleidoscope::driver::hid::KeyboardioProps HIDProps;
@@ -44,7 +49,7 @@ struct EvalProps : kaleidoscope::device::BaseProps {
 
   typedef kaleidoscope::driver::bootloader::gd32::Base Bootloader;
   typedef EvalStorageProps StorageProps;
-  typedef kaleidoscope::driver::storage::GD32Flash<StorageProps> Storage;
+  typedef kaleidoscope::driver::storage::JournaledFlash<StorageProps> Storage;
 
   typedef kaleidoscope::driver::mcu::GD32Props MCUProps;
   typedef kaleidoscope::driver::mcu::GD32<MCUProps> MCU;
@@ -22,6 +22,8 @@
 
 #ifdef ARDUINO_AVR_KEYBOARDIO_IMAGO
 
+#include <string.h>  // for memcmp
+
 #include "kaleidoscope/Runtime.h"
 #include "kaleidoscope/driver/keyscanner/Base_Impl.h"
 
@@ -91,7 +93,6 @@ ISR(TIMER1_OVF_vect) {
   Runtime.device().keyScanner().do_scan_ = true;
 }
 
-bool ImagoLEDDriver::isLEDChanged = true;
 cRGB ImagoLEDDriver::led_data[];
 uint8_t ImagoLEDDriver::brightness_adjustment_;
 
@@ -122,10 +123,7 @@ void ImagoLEDDriver::setCrgbAt(uint8_t i, cRGB crgb) {
   if (!Runtime.device().LEDs().isValid(i))
     return;
 
-  cRGB oldColor = getCrgbAt(i);
-  isLEDChanged |= !(oldColor.r == crgb.r && oldColor.g == crgb.g && oldColor.b == crgb.b);
-
-  led_data[i] = crgb;
+  storeColor(led_data[i], i, crgb);
 }
 
 cRGB ImagoLEDDriver::getCrgbAt(uint8_t i) {
@@ -135,6 +133,24 @@ cRGB ImagoLEDDriver::getCrgbAt(uint8_t i) {
   return led_data[i];
 }
 
+void ImagoLEDDriver::blit(const cRGB *colors, uint8_t first, uint8_t count) {
+  if (first >= Props_::led_count)
+    return;
+  if (count > Props_::led_count - first)
+    count = Props_::led_count - first;
+
+  if (memcmp(&led_data[first], colors, count * sizeof(cRGB)) == 0)
+    return;
+
+  for (uint8_t i = 0; i < count; i++)
+    storeColor(led_data[first + i], first + i, colors[i]);
+}
+
+void ImagoLEDDriver::fill(cRGB color) {
+  for (uint8_t i = 0; i < Props_::led_count; i++)
+    storeColor(led_data[i], i, color);
+}
+
 uint8_t ImagoLEDDriver::adjustBrightness(uint8_t value) {
   if (value > brightness_adjustment_)
     value -= brightness_adjustment_;
@@ -145,7 +161,8 @@ uint8_t ImagoLEDDriver::adjustBrightness(uint8_t value) {
 }
 
 void ImagoLEDDriver::syncLeds() {
-  //  if (!isLEDChanged)
+  //  uint8_t first, last;
+  //  if (!dirtyRange(first, last))
   //   return;
 
   uint8_t data[LED_REGISTER_DATA_LARGEST + 1];
@@ -184,7 +201,7 @@ void ImagoLEDDriver::syncLeds() {
 
   twi_writeTo(LED_DRIVER_ADDR, data, LED_REGISTER_DATA1_SIZE + 1, 1, 0);
 
-  isLEDChanged = false;
+  clearDirty();
 }
 
 
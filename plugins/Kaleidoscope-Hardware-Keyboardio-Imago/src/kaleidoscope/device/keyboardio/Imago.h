@@ -68,9 +68,11 @@ class ImagoLEDDriver : public kaleidoscope::driver::led::Base<ImagoLEDDriverProp
   static void syncLeds();
   static void setCrgbAt(uint8_t i, cRGB crgb);
   static cRGB getCrgbAt(uint8_t i);
+  static void blit(const cRGB *colors, uint8_t first, uint8_t count);
+  static void fill(cRGB color);
   static void setBrightness(uint8_t brightness) {
     brightness_adjustment_ = 255 - brightness;
-    isLEDChanged           = true;
+    markAllDirty();
   }
   static uint8_t getBrightness() {
     return 255 - brightness_adjustment_;
@@ -81,7 +83,6 @@ class ImagoLEDDriver : public kaleidoscope::driver::led::Base<ImagoLEDDriverProp
 
  private:
   static uint8_t brightness_adjustment_;
-  static bool isLEDChanged;
 
   static uint8_t adjustBrightness(uint8_t value);
   static void selectRegister(uint8_t);
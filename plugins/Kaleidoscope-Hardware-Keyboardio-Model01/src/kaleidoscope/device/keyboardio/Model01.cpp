@@ -28,6 +28,7 @@
 #include <Arduino.h>  // for PROGMEM
 // System headers
 #include <stdint.h>  // for uint8_t
+#include <string.h>  // for memcmp
 
 #ifndef KALEIDOSCOPE_VIRTUAL_BUILD
 #include <KeyboardioHID.h>
@@ -73,12 +74,14 @@ void Model01Hands::setup() {
 }
 
 /********* LED Driver *********/
-bool Model01LEDDriver::isLEDChanged = true;
+uint32_t Model01LEDDriver::led_bytes_saved_ = 0;
 
 void Model01LEDDriver::setBrightness(uint8_t brightness) {
   Model01Hands::leftHand.setBrightness(brightness);
   Model01Hands::rightHand.setBrightness(brightness);
-  isLEDChanged = true;
+  Model01Hands::leftHand.markAllLEDsDirty();
+  Model01Hands::rightHand.markAllLEDsDirty();
+  markAllDirty();
 }
 
 uint8_t Model01LEDDriver::getBrightness() {
@@ -86,16 +89,14 @@ uint8_t Model01LEDDriver::getBrightness() {
 }
 
 void Model01LEDDriver::setCrgbAt(uint8_t i, cRGB crgb) {
-  if (i < 32) {
-    cRGB oldColor = getCrgbAt(i);
-    isLEDChanged |= !(oldColor.r == crgb.r && oldColor.g == crgb.g && oldColor.b == crgb.b);
-
-    Model01Hands::leftHand.ledData.leds[i] = crgb;
-  } else if (i < 64) {
-    cRGB oldColor = getCrgbAt(i);
-    isLEDChanged |= !(oldColor.r == crgb.r && oldColor.g == crgb.g && oldColor.b == crgb.b);
-
-    Model01Hands::rightHand.ledData.leds[i - 32] = crgb;
+  if (i < 64) {
+    if (i < 32) {
+      if (storeColor(Model01Hands::leftHand.ledData.leds[i], i, crgb))
+        Model01Hands::leftHand.markLEDDirty(i);
+    } else {
+      if (storeColor(Model01Hands::rightHand.ledData.leds[i - 32], i, crgb))
+        Model01Hands::rightHand.markLEDDirty(i - 32);
+    }
   } else {
     // TODO(anyone):
     // how do we want to handle debugging assertions about crazy user
@@ -114,29 +115,70 @@ cRGB Model01LEDDriver::getCrgbAt(uint8_t i) {
   }
 }
 
-void Model01LEDDriver::syncLeds() {
-  if (!isLEDChanged)
+void Model01LEDDriver::blit(const cRGB *colors, uint8_t first, uint8_t count) {
+  if (first >= 64)
     return;
+  if (count > 64 - first)
+    count = 64 - first;
+
+  // The range is split between the hands once, rather than for every LED, and
+  // each hand's part of it is compared in one go.
+  while (count > 0) {
+    auto &hand     = (first < 32) ? Model01Hands::leftHand : Model01Hands::rightHand;
+    uint8_t offset = first % 32;
+    uint8_t size   = (count < 32 - offset) ? count : 32 - offset;
+
+    if (memcmp(&hand.ledData.leds[offset], colors, size * sizeof(cRGB)) != 0) {
+      for (uint8_t i = 0; i < size; i++) {
+        if (storeColor(hand.ledData.leds[offset + i], first + i, colors[i]))
+          hand.markLEDDirty(offset + i);
+      }
+    }
 
-  // LED Data is stored in four "banks" for each side
-  // We send it all at once to make it look nicer.
-  // We alternate left and right hands because otherwise
-  // we run into a race condition with updating the next bank
-  // on an ATTiny before it's done writing the previous one to memory
+    first += size;
+    colors += size;
+    count -= size;
+  }
+}
 
-  Model01Hands::leftHand.sendLEDData();
-  Model01Hands::rightHand.sendLEDData();
+void Model01LEDDriver::fill(cRGB color) {
+  for (uint8_t i = 0; i < 32; i++) {
+    if (storeColor(Model01Hands::leftHand.ledData.leds[i], i, color))
+      Model01Hands::leftHand.markLEDDirty(i);
+    if (storeColor(Model01Hands::rightHand.ledData.leds[i], i + 32, color))
+      Model01Hands::rightHand.markLEDDirty(i);
+  }
+}
 
-  Model01Hands::leftHand.sendLEDData();
-  Model01Hands::rightHand.sendLEDData();
+void Model01LEDDriver::syncLeds() {
+  // Each bank is sent with a one-byte command prefix.
+  constexpr uint8_t bank_message_size = LED_BYTES_PER_BANK + 1;
 
-  Model01Hands::leftHand.sendLEDData();
-  Model01Hands::rightHand.sendLEDData();
+  uint8_t first, last;
+  bool changed = dirtyRange(first, last);
+  if (changed)
+    clearDirty();
 
-  Model01Hands::leftHand.sendLEDData();
-  Model01Hands::rightHand.sendLEDData();
+  // LED Data is stored in four "banks" for each side, and we only send the
+  // ones that have changed since they were last sent.
+  // We alternate left and right hands because otherwise
+  // we run into a race condition with updating the next bank
+  // on an ATTiny before it's done writing the previous one to memory.
+  // Every changed bank is sent before we return: nothing may sync the LEDs
+  // again after this (`LEDControl.disable()` syncs them once, and stops).
+  uint8_t sent = driver::keyboardio::sendChangedLEDBanks(Model01Hands::leftHand,
+                                                         Model01Hands::rightHand);
+
+  // We used to send every bank of both hands whenever any LED changed, and
+  // nothing otherwise, so a sync saves the banks of a changed frame that it
+  // didn't send. The count is never decreased, because banks sent again after
+  // a failed write or `setAllLEDsTo()` would make it wrap around.
+  if (changed && sent < 2 * LED_BANKS)
+    led_bytes_saved_ += (2 * LED_BANKS - sent) * bank_message_size;
+}
 
-  isLEDChanged = false;
+uint32_t Model01LEDDriver::ledBytesSaved() {
+  return led_bytes_saved_;
 }
 
 bool Model01LEDDriver::ledPowerFault() {
@@ -181,18 +223,13 @@ void Model01KeyScanner::readMatrix() {
 }
 
 void Model01KeyScanner::actOnHalfRow(uint8_t row, uint8_t colState, uint8_t colPrevState, uint8_t startPos) {
-  if ((colState != colPrevState) || (colState != 0)) {
-    for (uint8_t col = 0; col < 8; col++) {
-      // Build up the key state for row, col
-      uint8_t keyState = ((bitRead(colPrevState, 0) << 0) |
-                          (bitRead(colState, 0) << 1));
-      if (keyState)
-        ThisType::handleKeyswitchEvent(Key_NoKey, KeyAddr(row, startPos - col), keyState);
-
-      // Throw away the data we've just used, so we can read the next column
-      colState     = colState >> 1;
-      colPrevState = colPrevState >> 1;
-    }
+  // Only keys that toggled on or off make an event, so we only visit those.
+  for (uint8_t changes = colState ^ colPrevState; changes != 0; changes &= changes - 1) {
+    uint8_t bit = __builtin_ctz(changes);
+    // Build up the key state for row, col
+    uint8_t keyState = ((bitRead(colPrevState, bit) << 0) |
+                        (bitRead(colState, bit) << 1));
+    ThisType::handleKeyswitchEvent(Key_NoKey, KeyAddr(row, startPos - bit), keyState);
   }
 }
 
@@ -77,14 +77,22 @@ class Model01LEDDriver : public kaleidoscope::driver::led::Base<Model01LEDDriver
   static void syncLeds();
   static void setCrgbAt(uint8_t i, cRGB crgb);
   static cRGB getCrgbAt(uint8_t i);
+  static void blit(const cRGB *colors, uint8_t first, uint8_t count);
+  static void fill(cRGB color);
   static void setBrightness(uint8_t brightness);
   static uint8_t getBrightness();
 
   static void enableHighPowerLeds();
+
+  /// Returns the number of bytes that didn't need to be sent to the keyboard
+  /// halves, because only the LED banks that changed were sent, rather than
+  /// all of them.
+  static uint32_t ledBytesSaved();
+
   static bool ledPowerFault();
 
  private:
-  static bool isLEDChanged;
+  static uint32_t led_bytes_saved_;
 };
 #else   // ifndef KALEIDOSCOPE_VIRTUAL_BUILD
 class Model01LEDDriver;
@@ -109,6 +117,15 @@ class Model01KeyScanner : public kaleidoscope::driver::keyscanner::Base<Model01K
 
   static bool isKeyswitchPressed(KeyAddr key_addr);
   static uint8_t pressedKeyswitchCount();
+  template<typename _Callback>
+  static void forEachPressedKeyswitch(_Callback callback) {
+    for (uint8_t row = 0; row < 4; row++) {
+      for (uint8_t pressed = leftHandState.rows[row]; pressed != 0; pressed &= pressed - 1)
+        callback(KeyAddr(row, 7 - __builtin_ctz(pressed)));
+      for (uint8_t pressed = rightHandState.rows[row]; pressed != 0; pressed &= pressed - 1)
+        callback(KeyAddr(row, 15 - __builtin_ctz(pressed)));
+    }
+  }
 
   static bool wasKeyswitchPressed(KeyAddr key_addr);
   static uint8_t previousPressedKeyswitchCount();
@@ -158,11 +158,13 @@ keydata_t Model01Side::getKeyData() {
   return keyData;
 }
 
-void Model01Side::sendLEDData() {
-  sendLEDBank(nextLEDBank++);
-  if (nextLEDBank == LED_BANKS) {
-    nextLEDBank = 0;
-  }
+bool Model01Side::sendLEDData() {
+  uint8_t bank = dirty_led_banks_.take();
+  if (bank == DirtyLEDBanks<LED_BANKS>::no_bank)
+    return false;
+
+  sendLEDBank(bank);
+  return true;
 }
 
 auto constexpr gamma8 = kaleidoscope::driver::color::gamma_correction;
@@ -192,6 +194,9 @@ void Model01Side::setAllLEDsTo(cRGB color) {
                     pgm_read_byte(&gamma8[color.g]),
                     pgm_read_byte(&gamma8[color.r])};
   uint8_t result = twi_writeTo(addr, data, ELEMENTS(data), 1, 0);
+  // The hand no longer shows what `ledData` holds, so have the next sync
+  // restore it.
+  markAllLEDsDirty();
 }
 
 void Model01Side::setOneLEDTo(uint8_t led, cRGB color) {
@@ -201,6 +206,9 @@ void Model01Side::setOneLEDTo(uint8_t led, cRGB color) {
                     pgm_read_byte(&gamma8[color.g]),
                     pgm_read_byte(&gamma8[color.r])};
   uint8_t result = twi_writeTo(addr, data, ELEMENTS(data), 1, 0);
+  // The hand no longer shows what `ledData` holds, so have the next sync
+  // restore it.
+  markLEDDirty(led);
 }
 
 }  // namespace keyboardio
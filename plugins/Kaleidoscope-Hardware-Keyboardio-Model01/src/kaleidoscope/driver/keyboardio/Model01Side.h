@@ -44,6 +44,7 @@ struct cRGB {
 
 #define LEDS_PER_HAND      32
 #define LED_BYTES_PER_BANK sizeof(cRGB) * LEDS_PER_HAND / LED_BANKS
+#define LEDS_PER_BANK      (LEDS_PER_HAND / LED_BANKS)
 
 namespace kaleidoscope {
 namespace driver {
@@ -59,6 +60,62 @@ typedef union {
   uint32_t all;
 } keydata_t;
 
+// The LED banks of a half that changed since they were last sent.
+template<uint8_t _banks>
+class DirtyLEDBanks {
+ public:
+  static constexpr uint8_t no_bank = 0xff;
+
+  void mark(uint8_t bank) {
+    dirty_ |= 1 << bank;
+  }
+  void markAll() {
+    dirty_ = (1 << _banks) - 1;
+  }
+  bool any() const {
+    return dirty_ != 0;
+  }
+
+  // Returns the next changed bank, and marks it clean, or `no_bank` if none
+  // changed. The search starts from the bank after the last one returned, so
+  // that a bank that changes all the time can't keep the others from being
+  // sent.
+  uint8_t take() {
+    if (dirty_ == 0)
+      return no_bank;
+
+    while (!(dirty_ & (1 << next_))) {
+      if (++next_ == _banks)
+        next_ = 0;
+    }
+    uint8_t bank = next_;
+    dirty_ &= ~(1 << bank);
+    if (++next_ == _banks)
+      next_ = 0;
+    return bank;
+  }
+
+ private:
+  uint8_t dirty_ = (1 << _banks) - 1;
+  uint8_t next_  = 0;
+};
+
+// Sends the changed LED banks of both halves, alternating between them, until
+// neither has any left: a half with more changed banks than the other gets the
+// rest of them once the other ran out, so that every sync sends the whole
+// frame. Returns the number of banks sent.
+template<typename _Side>
+uint8_t sendChangedLEDBanks(_Side &left, _Side &right) {
+  uint8_t sent = 0;
+  bool left_sent, right_sent;
+  do {
+    left_sent  = left.sendLEDData();
+    right_sent = right.sendLEDData();
+    sent += left_sent + right_sent;
+  } while (left_sent || right_sent);
+  return sent;
+}
+
 // config options
 
 #ifndef KALEIDOSCOPE_VIRTUAL_BUILD
@@ -76,7 +133,18 @@ class Model01Side {
   uint8_t setLEDSPIFrequency(uint8_t frequency);
   int readLEDSPIFrequency();
 
-  void sendLEDData();
+  // Sends the next LED bank that has changed since it was last sent, if any.
+  // Returns `true` if a bank was sent.
+  bool sendLEDData();
+  void markLEDDirty(uint8_t led) {
+    dirty_led_banks_.mark(led / LEDS_PER_BANK);
+  }
+  void markAllLEDsDirty() {
+    dirty_led_banks_.markAll();
+  }
+  bool hasDirtyLEDs() const {
+    return dirty_led_banks_.any();
+  }
   void setOneLEDTo(uint8_t led, cRGB color);
   void setAllLEDsTo(cRGB color);
   keydata_t getKeyData();
@@ -96,7 +164,7 @@ class Model01Side {
   int addr;
   int ad01;
   keydata_t keyData;
-  uint8_t nextLEDBank = 0;
+  DirtyLEDBanks<LED_BANKS> dirty_led_banks_;
   void sendLEDBank(uint8_t bank);
   int readRegister(uint8_t cmd);
 };
@@ -25,6 +25,7 @@
 #include "kaleidoscope/device/keyboardio/Model100.h"
 
 #include <Arduino.h>  // for PROGMEM
+#include <string.h>   // for memcmp
 #include <Wire.h>     // for Wire
 
 #include "kaleidoscope/driver/keyscanner/Base_Impl.h"  // For Base<>
@@ -57,12 +58,14 @@ void Model100Hands::setup() {
 }
 
 /********* LED Driver *********/
-bool Model100LEDDriver::isLEDChanged = true;
+uint32_t Model100LEDDriver::led_bytes_saved_ = 0;
 
 void Model100LEDDriver::setBrightness(uint8_t brightness) {
   Model100Hands::leftHand.setBrightness(brightness);
   Model100Hands::rightHand.setBrightness(brightness);
-  isLEDChanged = true;
+  Model100Hands::leftHand.markAllLEDsDirty();
+  Model100Hands::rightHand.markAllLEDsDirty();
+  markAllDirty();
 }
 
 uint8_t Model100LEDDriver::getBrightness() {
@@ -70,16 +73,14 @@ uint8_t Model100LEDDriver::getBrightness() {
 }
 
 void Model100LEDDriver::setCrgbAt(uint8_t i, cRGB crgb) {
-  if (i < 32) {
-    cRGB oldColor = getCrgbAt(i);
-    isLEDChanged |= !(oldColor.r == crgb.r && oldColor.g == crgb.g && oldColor.b == crgb.b);
-
-    Model100Hands::leftHand.ledData.leds[i] = crgb;
-  } else if (i < 64) {
-    cRGB oldColor = getCrgbAt(i);
-    isLEDChanged |= !(oldColor.r == crgb.r && oldColor.g == crgb.g && oldColor.b == crgb.b);
-
-    Model100Hands::rightHand.ledData.leds[i - 32] = crgb;
+  if (i < 64) {
+    if (i < 32) {
+      if (storeColor(Model100Hands::leftHand.ledData.leds[i], i, crgb))
+        Model100Hands::leftHand.markLEDDirty(i);
+    } else {
+      if (storeColor(Model100Hands::rightHand.ledData.leds[i - 32], i, crgb))
+        Model100Hands::rightHand.markLEDDirty(i - 32);
+    }
   } else {
     // TODO(anyone):
     // how do we want to handle debugging assertions about crazy user
@@ -98,28 +99,76 @@ cRGB Model100LEDDriver::getCrgbAt(uint8_t i) {
   }
 }
 
-void Model100LEDDriver::syncLeds() {
-  if (!isLEDChanged)
+void Model100LEDDriver::blit(const cRGB *colors, uint8_t first, uint8_t count) {
+  if (first >= 64)
     return;
-  // LED Data is stored in four "banks" for each side
-  // We send it all at once to make it look nicer.
-  // We alternate left and right hands because otherwise
-  // we run into a race condition with updating the next bank
-  // on an ATTiny before it's done writing the previous one to memory
-
-  Model100Hands::leftHand.sendLEDData();
-  Model100Hands::rightHand.sendLEDData();
+  if (count > 64 - first)
+    count = 64 - first;
+
+  // The range is split between the hands once, rather than for every LED, and
+  // each hand's part of it is compared in one go.
+  while (count > 0) {
+    auto &hand     = (first < 32) ? Model100Hands::leftHand : Model100Hands::rightHand;
+    uint8_t offset = first % 32;
+    uint8_t size   = (count < 32 - offset) ? count : 32 - offset;
+
+    if (memcmp(&hand.ledData.leds[offset], colors, size * sizeof(cRGB)) != 0) {
+      for (uint8_t i = 0; i < size; i++) {
+        if (storeColor(hand.ledData.leds[offset + i], first + i, colors[i]))
+          hand.markLEDDirty(offset + i);
+      }
+    }
 
-  Model100Hands::leftHand.sendLEDData();
-  Model100Hands::rightHand.sendLEDData();
+    first += size;
+    colors += size;
+    count -= size;
+  }
+}
 
-  Model100Hands::leftHand.sendLEDData();
-  Model100Hands::rightHand.sendLEDData();
+void Model100LEDDriver::fill(cRGB color) {
+  for (uint8_t i = 0; i < 32; i++) {
+    if (storeColor(Model100Hands::leftHand.ledData.leds[i], i, color))
+      Model100Hands::leftHand.markLEDDirty(i);
+    if (storeColor(Model100Hands::rightHand.ledData.leds[i], i + 32, color))
+      Model100Hands::rightHand.markLEDDirty(i);
+  }
+}
 
-  Model100Hands::leftHand.sendLEDData();
-  Model100Hands::rightHand.sendLEDData();
+void Model100LEDDriver::syncLeds() {
+  // Each bank is sent with a one-byte command prefix.
+  constexpr uint8_t bank_message_size = LED_BYTES_PER_BANK + 1;
+
+  uint8_t first, last;
+  bool changed = dirtyRange(first, last);
+  if (changed)
+    clearDirty();
+
+  // LED Data is stored in four "banks" for each side, and we only send the
+  // ones that have changed since they were last sent. They are queued rather
+  // than sent right away: the bus scheduler sends them along with the next key
+  // reads, never sending two banks in a row to the same hand, because
+  // otherwise we run into a race condition with updating the next bank on an
+  // ATTiny before it's done writing the previous one to memory. We alternate
+  // left and right hands, so that when both of them changed, the whole frame
+  // is sent in one cycle.
+  uint8_t sent = 0;
+  bool left_sent, right_sent;
+  do {
+    left_sent  = Model100Hands::leftHand.sendLEDData();
+    right_sent = Model100Hands::rightHand.sendLEDData();
+    sent += left_sent + right_sent;
+  } while (left_sent || right_sent);
+
+  // We used to send every bank of both hands whenever any LED changed, and
+  // nothing otherwise, so a sync saves the banks of a changed frame that it
+  // didn't send. The count is never decreased, because banks sent again after
+  // a failed write or `setAllLEDsTo()` would make it wrap around.
+  if (changed && sent < 2 * LED_BANKS)
+    led_bytes_saved_ += (2 * LED_BANKS - sent) * bank_message_size;
+}
 
-  isLEDChanged = false;
+uint32_t Model100LEDDriver::ledBytesSaved() {
+  return led_bytes_saved_;
 }
 
 /********* Key scanner *********/
@@ -160,6 +209,10 @@ void Model100KeyScanner::readMatrix() {
   previousLeftHandState  = leftHandState;
   previousRightHandState = rightHandState;
 
+  // This completes the key reads asked for by the previous scan (along with any
+  // LED updates queued since), so that we work with the latest snapshot.
+  driver::keyboardio::Model100Side::updateBus();
+
   if (Model100Hands::leftHand.readKeys()) {
     leftHandState = Model100Hands::leftHand.getKeyData();
   }
@@ -170,18 +223,13 @@ void Model100KeyScanner::readMatrix() {
 }
 
 void Model100KeyScanner::actOnHalfRow(uint8_t row, uint8_t colState, uint8_t colPrevState, uint8_t startPos) {
-  if ((colState != colPrevState) || (colState != 0)) {
-    for (uint8_t col = 0; col < 8; col++) {
-      // Build up the key state for row, col
-      uint8_t keyState = ((bitRead(colPrevState, 0) << 0) |
-                          (bitRead(colState, 0) << 1));
-      if (keyState)
-        ThisType::handleKeyswitchEvent(Key_NoKey, KeyAddr(row, startPos - col), keyState);
-
-      // Throw away the data we've just used, so we can read the next column
-      colState     = colState >> 1;
-      colPrevState = colPrevState >> 1;
-    }
+  // Only keys that toggled on or off make an event, so we only visit those.
+  for (uint8_t changes = colState ^ colPrevState; changes != 0; changes &= changes - 1) {
+    uint8_t bit = __builtin_ctz(changes);
+    // Build up the key state for row, col
+    uint8_t keyState = ((bitRead(colPrevState, bit) << 0) |
+                        (bitRead(colState, bit) << 1));
+    ThisType::handleKeyswitchEvent(Key_NoKey, KeyAddr(row, startPos - bit), keyState);
   }
 }
 
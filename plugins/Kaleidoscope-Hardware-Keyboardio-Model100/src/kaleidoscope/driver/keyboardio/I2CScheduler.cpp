@@ -0,0 +1,54 @@
+/* kaleidoscope::driver::keyboardio::I2CScheduler
+ * Copyright (C) 2025 Keyboard.io, Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef KALEIDOSCOPE_VIRTUAL_BUILD
+
+#include "kaleidoscope/driver/keyboardio/I2CScheduler.h"
+
+#include <Wire.h>  // for Wire
+
+namespace kaleidoscope {
+namespace driver {
+namespace keyboardio {
+
+bool WireI2CTransport::start(I2CTransaction &t) {
+  if (!t.is_read) {
+    Wire.beginTransmission(t.addr);
+    Wire.write(t.data, t.length);
+    t.result = Wire.endTransmission();
+    return true;
+  }
+
+  uint8_t bytes_returned = Wire.requestFrom(t.addr, t.length);
+  uint8_t i              = 0;
+  while (Wire.available() && i < t.length)
+    t.data[i++] = Wire.read();
+  // `Wire.endTransmission()` uses 4 for "other error"; a short read is one.
+  t.result = (bytes_returned < t.length || i < t.length) ? 4 : 0;
+  return true;
+}
+
+}  // namespace keyboardio
+}  // namespace driver
+}  // namespace kaleidoscope
+
+#endif  // ifndef KALEIDOSCOPE_VIRTUAL_BUILD
@@ -0,0 +1,371 @@
+// -*- mode: c++ -*-
+/* kaleidoscope::driver::keyboardio::I2CScheduler
+ * Copyright (C) 2025 Keyboard.io, Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>  // for uint8_t, uint16_t
+#include <string.h>  // for memcpy
+
+namespace kaleidoscope {
+namespace driver {
+namespace keyboardio {
+
+// A single transfer to or from one of the keyscanners.
+struct I2CTransaction {
+  // Large enough for an LED bank command, the largest thing we ever send.
+  static constexpr uint8_t max_length = 25;
+
+  uint8_t addr;
+  // The slot of the device the transaction is for, see `I2CScheduler`.
+  uint8_t slot;
+  uint8_t length;
+  bool is_read;
+  // 0 on success, otherwise an error code from the transport.
+  uint8_t result;
+  // The bytes to write, or the bytes that were read.
+  uint8_t data[max_length];
+};
+
+/// Schedules the transfers between the keyboard and its keyscanners
+///
+/// Reading the keyscanners and sending them LED data used to be done with
+/// blocking transfers, right when the data was needed. The scheduler instead
+/// queues them, and runs them from `update()`, which is called once per cycle:
+/// key reads always go first, and LED writes follow in the order they were
+/// queued, but never two in a row to the same device, so that an ATTiny always
+/// has time to store one LED bank (while the other one gets its bank) before it
+/// receives the next one. The most recent result of each read is kept until it
+/// is taken, so the key scanner only ever consumes a completed snapshot.
+///
+/// Each device has a slot, which holds the result of its last read, and whether
+/// any of its reads or writes failed since the device last asked, so that the
+/// driver of that device can tell that data it sent might not have arrived.
+///
+/// The transfers themselves are done by a `_Transport`, which has to provide:
+///
+/// - `bool start(I2CTransaction &t)`, which begins a transaction, and returns
+///   `true` if it has already completed.
+/// - `bool poll(I2CTransaction &t)`, which returns `true` once the transaction
+///   that was started last has completed.
+///
+/// A transport that completes transactions in the background (from an interrupt
+/// handler or by DMA) would let `update()` return while one is in flight, and
+/// pick up the result on the next cycle. A blocking one completes everything
+/// right away. The only transport for the hardware, `WireI2CTransport`, blocks.
+template<typename _Transport,
+         uint8_t _slots            = 2,
+         uint8_t _write_queue_size = 8>
+class I2CScheduler {
+ public:
+  static constexpr uint8_t max_read_length = 8;
+
+  _Transport &transport() {
+    return transport_;
+  }
+
+  /// Requests that `length` bytes be read from `addr` on the next update. The
+  /// result will be available from `takeReadData(slot, ...)`.
+  void requestRead(uint8_t slot, uint8_t addr, uint8_t length) {
+    slots_[slot].addr      = addr;
+    slots_[slot].length    = length;
+    slots_[slot].requested = true;
+  }
+
+  /// If a read has completed in `slot` since this was last called, copies the
+  /// bytes that were read to `data` and returns `true`.
+  bool takeReadData(uint8_t slot, uint8_t *data) {
+    Slot &read = slots_[slot];
+    if (!read.completed)
+      return false;
+    read.completed = false;
+    memcpy(data, read.data, read.length);
+    return true;
+  }
+
+  /// Returns `true` if a read in `slot` has failed since this was last called.
+  bool takeReadError(uint8_t slot) {
+    Slot &read = slots_[slot];
+    if (!read.read_failed)
+      return false;
+    read.read_failed = false;
+    return true;
+  }
+
+  /// Returns `true` if a write queued for `slot` has failed since this was last
+  /// called.
+  bool takeWriteError(uint8_t slot) {
+    Slot &device = slots_[slot];
+    if (!device.write_failed)
+      return false;
+    device.write_failed = false;
+    return true;
+  }
+
+  /// Queues `length` bytes to be written to `addr`, for the device in `slot`.
+  /// Returns `false` if there's no room left in the queue.
+  bool queueWrite(uint8_t slot, uint8_t addr, const uint8_t *data, uint8_t length) {
+    if (isWriteQueueFull())
+      return false;
+    uint8_t tail = write_head_ + write_count_;
+    if (tail >= _write_queue_size)
+      tail -= _write_queue_size;
+    I2CTransaction &t = writes_[tail];
+    t.addr            = addr;
+    t.slot            = slot;
+    t.length          = length;
+    t.is_read         = false;
+    memcpy(t.data, data, length);
+    ++write_count_;
+    return true;
+  }
+
+  bool isWriteQueueFull() const {
+    return write_count_ == _write_queue_size;
+  }
+
+  bool isIdle() const {
+    if (busy_ || write_count_ != 0)
+      return false;
+    for (uint8_t i = 0; i < _slots; ++i) {
+      if (slots_[i].requested)
+        return false;
+    }
+    return true;
+  }
+
+  /// Completes the transaction in flight, if it is done, and starts the ones
+  /// that are queued, for as long as the transport completes them right away.
+  void update() {
+    if (busy_) {
+      if (!transport_.poll(current_))
+        return;
+      complete();
+    }
+
+    for (uint8_t i = 0; i < _slots; ++i) {
+      Slot &read = slots_[i];
+      if (!read.requested)
+        continue;
+      read.requested   = false;
+      current_.addr    = read.addr;
+      current_.slot    = i;
+      current_.length  = read.length;
+      current_.is_read = true;
+      if (!start())
+        return;
+    }
+
+    // Never two writes in a row to the same device: the rest of the queue has
+    // to wait for the next update, a cycle later.
+    bool written = false;
+    while (write_count_ != 0) {
+      const I2CTransaction &next = writes_[write_head_];
+      if (written && next.addr == current_.addr)
+        return;
+      written = true;
+
+      current_ = next;
+      if (++write_head_ == _write_queue_size)
+        write_head_ = 0;
+      --write_count_;
+      if (!start())
+        return;
+    }
+  }
+
+  /// Runs every queued transaction to completion. This has to be done before
+  /// using the bus directly, for commands that are not scheduled.
+  void flush() {
+    while (!isIdle())
+      update();
+  }
+
+ private:
+  struct Slot {
+    uint8_t addr;
+    uint8_t length;
+    bool requested;
+    bool completed;
+    bool read_failed;
+    bool write_failed;
+    uint8_t data[max_read_length];
+  };
+
+  _Transport transport_;
+  Slot slots_[_slots] = {};
+  I2CTransaction writes_[_write_queue_size];
+  uint8_t write_head_  = 0;
+  uint8_t write_count_ = 0;
+  I2CTransaction current_;
+  bool busy_ = false;
+
+  // Starts `current_`, and returns `true` if it has already completed.
+  bool start() {
+    busy_ = true;
+    if (!transport_.start(current_))
+      return false;
+    complete();
+    return true;
+  }
+
+  void complete() {
+    busy_      = false;
+    Slot &slot = slots_[current_.slot];
+    if (!current_.is_read) {
+      if (current_.result != 0)
+        slot.write_failed = true;
+      return;
+    }
+    // A failed read doesn't replace the last good snapshot.
+    if (current_.result != 0) {
+      slot.read_failed = true;
+      return;
+    }
+    memcpy(slot.data, current_.data, slot.length);
+    slot.completed = true;
+  }
+};
+
+#ifndef KALEIDOSCOPE_VIRTUAL_BUILD
+
+// Runs transactions with the blocking `Wire` API, which is the only one the
+// GD32 core offers. Every transaction is complete by the time `start()`
+// returns.
+class WireI2CTransport {
+ public:
+  bool start(I2CTransaction &t);
+  bool poll(I2CTransaction &t) {
+    return true;
+  }
+};
+
+#else  // ifndef KALEIDOSCOPE_VIRTUAL_BUILD
+
+// A deterministic stand-in for the I2C bus, for testing. Each transaction stays
+// in flight for a fixed number of polls (`latency`, so with the scheduler, it
+// completes that many updates after the one that started it), reads return
+// whatever was last set for the device, and writes are counted.
+class VirtualI2CTransport {
+ public:
+  static constexpr uint8_t max_devices = 4;
+
+  void setLatency(uint8_t polls) {
+    latency_ = polls;
+  }
+  void setReadData(uint8_t addr, const uint8_t *data, uint8_t length) {
+    Device &device = findDevice(addr);
+    device.length  = length;
+    memcpy(device.data, data, length);
+  }
+  // Makes every transaction with `addr` fail, as if the device was unplugged.
+  void setConnected(uint8_t addr, bool connected) {
+    findDevice(addr).connected = connected;
+  }
+
+  uint16_t readCount(uint8_t addr) {
+    return findDevice(addr).reads;
+  }
+  uint16_t writeCount(uint8_t addr) {
+    return findDevice(addr).writes;
+  }
+  const I2CTransaction &lastWrite() const {
+    return last_write_;
+  }
+  bool isBusy() const {
+    return busy_;
+  }
+
+  bool start(I2CTransaction &t) {
+    if (latency_ == 0) {
+      transfer(t);
+      return true;
+    }
+    busy_      = true;
+    remaining_ = latency_;
+    return false;
+  }
+  bool poll(I2CTransaction &t) {
+    if (--remaining_ != 0)
+      return false;
+    busy_ = false;
+    transfer(t);
+    return true;
+  }
+
+ private:
+  struct Device {
+    uint8_t addr;
+    bool used;
+    bool connected;
+    uint8_t length;
+    uint8_t data[I2CTransaction::max_length];
+    uint16_t reads;
+    uint16_t writes;
+  };
+
+  Device devices_[max_devices] = {};
+  I2CTransaction last_write_   = {};
+  uint8_t latency_             = 0;
+  uint8_t remaining_           = 0;
+  bool busy_                   = false;
+
+  void transfer(I2CTransaction &t) {
+    Device &device = findDevice(t.addr);
+    if (!device.connected) {
+      t.result = 2;  // The same code `Wire` uses for a NACK on the address
+      return;
+    }
+    t.result = 0;
+    if (t.is_read) {
+      ++device.reads;
+      for (uint8_t i = 0; i < t.length; ++i)
+        t.data[i] = i < device.length ? device.data[i] : 0;
+    } else {
+      ++device.writes;
+      last_write_ = t;
+    }
+  }
+
+  Device &findDevice(uint8_t addr) {
+    for (Device &device : devices_) {
+      if (device.used && device.addr == addr)
+        return device;
+    }
+    for (Device &device : devices_) {
+      if (!device.used) {
+        device.used      = true;
+        device.addr      = addr;
+        device.connected = true;
+        return device;
+      }
+    }
+    // Out of devices; tests never use more than a couple.
+    return devices_[max_devices - 1];
+  }
+};
+
+#endif  // ifndef KALEIDOSCOPE_VIRTUAL_BUILD
+
+}  // namespace keyboardio
+}  // namespace driver
+}  // namespace kaleidoscope
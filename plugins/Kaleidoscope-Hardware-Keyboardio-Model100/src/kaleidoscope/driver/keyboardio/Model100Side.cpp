@@ -40,6 +40,8 @@ namespace keyboardio {
 
 uint8_t twi_uninitialized = 1;
 
+Model100Side::Bus Model100Side::bus_;
+
 Model100Side::Model100Side(uint8_t setAd01) {
   ad01 = setAd01;
   addr = SCANNER_I2C_ADDR_BASE | ad01;
@@ -133,12 +135,17 @@ bool Model100Side::isDeviceAvailable() {
 
 void Model100Side::markDeviceUnavailable() {
   unavailable_device_check_countdown_ = 1;  // We think there was a comms problem. Check on the next cycle
+  // We can't tell which LED banks made it, so send all of them again.
+  markAllLEDsDirty();
 }
 
 uint8_t Model100Side::writeData(uint8_t *data, uint8_t length) {
   if (isDeviceAvailable() == false) {
     return 1;
   }
+  // Commands sent directly have to wait for the scheduled ones, to keep them in
+  // order, and because the bus can only do one thing at a time.
+  bus_.flush();
   Wire.beginTransmission(addr);
   Wire.write(data, length);
   uint8_t result = Wire.endTransmission();
@@ -179,43 +186,53 @@ int Model100Side::readRegister(uint8_t cmd) {
 
 // gives information on the key that was just pressed or released.
 bool Model100Side::readKeys() {
-  if (isDeviceAvailable() == false) {
-    return false;
-  }
+  uint8_t data[5];  // TWI_REPLY_KEYDATA, followed by the four rows
+  bool fresh = bus_.takeReadData(ad01, data);
+  if (bus_.takeReadError(ad01))
+    markDeviceUnavailable();
+  // A failed LED bank write leaves the hand showing something other than
+  // `ledData`; marking the device unavailable has every bank sent again.
+  if (bus_.takeWriteError(ad01))
+    markDeviceUnavailable();
 
-  uint8_t row_counter = 0;
-  // perform blocking read into buffer
-  uint8_t read           = 0;
-  uint8_t bytes_returned = 0;
-  bytes_returned         = Wire.requestFrom(addr, 5);  // request 5 bytes from the keyscanner
-  if (bytes_returned < 5) {
+  if (isDeviceAvailable())
+    bus_.requestRead(ad01, addr, ELEMENTS(data));
+
+  if (!fresh || data[0] != TWI_REPLY_KEYDATA)
     return false;
-  }
-  if (Wire.available()) {
-    read = Wire.read();
-    if (TWI_REPLY_KEYDATA == read) {
-      while (Wire.available()) {
-        keyData.rows[row_counter++] = Wire.read();
-      }
-      return true;
-    }
-  }
-  return false;
+  for (uint8_t row = 0; row < 4; row++)
+    keyData.rows[row] = data[row + 1];
+  return true;
 }
 
 keydata_t Model100Side::getKeyData() {
   return keyData;
 }
 
-void Model100Side::sendLEDData() {
+bool Model100Side::sendLEDData() {
+  if (dirty_led_banks_ == 0 || bus_.isWriteQueueFull())
+    return false;
+
+  // Look for a changed bank starting from the one after the last bank sent, so
+  // that a bank that changes all the time can't keep the others from being
+  // sent.
+  while (!(dirty_led_banks_ & (1 << nextLEDBank))) {
+    if (++nextLEDBank == LED_BANKS)
+      nextLEDBank = 0;
+  }
+  dirty_led_banks_ &= ~(1 << nextLEDBank);
   sendLEDBank(nextLEDBank++);
   if (nextLEDBank == LED_BANKS) {
     nextLEDBank = 0;
   }
+  return true;
 }
 
 auto constexpr gamma8 = kaleidoscope::driver::color::gamma_correction;
 
+static_assert(LED_BYTES_PER_BANK + 1 <= I2CTransaction::max_length,
+              "An LED bank command must fit in an I2CTransaction");
+
 void Model100Side::sendLEDBank(uint8_t bank) {
   uint8_t data[LED_BYTES_PER_BANK + 1];
   data[0] = TWI_CMD_LED_BASE + bank;
@@ -232,7 +249,8 @@ void Model100Side::sendLEDBank(uint8_t bank) {
 
     data[i + 1] = pgm_read_byte(&gamma8[c]);
   }
-  uint8_t result = writeData(data, ELEMENTS(data));
+  if (isDeviceAvailable())
+    bus_.queueWrite(ad01, addr, data, ELEMENTS(data));
 }
 
 void Model100Side::setAllLEDsTo(cRGB color) {
@@ -241,6 +259,9 @@ void Model100Side::setAllLEDsTo(cRGB color) {
                     pgm_read_byte(&gamma8[color.g]),
                     pgm_read_byte(&gamma8[color.r])};
   uint8_t result = writeData(data, ELEMENTS(data));
+  // The hand no longer shows what `ledData` holds, so have the next sync
+  // restore it.
+  markAllLEDsDirty();
 }
 
 void Model100Side::setOneLEDTo(uint8_t led, cRGB color) {
@@ -250,6 +271,9 @@ void Model100Side::setOneLEDTo(uint8_t led, cRGB color) {
                     pgm_read_byte(&gamma8[color.g]),
                     pgm_read_byte(&gamma8[color.r])};
   uint8_t result = writeData(data, ELEMENTS(data));
+  // The hand no longer shows what `ledData` holds, so have the next sync
+  // restore it.
+  markLEDDirty(led);
 }
 
 }  // namespace keyboardio
@@ -26,6 +26,8 @@
 #include <Arduino.h>  // for byte
 #include <stdint.h>   // for uint8_t, uint32_t
 
+#include "kaleidoscope/driver/keyboardio/I2CScheduler.h"  // for I2CScheduler, WireI2CTransport
+
 // We allow cRGB/CRGB to be defined already when this is included.
 //
 #ifndef CRGB
@@ -44,6 +46,7 @@ struct cRGB {
 
 #define LEDS_PER_HAND      32
 #define LED_BYTES_PER_BANK sizeof(cRGB) * LEDS_PER_HAND / LED_BANKS
+#define LEDS_PER_BANK      (LEDS_PER_HAND / LED_BANKS)
 
 namespace kaleidoscope {
 namespace driver {
@@ -76,12 +79,31 @@ class Model100Side {
   byte setLEDSPIFrequency(byte frequency);
   int readLEDSPIFrequency();
 
-  void sendLEDData();
+  // Sends the next LED bank that has changed since it was last sent, if any.
+  // Returns `true` if a bank was sent.
+  bool sendLEDData();
+  void markLEDDirty(uint8_t led) {
+    dirty_led_banks_ |= 1 << (led / LEDS_PER_BANK);
+  }
+  void markAllLEDsDirty() {
+    dirty_led_banks_ = (1 << LED_BANKS) - 1;
+  }
+  bool hasDirtyLEDs() const {
+    return dirty_led_banks_ != 0;
+  }
   void setOneLEDTo(byte led, cRGB color);
   void setAllLEDsTo(cRGB color);
   keydata_t getKeyData();
+  // Takes the key data from the last completed read, if there is one, and asks
+  // for the next one. Returns `true` if `getKeyData()` has new data.
   bool readKeys();
 
+  // Runs the scheduled key reads and LED writes of both halves. Called once per
+  // cycle, before `readKeys()`.
+  static void updateBus() {
+    bus_.update();
+  }
+
   LEDData_t ledData;
 
   uint8_t controllerAddress();
@@ -104,9 +126,15 @@ class Model100Side {
   uint16_t unavailable_device_check_countdown_           = 0;
   static const uint16_t UNAVAILABLE_DEVICE_COUNTDOWN_MAX = 0x00FFU;
   byte nextLEDBank                                       = 0;
+  // A bitmap of the LED banks that have changed since they were last sent
+  uint8_t dirty_led_banks_                               = (1 << LED_BANKS) - 1;
   void sendLEDBank(byte bank);
   int readRegister(uint8_t cmd);
   uint8_t writeData(uint8_t *data, uint8_t length);
+
+  // Both halves share the bus; each reads into the slot of its `ad01`.
+  typedef I2CScheduler<WireI2CTransport, 4, 2 * LED_BANKS> Bus;
+  static Bus bus_;
 };
 #endif  // ifndef KALEIDOSCOPE_VIRTUAL_BUILD
 
@@ -88,42 +88,48 @@ void HardwareTestMode::testMatrix() {
   // Reset bad keys from previous tests.
   chatter_data state[Runtime.device().numKeys()] = {{0, 0, 0}};
 
+  while (1) {
+    Runtime.device().readMatrix();
+    updateMatrixTest(state);
+  }
+}
+
+void HardwareTestMode::updateMatrixTest(chatter_data *state) {
   constexpr cRGB red    = CRGB(201, 0, 0);
   constexpr cRGB blue   = CRGB(0, 0, 201);
   constexpr cRGB green  = CRGB(0, 201, 0);
   constexpr cRGB yellow = CRGB(201, 100, 0);
 
-  while (1) {
-    Runtime.device().readMatrix();
-    for (auto key_addr : KeyAddr::all()) {
-      uint8_t keynum = key_addr.toInt();
-
-      // If the key is toggled on
-      if (Runtime.device().isKeyswitchPressed(key_addr) && !Runtime.device().wasKeyswitchPressed(key_addr)) {
-        // And it's too soon (in terms of cycles between changes)
-        state[keynum].tested = 1;
-        if (state[keynum].cyclesSinceStateChange < CHATTER_CYCLE_LIMIT) {
-          state[keynum].bad = 1;
-        }
-        state[keynum].cyclesSinceStateChange = 0;
-      } else if (state[keynum].cyclesSinceStateChange < CHATTER_CYCLE_LIMIT) {
-        state[keynum].cyclesSinceStateChange++;
-      }
-      // If the key is held down
-      if (Runtime.device().isKeyswitchPressed(key_addr) && Runtime.device().wasKeyswitchPressed(key_addr)) {
-        Runtime.device().setCrgbAt(key_addr, green);
-      } else if (state[keynum].bad == 1) {
-        // If we triggered chatter detection ever on this key
-        Runtime.device().setCrgbAt(key_addr, red);
-      } else if (state[keynum].tested == 0) {
-        Runtime.device().setCrgbAt(key_addr, yellow);
-      } else if (!Runtime.device().isKeyswitchPressed(key_addr)) {
-        // If the key is not currently pressed and was not just released and is not marked bad
-        Runtime.device().setCrgbAt(key_addr, blue);
+  for (auto key_addr : KeyAddr::all()) {
+    uint8_t keynum = key_addr.toInt();
+
+    // If the key is toggled on
+    if (Runtime.device().isKeyswitchPressed(key_addr) && !Runtime.device().wasKeyswitchPressed(key_addr)) {
+      // And it's too soon (in terms of cycles between changes)
+      state[keynum].tested = 1;
+      if (state[keynum].cyclesSinceStateChange < CHATTER_CYCLE_LIMIT) {
+        state[keynum].bad = 1;
       }
+      state[keynum].cyclesSinceStateChange = 0;
+    } else if (state[keynum].cyclesSinceStateChange < CHATTER_CYCLE_LIMIT) {
+      state[keynum].cyclesSinceStateChange++;
+    }
+    // The colors go through LEDControl's frame buffer, because that is what
+    // `syncLeds()` writes to the LEDs.
+    // If the key is held down
+    if (Runtime.device().isKeyswitchPressed(key_addr) && Runtime.device().wasKeyswitchPressed(key_addr)) {
+      ::LEDControl.setCrgbAt(key_addr, green);
+    } else if (state[keynum].bad == 1) {
+      // If we triggered chatter detection ever on this key
+      ::LEDControl.setCrgbAt(key_addr, red);
+    } else if (state[keynum].tested == 0) {
+      ::LEDControl.setCrgbAt(key_addr, yellow);
+    } else if (!Runtime.device().isKeyswitchPressed(key_addr)) {
+      // If the key is not currently pressed and was not just released and is not marked bad
+      ::LEDControl.setCrgbAt(key_addr, blue);
     }
-    ::LEDControl.syncLeds();
   }
+  ::LEDControl.syncLeds();
 }
 
 void HardwareTestMode::runTests() {
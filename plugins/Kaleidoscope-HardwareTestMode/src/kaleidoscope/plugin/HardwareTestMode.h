@@ -42,6 +42,11 @@ class HardwareTestMode : public kaleidoscope::Plugin {
   static void runTests();
   static void setActionKey(uint8_t key);
 
+  /// Runs one pass of the matrix test over the last scan of the matrix, and
+  /// shows the result for each key on its LED. `state` holds the chatter data of
+  /// every key between passes.
+  static void updateMatrixTest(chatter_data *state);
+
  private:
   static void testLeds();
   static void testMatrix();
@@ -22,16 +22,17 @@
 
 #include "kaleidoscope/plugin/Heatmap.h"
 
-#include <Arduino.h>  // for pgm_read_byte, PROGMEM
-#include <stdint.h>   // for uint16_t, uint8_t, INT16_MAX
-
-#include "kaleidoscope/KeyAddr.h"               // for MatrixAddr, MatrixAddr<>::Range, KeyAddr
-#include "kaleidoscope/KeyEvent.h"              // for KeyEvent
-#include "kaleidoscope/Runtime.h"               // for Runtime, Runtime_
-#include "kaleidoscope/device/device.h"         // for cRGB
-#include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult, EventHandlerResult::OK
-#include "kaleidoscope/keyswitch_state.h"       // for keyIsInjected, keyToggledOn
-#include "kaleidoscope/plugin/LEDControl.h"     // for LEDControl
+#include <Arduino.h>  // for PROGMEM
+#include <stdint.h>   // for uint16_t, uint8_t, uint32_t, INT16_MAX
+
+#include "kaleidoscope/KeyAddr.h"                      // for MatrixAddr, MatrixAddr<>::Range, KeyAddr
+#include "kaleidoscope/KeyEvent.h"                     // for KeyEvent
+#include "kaleidoscope/Runtime.h"                      // for Runtime, Runtime_
+#include "kaleidoscope/device/device.h"                // for cRGB
+#include "kaleidoscope/event_handler_result.h"         // for EventHandlerResult, EventHandlerResult::OK
+#include "kaleidoscope/keyswitch_state.h"              // for keyIsInjected, keyToggledOn
+#include "kaleidoscope/plugin/LEDControl.h"            // for LEDControl
+#include "kaleidoscope/plugin/LEDControl/ColorMath.h"  // for paletteColors
 
 namespace kaleidoscope {
 namespace plugin {
@@ -50,67 +51,7 @@ uint16_t Heatmap::highest_ = 1;
 uint16_t Heatmap::heatmap_[];
 
 Heatmap::TransientLEDMode::TransientLEDMode(const Heatmap *parent)
-  :  // last heatmap computation time
-    last_heatmap_comp_time_(Runtime.millisAtCycleStart()),
-    parent_(parent) {}
-
-cRGB Heatmap::TransientLEDMode::computeColor(float v) {
-  // compute the color corresponding to a value between 0 and 1
-
-  /*
-   * for exemple, if:
-   *   v=0.8
-   *   heat_colors_lenth=4 (hcl)
-   *   the red components of heat_colors are: 0, 25, 25, 255 (rhc)
-   * the red component returned by computeColor will be: 117
-   *
-   * 255 |                 /
-   *     |                /
-   *     |               /
-   * 117 | - - - - - - -/
-   *     |             /
-   *  25 |      ______/ |
-   *     |   __/
-   *     | _/           |
-   *     |/_________________
-   *     0     1     2  ↑  3
-   *                 ↑ 2.4 ↑
-   *               idx1 |  idx2
-   *                 <—–>
-   *                  fb
-   *
-   * in this exemple, I call red heat_colors: rhc
-   * idx1 = floor(v×(hcl-1)) = floor(0.8×3) = floor(2.4) = 2
-   * idx2 = idx1 + 1 = 3
-   * fb = v×(hcl-1)-idx1 = 0.8×3 - 2 = 0.4
-   * red = (rhc[idx2]-rhc[idx1])×fb + rhc[idx1] = (255-25)×(2.4-2) + 25 = 117
-   */
-
-  float fb = 0;
-  uint8_t idx1, idx2;
-
-  if (v <= 0) {
-    // if v = 0, don't bother computing fb and use heat_colors[0]
-    idx1 = idx2 = 0;
-  } else if (v >= 1) {
-    // if v = 1,
-    // don't bother computing fb and use heat_colors[heat_colors_length-1]
-    idx1 = idx2 = heat_colors_length - 1;
-  } else {
-    float val = v * (heat_colors_length - 1);
-    // static_cast from float to int just drop the decimal part of the number
-    // static_cast<int>(5.9) → 5
-    idx1 = static_cast<int>(val);
-    idx2 = idx1 + 1;
-    fb   = val - static_cast<float>(idx1);
-  }
-
-  uint8_t r = static_cast<uint8_t>((pgm_read_byte(&(heat_colors[idx2].r)) - pgm_read_byte(&(heat_colors[idx1].r))) * fb + pgm_read_byte(&(heat_colors[idx1].r)));
-  uint8_t g = static_cast<uint8_t>((pgm_read_byte(&(heat_colors[idx2].g)) - pgm_read_byte(&(heat_colors[idx1].g))) * fb + pgm_read_byte(&(heat_colors[idx1].g)));
-  uint8_t b = static_cast<uint8_t>((pgm_read_byte(&(heat_colors[idx2].b)) - pgm_read_byte(&(heat_colors[idx1].b))) * fb + pgm_read_byte(&(heat_colors[idx1].b)));
-
-  return {b, g, r};
-}
+  : parent_(parent) {}
 
 void Heatmap::TransientLEDMode::shiftStats() {
   // this method is called when:
@@ -215,34 +156,45 @@ EventHandlerResult Heatmap::TransientLEDMode::beforeEachCycle() {
   return EventHandlerResult::OK;
 }
 
-void Heatmap::TransientLEDMode::update() {
-  if (!Runtime.has_leds)
-    return;
+uint16_t Heatmap::TransientLEDMode::frameInterval() const {
+  // the heatmap is computed once every update_delay milliseconds
+  return update_delay;
+}
 
-  // this methode is called frequently by the LEDControl::loopHook
+uint8_t Heatmap::TransientLEDMode::frameSlices() const {
+  // a division and a gradient lookup for every key is still more than we want
+  // to do in a single cycle, so spread it over the rows
+  return Runtime.device().matrix_rows;
+}
 
-  // do nothing if the update interval hasn't elapsed since the previous update
-  if (!Runtime.hasTimeExpired(last_heatmap_comp_time_, update_delay))
-    return;
-  // do the heatmap computing
-  // (update_delay milliseconds elapsed since last_heatmap_comp_time)
+void Heatmap::TransientLEDMode::updateSlice(uint8_t row) {
+  static constexpr uint8_t cols = Runtime.device().matrix_columns;
 
-  // schedule the next heatmap computing
-  last_heatmap_comp_time_ = Runtime.millisAtCycleStart();
+  if (!Runtime.has_leds)
+    return;
 
-  // for each key
-  for (auto key_addr : KeyAddr::all()) {
-    // how much the key was pressed compared to the others (between 0 and 1)
-    // (total_keys_ can't be equal to 0)
-    float v = static_cast<float>(parent_->heatmap_[key_addr.toInt()]) / parent_->highest_;
-    // we could have used an interger instead of a float, but then we would
-    // have had to change some multiplication in division.
-    // / on uint is slower than * on float, so I stay with the float
-    // https://forum.arduino.cc/index.php?topic=92684.msg2733723#msg2733723
-
-    // set the LED color accordingly
-    ::LEDControl.setCrgbAt(KeyAddr(key_addr), computeColor(v));
+  // this methode is called by LEDControl once per row, one row per cycle,
+  // once update_delay milliseconds elapsed since the previous computation
+
+  // how much each key of the row was pressed compared to the others, between 0
+  // and 255, to pick its color from the heat_colors gradient.
+  //
+  // There's no floating point unit to do this with floats, so we multiply by
+  // the 16.16 fixed point reciprocal of highest_ instead, which only takes a
+  // single division per row (highest_ can't be equal to 0).
+  uint32_t reciprocal = 0xff0000UL / parent_->highest_;
+  uint8_t positions[cols];
+  for (uint8_t col = 0; col < cols; col++) {
+    uint32_t position = (parent_->heatmap_[KeyAddr(row, col).toInt()] * reciprocal) >> 16;
+    positions[col]    = position < 0xff ? position : 0xff;
   }
+
+  cRGB colors[cols];
+  color_math::paletteColors(colors, positions, cols, heat_colors, heat_colors_length);
+
+  // set the LED colors accordingly
+  for (uint8_t col = 0; col < cols; col++)
+    ::LEDControl.setCrgbAt(KeyAddr(row, col), colors[col]);
 }
 
 }  // namespace plugin
@@ -66,14 +66,14 @@ class Heatmap : public Plugin,
     EventHandlerResult beforeEachCycle();
 
    protected:
-    void update() final;
+    uint16_t frameInterval() const final;
+    uint8_t frameSlices() const final;
+    void updateSlice(uint8_t row) final;
 
    private:
-    uint16_t last_heatmap_comp_time_;
     const Heatmap *parent_;
 
     void shiftStats();
-    cRGB computeColor(float v);
 
     friend class Heatmap;
   };
@@ -32,11 +32,10 @@
 namespace kaleidoscope {
 namespace plugin {
 
-EventHandlerResult FocusHostOSCommand::onFocusEvent(const char *input) {
-  const char *cmd = PSTR("hostos.type");
+FOCUS_COMMANDS(FocusHostOSCommand, "hostos.type")
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd);
+EventHandlerResult FocusHostOSCommand::onFocusEvent(const char *input) {
+  const auto cmd = FOCUS_COMMAND("hostos.type");
 
   if (!::Focus.inputMatchesCommand(input, cmd))
     return EventHandlerResult::OK;
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <stdint.h>  // for uint16_t
+
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
 #include "kaleidoscope/plugin.h"                // for Plugin
 
@@ -31,6 +33,7 @@ namespace plugin {
 class FocusHostOSCommand : public kaleidoscope::Plugin {
  public:
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 };
 
 }  // namespace plugin
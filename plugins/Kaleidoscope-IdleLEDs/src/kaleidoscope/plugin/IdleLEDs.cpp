@@ -97,11 +97,10 @@ void PersistentIdleLEDs::setIdleTimeoutSeconds(uint32_t new_limit) {
   Runtime.storage().commit();
 }
 
-EventHandlerResult PersistentIdleLEDs::onFocusEvent(const char *input) {
-  const char *cmd = PSTR("idleleds.time_limit");
+FOCUS_COMMANDS(PersistentIdleLEDs, "idleleds.time_limit")
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd);
+EventHandlerResult PersistentIdleLEDs::onFocusEvent(const char *input) {
+  const auto cmd = FOCUS_COMMAND("idleleds.time_limit");
 
   if (!::Focus.inputMatchesCommand(input, cmd))
     return EventHandlerResult::OK;
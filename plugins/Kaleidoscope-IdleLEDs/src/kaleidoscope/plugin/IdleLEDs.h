@@ -47,6 +47,7 @@ class PersistentIdleLEDs : public IdleLEDs {
   EventHandlerResult onSetup();
   EventHandlerResult onNameQuery();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 
   static void setIdleTimeoutSeconds(uint32_t new_limit);
 
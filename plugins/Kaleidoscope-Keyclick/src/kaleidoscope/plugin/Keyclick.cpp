@@ -61,8 +61,10 @@ EventHandlerResult Keyclick::onKeyswitchEvent(KeyEvent &event) {
   return EventHandlerResult::OK;
 }
 
+FOCUS_COMMANDS(Keyclick, "keyclick.enabled")
+
 EventHandlerResult Keyclick::onFocusEvent(const char *command) {
-  if (::Focus.inputMatchesCommand(command, "keyclick.enabled")) {
+  if (::Focus.inputMatchesCommand(command, FOCUS_COMMAND("keyclick.enabled"))) {
     if (::Focus.isEOL()) {
       ::Focus.send(settings_.enabled);
     } else {
@@ -20,6 +20,7 @@ class Keyclick : public kaleidoscope::Plugin {
   EventHandlerResult onSetup();
   EventHandlerResult onKeyswitchEvent(KeyEvent &event);
   EventHandlerResult onFocusEvent(const char *command);
+  static bool focusCommand(uint16_t hash, const char *command);
   EventHandlerResult onNameQuery();
 
   // Toggle the keyclick feature
@@ -26,7 +26,6 @@
 #include <Kaleidoscope-OneShotMetaKeys.h>  // for OneShot_ActiveStickyKey
 
 #include "kaleidoscope/KeyAddr.h"               // for KeyAddr, MatrixAddr, MatrixAddr<>::Range
-#include "kaleidoscope/KeyAddrBitfield.h"       // for KeyAddrBitfield, KeyAddrBitfield::Iterator
 #include "kaleidoscope/KeyEvent.h"              // for KeyEvent
 #include "kaleidoscope/LiveKeys.h"              // for LiveKeys, live_keys
 #include "kaleidoscope/device/device.h"         // for CRGB, cRGB
@@ -38,13 +37,18 @@
 namespace kaleidoscope {
 namespace plugin {
 
-KeyAddrBitfield ActiveModColorEffect::mod_key_bits_;
 bool ActiveModColorEffect::highlight_normal_modifiers_ = true;
 
 cRGB ActiveModColorEffect::highlight_color_ = CRGB(160, 160, 160);
 cRGB ActiveModColorEffect::oneshot_color_   = CRGB(160, 160, 0);
 cRGB ActiveModColorEffect::sticky_color_    = CRGB(160, 0, 0);
 
+// -----------------------------------------------------------------------------
+EventHandlerResult ActiveModColorEffect::onSetup() {
+  ::LEDControl.addOverlay(*this);
+  return EventHandlerResult::OK;
+}
+
 // -----------------------------------------------------------------------------
 EventHandlerResult ActiveModColorEffect::onKeyEvent(KeyEvent &event) {
 
@@ -60,7 +64,7 @@ EventHandlerResult ActiveModColorEffect::onKeyEvent(KeyEvent &event) {
     if (event.key.isMomentary() ||
         ::OneShot.isOneShotKey(event.key) ||
         ::OneShot.isActive(event.addr)) {
-      mod_key_bits_.set(event.addr);
+      cover(event.addr);
     }
     if (event.key == OneShot_ActiveStickyKey) {
       for (KeyAddr entry_addr : KeyAddr::all()) {
@@ -71,16 +75,15 @@ EventHandlerResult ActiveModColorEffect::onKeyEvent(KeyEvent &event) {
           continue;
         }
         // Highlight everything else
-        mod_key_bits_.set(entry_addr);
+        cover(entry_addr);
       }
     }
   } else {  // if (keyToggledOff(event.state))
     // Things get a bit ugly here because this plugin might come before OneShot
     // in the order, so we can't just count on OneShot stopping the suppressed
     // release event before we see it here.
-    if (mod_key_bits_.read(event.addr) && !::OneShot.isActive(event.addr)) {
-      mod_key_bits_.clear(event.addr);
-      ::LEDControl.refreshAt(event.addr);
+    if (covers(event.addr) && !::OneShot.isActive(event.addr)) {
+      uncover(event.addr);
     }
   }
 
@@ -88,24 +91,23 @@ EventHandlerResult ActiveModColorEffect::onKeyEvent(KeyEvent &event) {
 }
 
 // -----------------------------------------------------------------------------
-EventHandlerResult ActiveModColorEffect::beforeSyncingLeds() {
-
-  // This loop iterates through only the `key_addr`s that have their bits in the
-  // `mod_key_bits_` bitfield set.
-  for (KeyAddr key_addr : mod_key_bits_) {
-    if (::OneShot.isTemporary(key_addr)) {
-      // Temporary OneShot keys get one color:
-      ::LEDControl.setCrgbAt(key_addr, oneshot_color_);
-    } else if (::OneShot.isSticky(key_addr)) {
-      // Sticky OneShot keys get another color:
-      ::LEDControl.setCrgbAt(key_addr, sticky_color_);
-    } else if (highlight_normal_modifiers_) {
-      // Normal modifiers get a third color:
-      ::LEDControl.setCrgbAt(key_addr, highlight_color_);
-    }
+// `LEDControl` calls this once per frame, for each of the keys we covered.
+bool ActiveModColorEffect::overlayColorAt(KeyAddr key_addr, cRGB &color) {
+  if (::OneShot.isTemporary(key_addr)) {
+    // Temporary OneShot keys get one color:
+    color = oneshot_color_;
+  } else if (::OneShot.isSticky(key_addr)) {
+    // Sticky OneShot keys get another color:
+    color = sticky_color_;
+  } else if (highlight_normal_modifiers_) {
+    // Normal modifiers get a third color:
+    color = highlight_color_;
+  } else {
+    // Otherwise, the LED mode's color shows through.
+    return false;
   }
 
-  return EventHandlerResult::OK;
+  return true;
 }
 
 }  // namespace plugin
@@ -22,17 +22,19 @@
 
 #pragma once
 
-#include "kaleidoscope/KeyAddrBitfield.h"       // for KeyAddrBitfield
+#include "kaleidoscope/KeyAddr.h"               // for KeyAddr
 #include "kaleidoscope/KeyEvent.h"              // for KeyEvent
 #include "kaleidoscope/device/device.h"         // for cRGB
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
 #include "kaleidoscope/plugin.h"                // for Plugin
+#include "kaleidoscope/plugin/LEDOverlay.h"     // for LEDOverlay
 
 #define MAX_MODS_PER_LAYER 16
 
 namespace kaleidoscope {
 namespace plugin {
-class ActiveModColorEffect : public kaleidoscope::Plugin {
+class ActiveModColorEffect : public kaleidoscope::Plugin,
+                             public LEDOverlay {
  public:
   static void setHighlightColor(cRGB color) {
     highlight_color_ = color;
@@ -48,12 +50,14 @@ class ActiveModColorEffect : public kaleidoscope::Plugin {
     highlight_normal_modifiers_ = value;
   }
 
+  EventHandlerResult onSetup();
   EventHandlerResult onKeyEvent(KeyEvent &event);
-  EventHandlerResult beforeSyncingLeds();
+
+ protected:
+  bool overlayColorAt(KeyAddr key_addr, cRGB &color) final;
 
  private:
   static bool highlight_normal_modifiers_;
-  static KeyAddrBitfield mod_key_bits_;
 
   static cRGB highlight_color_;
   static cRGB oneshot_color_;
@@ -38,6 +38,19 @@ namespace plugin {
 
 uint16_t LEDPaletteTheme::palette_base_;
 uint8_t LEDPaletteTheme::palette_size_ = 24;
+uint16_t LEDPaletteTheme::upload_pos_;
+uint16_t LEDPaletteTheme::upload_end_;
+uint8_t LEDPaletteTheme::upload_index_;
+cRGB LEDPaletteTheme::upload_color_;
+
+cRGB LEDPaletteTheme::palette_cache_[CACHED_COLORS];
+bool LEDPaletteTheme::palette_cached_;
+uint16_t LEDPaletteTheme::cache_crc_;
+
+#if LED_PALETTE_THEME_CACHED_THEMES
+uint8_t LEDPaletteTheme::theme_cache_[LED_PALETTE_THEME_CACHED_THEMES][THEME_SIZE];
+uint16_t LEDPaletteTheme::cached_themes_[LED_PALETTE_THEME_CACHED_THEMES];
+#endif
 
 void LEDPaletteTheme::reservePalette() {
   if (!palette_base_)
@@ -50,15 +63,100 @@ uint16_t LEDPaletteTheme::reserveThemes(uint8_t max_themes) {
   return ::EEPROMSettings.requestSlice(max_themes * Runtime.device().led_count / 2);
 }
 
+bool LEDPaletteTheme::cacheUsable() {
+  // We only cache anything once EEPROMSettings has sealed the storage layout,
+  // and found it to match the one in storage. Should the CRC ever change, the
+  // layout did too, and nothing we have cached can be trusted.
+  uint16_t crc = ::EEPROMSettings.crc();
+  if (crc != cache_crc_) {
+    flushCache();
+    cache_crc_ = crc;
+  }
+  return cache_crc_ != 0 && ::EEPROMSettings.isValid();
+}
+
+void LEDPaletteTheme::flushCache() {
+  palette_cached_ = false;
+#if LED_PALETTE_THEME_CACHED_THEMES
+  for (uint8_t slot = 0; slot < LED_PALETTE_THEME_CACHED_THEMES; slot++)
+    cached_themes_[slot] = UNCACHED_THEME;
+#endif
+}
+
+const cRGB *LEDPaletteTheme::cachedPalette() {
+  if (palette_cached_)
+    return palette_cache_;
+
+  Runtime.storage().readBlock(palette_base_, palette_cache_, sizeof(palette_cache_));
+  for (uint8_t i = 0; i < CACHED_COLORS; i++) {
+    palette_cache_[i].r ^= 0xff;
+    palette_cache_[i].g ^= 0xff;
+    palette_cache_[i].b ^= 0xff;
+  }
+  // Until the storage layout is sealed, the palette is read again every time
+  palette_cached_ = cacheUsable();
+
+  return palette_cache_;
+}
+
+#if LED_PALETTE_THEME_CACHED_THEMES
+const uint8_t *LEDPaletteTheme::cachedTheme(uint16_t map_base, uint8_t theme) {
+  if (!cacheUsable())
+    return nullptr;
+
+  uint8_t slot = theme % LED_PALETTE_THEME_CACHED_THEMES;
+  if (cached_themes_[slot] != map_base) {
+    Runtime.storage().readBlock(map_base, theme_cache_[slot], THEME_SIZE);
+    cached_themes_[slot] = map_base;
+  }
+  return theme_cache_[slot];
+}
+
+uint8_t *LEDPaletteTheme::cachedIndexes(uint16_t address) {
+  if (!cacheUsable())
+    return nullptr;
+
+  for (uint8_t slot = 0; slot < LED_PALETTE_THEME_CACHED_THEMES; slot++) {
+    if (cached_themes_[slot] != UNCACHED_THEME &&
+        address >= cached_themes_[slot] &&
+        address < cached_themes_[slot] + THEME_SIZE)
+      return &theme_cache_[slot][address - cached_themes_[slot]];
+  }
+  return nullptr;
+}
+#endif
+
 void LEDPaletteTheme::updateHandler(uint16_t theme_base, uint8_t theme) {
   if (!Runtime.has_leds)
     return;
 
-  uint16_t map_base = theme_base + (theme * Runtime.device().led_count / 2);
+  uint16_t map_base   = theme_base + (theme * Runtime.device().led_count / 2);
+  const cRGB *palette = cachedPalette();
+
+#if LED_PALETTE_THEME_CACHED_THEMES
+  // With the theme cached, this is a copy from RAM to the frame buffer.
+  const uint8_t *cached = cachedTheme(map_base, theme);
+  if (cached) {
+    for (uint8_t pos = 0; pos < Runtime.device().led_count; pos++) {
+      uint8_t color_index = (pos % 2) ? cached[pos / 2] & 0x0f : cached[pos / 2] >> 4;
+      ::LEDControl.setCrgbAt(pos, palette[color_index]);
+    }
+    return;
+  }
+#endif
 
+  // Otherwise, the theme is read a block at a time, instead of reading a color
+  // index from storage for every LED.
+  uint8_t indexes[16];
   for (uint8_t pos = 0; pos < Runtime.device().led_count; pos++) {
-    cRGB color = lookupColorAtPosition(map_base, pos);
-    ::LEDControl.setCrgbAt(pos, color);
+    uint8_t i = (pos / 2) % sizeof(indexes);
+    if (pos % 2 == 0 && i == 0) {
+      uint16_t left = (Runtime.device().led_count + 1) / 2 - pos / 2;
+      Runtime.storage().readBlock(map_base + pos / 2, indexes, (left < sizeof(indexes)) ? left : sizeof(indexes));
+    }
+
+    uint8_t color_index = (pos % 2) ? indexes[i] & 0x0f : indexes[i] >> 4;
+    ::LEDControl.setCrgbAt(pos, palette[color_index]);
   }
 }
 
@@ -77,7 +175,12 @@ void LEDPaletteTheme::refreshAt(uint16_t theme_base, uint8_t theme, KeyAddr key_
 const uint8_t LEDPaletteTheme::lookupColorIndexAtPosition(uint16_t map_base, uint16_t position) {
   uint8_t color_index;
 
+#if LED_PALETTE_THEME_CACHED_THEMES
+  const uint8_t *cached = cachedIndexes(map_base + position / 2);
+  color_index           = cached ? *cached : Runtime.storage().read(map_base + position / 2);
+#else
   color_index = Runtime.storage().read(map_base + position / 2);
+#endif
   if (position % 2)
     color_index &= ~0xf0;
   else
@@ -93,6 +196,9 @@ const cRGB LEDPaletteTheme::lookupColorAtPosition(uint16_t map_base, uint16_t po
 }
 
 const cRGB LEDPaletteTheme::lookupPaletteColor(uint8_t color_index) {
+  if (color_index < CACHED_COLORS)
+    return cachedPalette()[color_index];
+
   cRGB color;
 
   Runtime.storage().get(palette_base_ + color_index * sizeof(cRGB), color);
@@ -115,9 +221,18 @@ void LEDPaletteTheme::updateColorIndexAtPosition(uint16_t map_base, uint16_t pos
     indexes       = (color_index << 4) + other;
   }
   Runtime.storage().update(map_base + position / 2, indexes);
+
+#if LED_PALETTE_THEME_CACHED_THEMES
+  uint8_t *cached = cachedIndexes(map_base + position / 2);
+  if (cached)
+    *cached = indexes;
+#endif
 }
 
 void LEDPaletteTheme::updatePaletteColor(uint8_t palette_index, cRGB color) {
+  if (palette_index < CACHED_COLORS)
+    palette_cache_[palette_index] = color;
+
   color.r ^= 0xff;
   color.g ^= 0xff;
   color.b ^= 0xff;
@@ -136,14 +251,13 @@ uint8_t LEDPaletteTheme::getPaletteSize() {
   return LEDPaletteTheme::palette_size_;
 }
 
+FOCUS_COMMANDS(LEDPaletteTheme, "palette")
+
 EventHandlerResult LEDPaletteTheme::onFocusEvent(const char *input) {
   if (!Runtime.has_leds)
     return EventHandlerResult::OK;
 
-  const char *cmd = PSTR("palette");
-
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd);
+  const auto cmd = FOCUS_COMMAND("palette");
 
   if (!::Focus.inputMatchesCommand(input, cmd))
     return EventHandlerResult::OK;
@@ -158,19 +272,73 @@ EventHandlerResult LEDPaletteTheme::onFocusEvent(const char *input) {
     return EventHandlerResult::EVENT_CONSUMED;
   }
 
-  uint8_t i = 0;
-  while (i < palette_size_ && !::Focus.isEOL()) {
-    cRGB color;
+  upload_pos_   = 0;
+  upload_index_ = NO_INDEX;
+  ::Focus.streamArguments(uploadPaletteValue, nullptr, uploadEnd);
+
+  return EventHandlerResult::EVENT_CONSUMED;
+}
+
+void LEDPaletteTheme::uploadPaletteValue(uint16_t value) {
+  // Colors are sent as their red, green and blue components, in this order.
+  uint8_t index = upload_pos_ / 3;
+  if (index >= palette_size_)
+    return;
 
-    ::Focus.read(color);
-    updatePaletteColor(i, color);
-    i++;
+  switch (upload_pos_++ % 3) {
+  case 0:
+    upload_color_.r = value;
+    break;
+  case 1:
+    upload_color_.g = value;
+    break;
+  case 2:
+    upload_color_.b = value;
+    updatePaletteColor(index, upload_color_);
+    break;
   }
-  Runtime.storage().commit();
+}
 
+EventHandlerResult LEDPaletteTheme::onStorageChange() {
+  flushCache();
   ::LEDControl.refreshAll();
+  return EventHandlerResult::OK;
+}
 
-  return EventHandlerResult::EVENT_CONSUMED;
+void LEDPaletteTheme::uploadValue(uint16_t value) {
+  // As text, each index is sent on its own.
+  if (upload_index_ == NO_INDEX) {
+    upload_index_ = value;
+    return;
+  }
+
+  uint8_t b     = (upload_index_ << 4) + value;
+  upload_index_ = NO_INDEX;
+  uploadFrame(&b, 1);
+}
+
+void LEDPaletteTheme::uploadFrame(const uint8_t *data, uint8_t size) {
+  // Binary frames carry the themes as they are stored: two palette indexes
+  // per byte, the first one in the high nibble.
+  if (upload_pos_ >= upload_end_)
+    return;
+
+  if (size > upload_end_ - upload_pos_)
+    size = upload_end_ - upload_pos_;
+  Runtime.storage().writeBlock(upload_pos_, data, size);
+  upload_pos_ += size;
+
+  // The themes are written behind the cache's back
+  flushCache();
+}
+
+void LEDPaletteTheme::uploadEnd() {
+  // An index without a pair is paired with index 0
+  if (upload_index_ != NO_INDEX)
+    uploadValue(0);
+  Runtime.storage().commit();
+
+  ::LEDControl.refreshAll();
 }
 
 EventHandlerResult LEDPaletteTheme::themeFocusEvent(const char *input,
@@ -189,29 +357,23 @@ EventHandlerResult LEDPaletteTheme::themeFocusEvent(const char *input,
   uint16_t max_index = (max_themes * Runtime.device().led_count) / 2;
 
   if (::Focus.isEOL()) {
-    for (uint16_t pos = 0; pos < max_index; pos++) {
-      uint8_t indexes = Runtime.storage().read(theme_base + pos);
+    // The themes are sent through a small buffer, a block at a time.
+    uint8_t buffer[16];
+
+    for (uint16_t pos = 0; pos < max_index; pos += sizeof(buffer)) {
+      uint8_t size = (max_index - pos < sizeof(buffer)) ? max_index - pos : sizeof(buffer);
+      Runtime.storage().readBlock(theme_base + pos, buffer, size);
 
-      ::Focus.send((uint8_t)(indexes >> 4), indexes & ~0xf0);
+      for (uint8_t i = 0; i < size; i++)
+        ::Focus.send((uint8_t)(buffer[i] >> 4), buffer[i] & ~0xf0);
     }
     return EventHandlerResult::EVENT_CONSUMED;
   }
 
-  uint16_t pos = 0;
-
-  while (!::Focus.isEOL() && (pos < max_index)) {
-    uint8_t idx1, idx2;
-    ::Focus.read(idx1);
-    ::Focus.read(idx2);
-
-    uint8_t indexes = (idx1 << 4) + idx2;
-
-    Runtime.storage().update(theme_base + pos, indexes);
-    pos++;
-  }
-  Runtime.storage().commit();
-
-  ::LEDControl.refreshAll();
+  upload_pos_   = theme_base;
+  upload_end_   = theme_base + max_index;
+  upload_index_ = NO_INDEX;
+  ::Focus.streamArguments(uploadValue, uploadFrame, uploadEnd);
 
   return EventHandlerResult::EVENT_CONSUMED;
 }
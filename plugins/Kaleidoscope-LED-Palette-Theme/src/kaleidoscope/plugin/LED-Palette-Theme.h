@@ -25,10 +25,24 @@
 #include <stdint.h>  // for uint16_t, uint8_t
 
 #include "kaleidoscope/KeyAddr.h"               // for KeyAddr
-#include "kaleidoscope/device/device.h"         // for cRGB
+#include "kaleidoscope/device/device.h"         // for cRGB, Device
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
 #include "kaleidoscope/plugin.h"                // for Plugin
 
+// The number of themes LEDPaletteTheme keeps in RAM, as they are stored: two
+// palette indexes per byte, so each one takes half a byte of RAM per LED. With
+// the palette decoded in RAM too, switching to a cached theme (such as on a
+// layer change, with Colormap) reads nothing from storage. A theme is cached in
+// the slot of its number modulo this one, replacing the theme that was there.
+// Set it to 0 to disable the cache entirely.
+#ifndef LED_PALETTE_THEME_CACHED_THEMES
+#if defined(__AVR__)
+#define LED_PALETTE_THEME_CACHED_THEMES 0
+#else
+#define LED_PALETTE_THEME_CACHED_THEMES 4
+#endif
+#endif
+
 namespace kaleidoscope {
 namespace plugin {
 
@@ -47,6 +61,8 @@ class LEDPaletteTheme : public kaleidoscope::Plugin {
   static const cRGB lookupPaletteColor(uint8_t palette_index);
 
   EventHandlerResult onFocusEvent(const char *input);
+  EventHandlerResult onStorageChange();
+  static bool focusCommand(uint16_t hash, const char *command);
   EventHandlerResult themeFocusEvent(const char *input,
                                      const char *expected_input,
                                      uint16_t theme_base,
@@ -55,9 +71,52 @@ class LEDPaletteTheme : public kaleidoscope::Plugin {
 
   static uint8_t getPaletteSize();
 
+  // Drops the cached palette and themes, so that they will be read from storage
+  // again. Code that writes to the palette or the themes without going through
+  // `updatePaletteColor()` or `updateColorIndexAtPosition()` has to call this.
+  static void flushCache();
+
  private:
   static uint16_t palette_base_;
   static uint8_t palette_size_;
+
+  // The first 16 colors of the palette, the ones themes can refer to, decoded.
+  static constexpr uint8_t CACHED_COLORS = 16;
+  static cRGB palette_cache_[CACHED_COLORS];
+  static bool palette_cached_;
+  // The `EEPROMSettings.crc()` the cache was filled with.
+  static uint16_t cache_crc_;
+
+  static bool cacheUsable();
+  static const cRGB *cachedPalette();
+
+#if LED_PALETTE_THEME_CACHED_THEMES
+  static constexpr uint16_t UNCACHED_THEME = 0xffff;
+  static constexpr uint8_t THEME_SIZE       = (kaleidoscope::Device::led_count + 1) / 2;
+
+  // The themes in each cache slot, and where in storage each slot was read from.
+  static uint8_t theme_cache_[LED_PALETTE_THEME_CACHED_THEMES][THEME_SIZE];
+  static uint16_t cached_themes_[LED_PALETTE_THEME_CACHED_THEMES];
+
+  static const uint8_t *cachedTheme(uint16_t map_base, uint8_t theme);
+  static uint8_t *cachedIndexes(uint16_t address);
+#endif
+
+  // The state of a theme upload: where the next byte goes, where the themes
+  // end, and the first of the two indexes of the next byte, if it was sent
+  // already.
+  static constexpr uint8_t NO_INDEX = 0xff;
+  static uint16_t upload_pos_;
+  static uint16_t upload_end_;
+  static uint8_t upload_index_;
+  static void uploadValue(uint16_t value);
+  static void uploadFrame(const uint8_t *data, uint8_t size);
+  static void uploadEnd();
+
+  // A palette upload uses `upload_pos_` to count the color components, and
+  // collects those of the next color here.
+  static cRGB upload_color_;
+  static void uploadPaletteValue(uint16_t value);
 };
 
 }  // namespace plugin
@@ -44,20 +44,26 @@ cRGB StalkerEffect::inactive_color  = (cRGB){
 
 StalkerEffect::TransientLEDMode::TransientLEDMode(const StalkerEffect *parent)
   : parent_(parent),
-    step_start_time_(0),
     map_{} {}
 
-void StalkerEffect::TransientLEDMode::update() {
+uint16_t StalkerEffect::TransientLEDMode::frameInterval() const {
+  return parent_->step_length;
+}
+
+uint8_t StalkerEffect::TransientLEDMode::frameSlices() const {
+  // One row per slice
+  return Runtime.device().matrix_rows;
+}
+
+void StalkerEffect::TransientLEDMode::updateSlice(uint8_t row) {
   if (!Runtime.has_leds)
     return;
 
   if (!parent_->variant)
     return;
 
-  if (!Runtime.hasTimeExpired(step_start_time_, parent_->step_length))
-    return;
-
-  for (auto key_addr : KeyAddr::all()) {
+  for (uint8_t col = 0; col < Runtime.device().matrix_columns; col++) {
+    KeyAddr key_addr(row, col);
     uint8_t step = map_[key_addr.toInt()];
 
     // If key is active (held), set its animation position to the start
@@ -74,8 +80,6 @@ void StalkerEffect::TransientLEDMode::update() {
     if (!map_[key_addr.toInt()])
       ::LEDControl.setCrgbAt(key_addr, parent_->inactive_color);
   }
-
-  step_start_time_ = Runtime.millisAtCycleStart();
 }
 
 namespace stalker {
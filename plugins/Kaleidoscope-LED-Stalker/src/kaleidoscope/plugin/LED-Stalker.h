@@ -64,12 +64,13 @@ class StalkerEffect : public Plugin,
     explicit TransientLEDMode(const StalkerEffect *parent);
 
    protected:
-    void update() final;
+    uint16_t frameInterval() const final;
+    uint8_t frameSlices() const final;
+    void updateSlice(uint8_t row) final;
 
    private:
     const StalkerEffect *parent_;
 
-    uint16_t step_start_time_;
     uint8_t map_[Runtime.device().numKeys()];
 
     friend class StalkerEffect;
@@ -37,6 +37,7 @@ namespace plugin {
 
 #define INTERPOLATE     1    // smoother, slower animation
 #define MS_PER_FRAME    40   // 40 = 25 fps
+#define US_PER_SLICE    1500 // a row of the ripple simulation, and of keys
 #define FRAMES_PER_DROP 120  // max time between raindrops during idle animation
 
 uint16_t WavepoolEffect::idle_timeout = 5000;                         // 5 seconds
@@ -96,24 +97,32 @@ uint8_t WavepoolEffect::TransientLEDMode::wp_rand() {
   return (Runtime.millisAtCycleStart() / MS_PER_FRAME) + pgm_read_byte((const uint8_t *)offset);
 }
 
-void WavepoolEffect::TransientLEDMode::update() {
+uint16_t WavepoolEffect::TransientLEDMode::frameInterval() const {
+  return MS_PER_FRAME;
+}
 
-  // limit the frame rate; one frame every 64 ms
-  static uint8_t prev_time = 0;
-  uint8_t now              = Runtime.millisAtCycleStart() / MS_PER_FRAME;
-  if (now != prev_time) {
-    prev_time = now;
-  } else {
-    return;
-  }
+uint16_t WavepoolEffect::TransientLEDMode::frameBudget() const {
+  return US_PER_SLICE;
+}
+
+uint8_t WavepoolEffect::TransientLEDMode::frameSlices() const {
+  // one row of water per slice, and one row of keys along with it
+  return WP_HGT;
+}
+
+void WavepoolEffect::TransientLEDMode::updateSlice(uint8_t slice) {
+  static constexpr uint8_t rows = Runtime.device().matrix_rows;
+  static constexpr uint8_t cols = Runtime.device().matrix_columns;
+  static_assert(rows <= WP_HGT, "Each slice draws a single row of keys");
+
+  // LEDControl limits the frame rate (see `frameInterval()`), we only count
+  // the frames, to tell the odd ones from the even ones.
+  static uint8_t now = 0;
 
   // rotate the colors over time
   // (side note: it's weird that this is a 16-bit int instead of 8-bit,
   //  but that's what the library function wants)
   static uint8_t current_hue = 0;
-  current_hue++;
-
-  frames_since_event_++;
 
   // needs two pages of height map to do the calculations
   int8_t *newpg = &surface_[page_ ^ 1][0];
@@ -123,112 +132,126 @@ void WavepoolEffect::TransientLEDMode::update() {
   static uint8_t frames_till_next_drop = 0;
   static int8_t prev_x                 = -1;
   static int8_t prev_y                 = -1;
+
+  if (slice == 0) {
+    now++;
+    current_hue++;
+    frames_since_event_++;
+
 #ifdef INTERPOLATE
-  // even frames: water movement and page flipping
-  // odd frames: raindrops and tweening
-  // (this arrangement seems to look best overall)
-  if (((now & 1)) && (idle_timeout > 0)) {
+    // even frames: water movement and page flipping
+    // odd frames: raindrops and tweening
+    // (this arrangement seems to look best overall)
+    if (((now & 1)) && (idle_timeout > 0)) {
 #else
-  if (idle_timeout > 0) {
+    if (idle_timeout > 0) {
 #endif
-    // repeat previous raindrop to give it a slightly better effect
-    if (prev_x >= 0) {
-      raindrop(prev_x, prev_y, oldpg);
-      prev_x = prev_y = -1;
-    }
-    if (frames_since_event_ >= (frames_till_next_drop + (idle_timeout / MS_PER_FRAME))) {
-      frames_till_next_drop = 4 + (wp_rand() % FRAMES_PER_DROP);
-      frames_since_event_   = idle_timeout / MS_PER_FRAME;
+      // repeat previous raindrop to give it a slightly better effect
+      if (prev_x >= 0) {
+        raindrop(prev_x, prev_y, oldpg);
+        prev_x = prev_y = -1;
+      }
+      if (frames_since_event_ >= (frames_till_next_drop + (idle_timeout / MS_PER_FRAME))) {
+        frames_till_next_drop = 4 + (wp_rand() % FRAMES_PER_DROP);
+        frames_since_event_   = idle_timeout / MS_PER_FRAME;
 
-      uint8_t x = wp_rand() % WP_WID;
-      uint8_t y = wp_rand() % WP_HGT;
-      raindrop(x, y, oldpg);
+        uint8_t x = wp_rand() % WP_WID;
+        uint8_t y = wp_rand() % WP_HGT;
+        raindrop(x, y, oldpg);
 
-      prev_x = x;
-      prev_y = y;
+        prev_x = x;
+        prev_y = y;
+      }
     }
   }
 
-  // calculate water movement
+  // calculate water movement, one row per slice: the new page is only ever
+  // computed from the old one, so the rows don't depend on each other
   // (originally skipped edges, but this keyboard is too small for that)
   //for (uint8_t y = 1; y < WP_HGT-1; y++) {
   //  for (uint8_t x = 1; x < WP_WID-1; x++) {
 #ifdef INTERPOLATE
   if (!(now & 1)) {  // even frames only
 #endif
-    for (uint8_t y = 0; y < WP_HGT; y++) {
-      for (uint8_t x = 0; x < WP_WID; x++) {
-        uint8_t offset = (y * WP_WID) + x;
-
-        int16_t value;
-        int8_t offsets[] = {
-          // clang-format off
-          -WP_WID,      WP_WID,
-          -1,           1,
-          -WP_WID - 1,  -WP_WID + 1,
-          WP_WID - 1,   WP_WID + 1
-          // clang-format on
-        };
-        // don't wrap around edges or go out of bounds
-        if (y == 0) {
-          offsets[0] = 0;
-          offsets[4] += WP_WID;
-          offsets[5] += WP_WID;
-        } else if (y == WP_HGT - 1) {
-          offsets[1] = 0;
-          offsets[6] -= WP_WID;
-          offsets[7] -= WP_WID;
-        }
-        if (x == 0) {
-          offsets[2] = 0;
-          offsets[4] += 1;
-          offsets[6] += 1;
-        } else if (x == WP_WID - 1) {
-          offsets[3] = 0;
-          offsets[5] -= 1;
-          offsets[7] -= 1;
-        }
-
-        // add up all samples, divide, subtract prev frame's center
-        int8_t *p;
-        for (p = offsets, value = 0; p < offsets + 8; p++)
-          value += oldpg[offset + (*p)];
-        value = (value >> 2) - newpg[offset];
-
-        // reduce intensity gradually over time
-        newpg[offset] = value - (value >> 3);
+    uint8_t y = slice;
+    for (uint8_t x = 0; x < WP_WID; x++) {
+      uint8_t offset = (y * WP_WID) + x;
+
+      int16_t value;
+      int8_t offsets[] = {
+        // clang-format off
+        -WP_WID,      WP_WID,
+        -1,           1,
+        -WP_WID - 1,  -WP_WID + 1,
+        WP_WID - 1,   WP_WID + 1
+        // clang-format on
+      };
+      // don't wrap around edges or go out of bounds
+      if (y == 0) {
+        offsets[0] = 0;
+        offsets[4] += WP_WID;
+        offsets[5] += WP_WID;
+      } else if (y == WP_HGT - 1) {
+        offsets[1] = 0;
+        offsets[6] -= WP_WID;
+        offsets[7] -= WP_WID;
+      }
+      if (x == 0) {
+        offsets[2] = 0;
+        offsets[4] += 1;
+        offsets[6] += 1;
+      } else if (x == WP_WID - 1) {
+        offsets[3] = 0;
+        offsets[5] -= 1;
+        offsets[7] -= 1;
       }
+
+      // add up all samples, divide, subtract prev frame's center
+      int8_t *p;
+      for (p = offsets, value = 0; p < offsets + 8; p++)
+        value += oldpg[offset + (*p)];
+      value = (value >> 2) - newpg[offset];
+
+      // reduce intensity gradually over time
+      newpg[offset] = value - (value >> 3);
     }
 #ifdef INTERPOLATE
   }
 #endif
 
-  // draw the water on the keys
-  for (auto key_addr : KeyAddr::all()) {
-    int8_t height = oldpg[pgm_read_byte(rc2pos + key_addr.toInt())];
+  // draw the water on the keys of one row; the frame is only shown once all
+  // of them are drawn
+  if (slice < rows) {
+    for (uint8_t col = 0; col < cols; col++) {
+      KeyAddr key_addr(slice, col);
+      int8_t height = oldpg[pgm_read_byte(rc2pos + key_addr.toInt())];
 #ifdef INTERPOLATE
-    if (now & 1) {  // odd frames only
-      // average height with other frame
-      height = ((int16_t)height + newpg[pgm_read_byte(rc2pos + key_addr.toInt())]) >> 1;
-    }
+      if (now & 1) {  // odd frames only
+        // average height with other frame
+        height = ((int16_t)height + newpg[pgm_read_byte(rc2pos + key_addr.toInt())]) >> 1;
+      }
 #endif
 
-    uint8_t intensity  = abs(height) * 2;
-    uint8_t saturation = 0xff - intensity;
-    uint8_t value      = (intensity >= 128) ? 255 : intensity << 1;
-    int16_t hue        = ripple_hue;
+      uint8_t intensity  = abs(height) * 2;
+      uint8_t saturation = 0xff - intensity;
+      uint8_t value      = (intensity >= 128) ? 255 : intensity << 1;
+      int16_t hue        = ripple_hue;
 
-    if (ripple_hue == WavepoolEffect::rainbow_hue) {
-      // color starts white but gets dimmer and more saturated as it fades,
-      // with hue wobbling according to height map
-      hue = (current_hue + height + (height >> 1)) & 0xff;
-    }
+      if (ripple_hue == WavepoolEffect::rainbow_hue) {
+        // color starts white but gets dimmer and more saturated as it fades,
+        // with hue wobbling according to height map
+        hue = (current_hue + height + (height >> 1)) & 0xff;
+      }
 
-    cRGB color = hsvToRgb(hue, saturation, value);
+      cRGB color = hsvToRgb(hue, saturation, value);
 
-    ::LEDControl.setCrgbAt(key_addr, color);
+      ::LEDControl.setCrgbAt(key_addr, color);
+    }
   }
 
+  if (slice < WP_HGT - 1)
+    return;
+
 #ifdef INTERPOLATE
   // swap pages every other frame
   if (!(now & 1)) page_ ^= 1;
@@ -21,7 +21,7 @@
 #if defined(ARDUINO_AVR_MODEL01) || defined(ARDUINO_keyboardio_model_100)
 
 #include <Arduino.h>  // for PROGMEM
-#include <stdint.h>   // for uint8_t, int16_t, int8_t, INT16_MAX
+#include <stdint.h>   // for uint8_t, uint16_t, int16_t, int8_t, INT16_MAX
 
 #include "kaleidoscope/KeyEvent.h"                       // for KeyEvent
 #include "kaleidoscope/Runtime.h"                        // for Runtime, Runtime_
@@ -65,7 +65,10 @@ class WavepoolEffect : public Plugin,
     EventHandlerResult onKeyEvent(KeyEvent &event);
 
    protected:
-    void update() final;
+    void updateSlice(uint8_t slice) final;
+    uint8_t frameSlices() const final;
+    uint16_t frameInterval() const final;
+    uint16_t frameBudget() const final;
 
    private:
     uint8_t frames_since_event_;
@@ -22,7 +22,7 @@
 
 #include "kaleidoscope/plugin/LEDBrightnessConfig.h"
 
-#include <Arduino.h>                       // for PSTR, strcmp_P, F
+#include <Arduino.h>                       // for PSTR, F
 #include <Kaleidoscope-EEPROM-Settings.h>  // for EEPROMSettings
 #include <Kaleidoscope-FocusSerial.h>      // for Focus, FocusSerial
 #include <stdint.h>                        // for uint8_t, uint16_t
@@ -47,13 +47,12 @@ EventHandlerResult LEDBrightnessConfig::onSetup() {
   return EventHandlerResult::OK;
 }
 
-EventHandlerResult LEDBrightnessConfig::onFocusEvent(const char *command) {
-  const char *cmd = PSTR("led.brightness");
+FOCUS_COMMANDS(LEDBrightnessConfig, "led.brightness")
 
-  if (::Focus.inputMatchesHelp(command))
-    return ::Focus.printHelp(cmd);
+EventHandlerResult LEDBrightnessConfig::onFocusEvent(const char *command) {
+  const auto cmd = FOCUS_COMMAND("led.brightness");
 
-  if (strcmp_P(command, cmd) != 0) return EventHandlerResult::OK;
+  if (!::Focus.inputMatchesCommand(command, cmd)) return EventHandlerResult::OK;
 
   if (::Focus.isEOL()) {
     ::Focus.send(settings_.brightness);
@@ -35,6 +35,7 @@ class LEDBrightnessConfig : public kaleidoscope::Plugin {
   EventHandlerResult onSetup();
   EventHandlerResult onNameQuery();
   EventHandlerResult onFocusEvent(const char *command);
+  static bool focusCommand(uint16_t hash, const char *command);
 
  private:
   static uint16_t settings_base_;
@@ -35,10 +35,6 @@ void LEDBreatheEffect::TransientLEDMode::update() {
   if (!Runtime.has_leds)
     return;
 
-  if (!Runtime.hasTimeExpired(last_update_, update_interval_))
-    return;
-  last_update_ += update_interval_;
-
   cRGB color = breath_compute(parent_->hue, parent_->saturation);
   ::LEDControl.set_all_leds_to(color);
 }
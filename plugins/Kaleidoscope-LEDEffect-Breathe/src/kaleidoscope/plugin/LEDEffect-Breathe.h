@@ -22,7 +22,7 @@
 
 #pragma once
 
-#include <stdint.h>  // for uint8_t
+#include <stdint.h>  // for uint8_t, uint16_t
 
 #include "kaleidoscope/plugin.h"                   // for Plugin
 #include "kaleidoscope/plugin/LEDMode.h"           // for LEDMode
@@ -52,12 +52,14 @@ class LEDBreatheEffect : public Plugin,
 
    protected:
     void update() final;
+    uint16_t frameInterval() const final {
+      return update_interval_;
+    }
 
    private:
     const LEDBreatheEffect *parent_;
 
     static constexpr uint8_t update_interval_ = 50;
-    uint8_t last_update_                      = 0;
   };
 };
 
@@ -35,11 +35,6 @@ void LEDChaseEffect::TransientLEDMode::update() {
   if (!Runtime.has_leds)
     return;
 
-  if (!Runtime.hasTimeExpired(last_update_, parent_->update_delay_)) {
-    return;
-  }
-  last_update_ += parent_->update_delay_;
-
   // The red LED is at `pos_`; the blue one follows behind. `direction_` is
   // either +1 or -1; `distance_` is the gap between them.
   uint8_t pos2 = pos_ - (direction_ * parent_->distance_);
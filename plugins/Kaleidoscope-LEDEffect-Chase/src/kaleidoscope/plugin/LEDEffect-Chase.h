@@ -24,7 +24,6 @@
 
 #include <stdint.h>  // for uint8_t, int8_t, uint16_t
 
-#include "kaleidoscope/Runtime.h"                  // for Runtime, Runtime_
 #include "kaleidoscope/plugin.h"                   // for Plugin
 #include "kaleidoscope/plugin/LEDMode.h"           // for LEDMode
 #include "kaleidoscope/plugin/LEDModeInterface.h"  // for LEDModeInterface
@@ -59,17 +58,19 @@ class LEDChaseEffect : public Plugin,
     // members of their parent class. Most LED modes can do without.
     //
     explicit TransientLEDMode(const LEDChaseEffect *parent)
-      : parent_(parent), last_update_(Runtime.millisAtCycleStart()) {}
+      : parent_(parent) {}
 
    protected:
     void update() final;
+    uint16_t frameInterval() const final {
+      return parent_->update_delay_;
+    }
 
    private:
     const LEDChaseEffect *parent_;
 
     uint8_t pos_      = uint8_t(0);
     int8_t direction_ = 1;
-    uint16_t last_update_;
   };
 
  private:
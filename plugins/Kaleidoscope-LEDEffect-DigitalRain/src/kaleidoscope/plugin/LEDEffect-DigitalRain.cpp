@@ -25,39 +25,51 @@
 namespace kaleidoscope {
 namespace plugin {
 
-void LEDDigitalRainEffect::TransientLEDMode::update() {
+uint8_t LEDDigitalRainEffect::TransientLEDMode::frameSlices() const {
+  // One row per slice
+  return Runtime.device().matrix_rows;
+}
+
+void LEDDigitalRainEffect::TransientLEDMode::updateSlice(uint8_t row) {
   static constexpr uint8_t rows = Runtime.device().matrix_rows;
   static constexpr uint8_t cols = Runtime.device().matrix_columns;
 
   uint8_t col;
-  uint8_t row;
 
-  // By how much intensity should each pixel decay,
-  // based on how much time has passed since we last ran?
-  uint8_t decayAmount = 0xff * (Runtime.millisAtCycleStart() - previous_timestamp_) / parent_->decay_ms_;
+  if (row == 0) {
+    // By how much intensity should each pixel decay,
+    // based on how much time has passed since we last ran?
+    decay_amount_ = 0xff * (Runtime.millisAtCycleStart() - previous_timestamp_) / parent_->decay_ms_;
+
+    // Update previous timestamp variable to now
+    // so we can tell how much time has passed next time we run
+    previous_timestamp_ = Runtime.millisAtCycleStart();
+  }
 
   // Decay intensities and possibly make new raindrops
   for (col = 0; col < cols; col++) {
-    for (row = 0; row < rows; row++) {
-      if (row == 0 && just_dropped_ && rand() < RAND_MAX / parent_->new_drop_probability_) {
-        // This is the top row, pixels have just fallen,
-        // and we've decided to make a new raindrop in this column
-        map_[col][row] = 0xff;
-      } else if (map_[col][row] > 0 && map_[col][row] < 0xff) {
-        // Pixel is neither full intensity nor totally dark;
-        // decay it
-        if (map_[col][row] <= decayAmount) {
-          map_[col][row] = 0;
-        } else {
-          map_[col][row] -= decayAmount;
-        }
+    if (row == 0 && just_dropped_ && rand() < RAND_MAX / parent_->new_drop_probability_) {
+      // This is the top row, pixels have just fallen,
+      // and we've decided to make a new raindrop in this column
+      map_[col][row] = 0xff;
+    } else if (map_[col][row] > 0 && map_[col][row] < 0xff) {
+      // Pixel is neither full intensity nor totally dark;
+      // decay it
+      if (map_[col][row] <= decay_amount_) {
+        map_[col][row] = 0;
+      } else {
+        map_[col][row] -= decay_amount_;
       }
-
-      // Set the colour for this pixel
-      ::LEDControl.setCrgbAt(KeyAddr(row, col), get_color_from_intensity_(map_[col][row]));
     }
+
+    // Set the colour for this pixel
+    ::LEDControl.setCrgbAt(KeyAddr(row, col), get_color_from_intensity_(map_[col][row]));
   }
 
+  // The raindrops only fall once every row is painted
+  if (row < rows - 1)
+    return;
+
   // Drop the raindrops one row periodically
   if (Runtime.hasTimeExpired(drop_start_timestamp_, parent_->drop_ms_)) {
     // Remember for next time that this just happened
@@ -90,10 +102,6 @@ void LEDDigitalRainEffect::TransientLEDMode::update() {
   } else {
     just_dropped_ = false;
   }
-
-  // Update previous timestamp variable to now
-  // so we can tell how much time has passed next time we run
-  previous_timestamp_ = Runtime.millisAtCycleStart();
 }
 
 cRGB LEDDigitalRainEffect::TransientLEDMode::get_color_from_intensity_(uint8_t intensity) {
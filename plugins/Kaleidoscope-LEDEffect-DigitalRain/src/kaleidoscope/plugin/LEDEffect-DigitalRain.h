@@ -132,7 +132,8 @@ class LEDDigitalRainEffect : public Plugin,
       : parent_(parent) {}
 
    protected:
-    void update() final;
+    uint8_t frameSlices() const final;
+    void updateSlice(uint8_t row) final;
 
    private:
     /**
@@ -150,6 +151,11 @@ class LEDDigitalRainEffect : public Plugin,
      */
     uint32_t previous_timestamp_ = 0;
 
+    /**
+     * By how much intensity pixels decay in this frame.
+     */
+    uint8_t decay_amount_ = 0;
+
     /**
      * Keep track of whether raindrops fell on the last
      * tick.
@@ -37,13 +37,6 @@ void LEDRainbowEffect::TransientLEDMode::update() {
   if (!Runtime.has_leds)
     return;
 
-  if (!Runtime.hasTimeExpired(rainbow_last_update,
-                              parent_->rainbow_update_delay)) {
-    return;
-  } else {
-    rainbow_last_update += parent_->rainbow_update_delay;
-  }
-
   cRGB rainbow = hsvToRgb(rainbow_hue, rainbow_saturation, parent_->rainbow_value);
 
   rainbow_hue += rainbow_steps;
@@ -68,13 +61,6 @@ void LEDRainbowWaveEffect::TransientLEDMode::update() {
   if (!Runtime.has_leds)
     return;
 
-  if (!Runtime.hasTimeExpired(rainbow_last_update,
-                              parent_->rainbow_update_delay)) {
-    return;
-  } else {
-    rainbow_last_update += parent_->rainbow_update_delay;
-  }
-
   for (auto led_index : Runtime.device().LEDs().all()) {
     uint16_t led_hue = rainbow_hue + 16 * (led_index.offset() / 4);
     // We want led_hue to be capped at 255, but we do not want to clip it to
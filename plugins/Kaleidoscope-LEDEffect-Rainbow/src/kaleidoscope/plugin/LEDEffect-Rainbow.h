@@ -57,14 +57,16 @@ class LEDRainbowEffect : public Plugin,
       : parent_(parent) {}
 
     void update() final;
+    uint16_t frameInterval() const final {
+      return parent_->rainbow_update_delay;
+    }
 
    private:
     const LEDRainbowEffect *parent_;
 
     uint16_t rainbow_hue = 0;  //  stores 0 to 614
 
-    uint8_t rainbow_steps       = 1;  //  number of hues we skip in a 360 range per update
-    uint8_t rainbow_last_update = 0;
+    uint8_t rainbow_steps = 1;  //  number of hues we skip in a 360 range per update
 
     uint8_t rainbow_saturation = 255;
   };
@@ -101,14 +103,16 @@ class LEDRainbowWaveEffect : public Plugin, public LEDModeInterface {
       : parent_(parent) {}
 
     void update() final;
+    uint16_t frameInterval() const final {
+      return parent_->rainbow_update_delay;
+    }
 
    private:
     const LEDRainbowWaveEffect *parent_;
 
     uint16_t rainbow_hue = 0;  //  stores 0 to 614
 
-    uint8_t rainbow_wave_steps  = 1;  //  number of hues we skip in a 360 range per update
-    uint8_t rainbow_last_update = 0;
+    uint8_t rainbow_wave_steps = 1;  //  number of hues we skip in a 360 range per update
 
     uint8_t rainbow_saturation = 255;
   };
@@ -0,0 +1,109 @@
+/* Kaleidoscope-LatencyReport -- Key press to HID report latency histogram
+ * Copyright 2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kaleidoscope/plugin/LatencyReport.h"
+
+#include <Arduino.h>                   // for micros, F, PSTR
+#include <Kaleidoscope-FocusSerial.h>  // for Focus, FocusSerial
+#include <stdint.h>                    // for uint8_t, uint16_t, uint32_t
+
+#include "kaleidoscope/KeyEvent.h"              // for KeyEvent, KeyEventId
+#include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult, EventHandlerResult::OK
+#include "kaleidoscope/keyswitch_state.h"       // for keyToggledOn
+
+namespace kaleidoscope {
+namespace plugin {
+
+EventHandlerResult LatencyReport::onNameQuery() {
+  return ::Focus.sendName(F("LatencyReport"));
+}
+
+// -----------------------------------------------------------------------------
+EventHandlerResult LatencyReport::onKeyswitchEvent(KeyEvent &event) {
+  if (!keyToggledOn(event.state))
+    return EventHandlerResult::OK;
+
+  // Plugins that delay events (like Qukeys, TapDance or Chord) send them
+  // through here again when they release them, with their original ids. Only
+  // the first time counts, so that the time spent in those queues is included
+  // in the latency.
+  if (KeyEventId(event.id() - last_id_) <= 0)
+    return EventHandlerResult::OK;
+  last_id_ = event.id();
+
+  uint8_t slot         = event.id() & (max_pending - 1);
+  pending_id_[slot]    = event.id();
+  pending_start_[slot] = micros();
+  pending_ |= 1 << slot;
+
+  return EventHandlerResult::OK;
+}
+
+EventHandlerResult LatencyReport::afterReportingState(const KeyEvent &event) {
+  if (!keyToggledOn(event.state))
+    return EventHandlerResult::OK;
+
+  uint8_t slot = event.id() & (max_pending - 1);
+  if ((pending_ & (1 << slot)) && pending_id_[slot] == event.id()) {
+    record(micros() - pending_start_[slot]);
+    pending_ &= ~(1 << slot);
+  }
+
+  return EventHandlerResult::OK;
+}
+
+void LatencyReport::record(uint32_t latency) {
+  uint8_t i = 0;
+  while (i < bucket_count - 1 && latency >= bucketStart(i + 1))
+    ++i;
+  if (histogram_[i] < UINT16_MAX)
+    ++histogram_[i];
+}
+
+void LatencyReport::reset() {
+  for (uint8_t i = 0; i < bucket_count; ++i)
+    histogram_[i] = 0;
+}
+
+// -----------------------------------------------------------------------------
+FOCUS_COMMANDS(LatencyReport, "latency.histogram", "latency.reset")
+
+EventHandlerResult LatencyReport::onFocusEvent(const char *input) {
+  const auto cmd_histogram = FOCUS_COMMAND("latency.histogram");
+  const auto cmd_reset     = FOCUS_COMMAND("latency.reset");
+
+  if (::Focus.inputMatchesCommand(input, cmd_histogram)) {
+    for (uint8_t i = 0; i < bucket_count; ++i)
+      ::Focus.send(bucketStart(i), histogram_[i], Focus.NEWLINE);
+  } else if (::Focus.inputMatchesCommand(input, cmd_reset)) {
+    reset();
+  } else {
+    return EventHandlerResult::OK;
+  }
+
+  return EventHandlerResult::EVENT_CONSUMED;
+}
+
+}  // namespace plugin
+}  // namespace kaleidoscope
+
+kaleidoscope::plugin::LatencyReport LatencyReport;
@@ -0,0 +1,83 @@
+/* Kaleidoscope-LatencyReport -- Key press to HID report latency histogram
+ * Copyright 2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>  // for uint8_t, uint16_t, uint32_t
+
+#include "kaleidoscope/KeyEvent.h"              // for KeyEvent, KeyEventId
+#include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
+#include "kaleidoscope/plugin.h"                // for Plugin
+
+namespace kaleidoscope {
+namespace plugin {
+
+class LatencyReport : public kaleidoscope::Plugin {
+ public:
+  // The first bucket holds latencies shorter than `first_bucket_limit`
+  // microseconds, and each following bucket covers twice the range of the one
+  // before it, except for the last, which holds everything that didn't fit in
+  // the others.
+  static constexpr uint8_t bucket_count        = 12;
+  static constexpr uint16_t first_bucket_limit = 500;
+
+  EventHandlerResult onNameQuery();
+  EventHandlerResult onKeyswitchEvent(KeyEvent &event);
+  EventHandlerResult afterReportingState(const KeyEvent &event);
+  EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
+
+  /// Returns the number of key presses whose latency fell into bucket `i`.
+  uint16_t bucket(uint8_t i) const {
+    return histogram_[i];
+  }
+
+  /// Returns the lowest latency (in microseconds) that falls into bucket `i`.
+  static uint32_t bucketStart(uint8_t i) {
+    return i == 0 ? 0 : uint32_t(first_bucket_limit) << (i - 1);
+  }
+
+  /// Clears the histogram.
+  void reset();
+
+ private:
+  // The number of presses that can be waiting for a report at the same time.
+  // Presses that wait longer than it takes for this many more to arrive (while
+  // a plugin holds them in a queue, for example) are dropped from the
+  // statistics. Must be a power of two.
+  static constexpr uint8_t max_pending = 8;
+
+  uint16_t histogram_[bucket_count] = {};
+
+  // The time each pending press was first seen, indexed by its event id.
+  uint32_t pending_start_[max_pending] = {};
+  KeyEventId pending_id_[max_pending]  = {};
+  uint8_t pending_                     = 0;
+  KeyEventId last_id_                  = 0;
+
+  void record(uint32_t latency);
+};
+
+}  // namespace plugin
+}  // namespace kaleidoscope
+
+extern kaleidoscope::plugin::LatencyReport LatencyReport;
@@ -32,19 +32,30 @@ EventHandlerResult LayerFocus::onNameQuery() {
   return ::Focus.sendName(F("LayerFocus"));
 }
 
-EventHandlerResult LayerFocus::onFocusEvent(const char *input) {
-  const char *cmd_activate   = PSTR("layer.activate");
-  const char *cmd_deactivate = PSTR("layer.deactivate");
-  const char *cmd_isActive   = PSTR("layer.isActive");
-  const char *cmd_moveTo     = PSTR("layer.moveTo");
-  const char *cmd_state      = PSTR("layer.state");
+uint8_t LayerFocus::upload_layer_;
+
+void LayerFocus::uploadState(uint16_t value) {
+  if (upload_layer_ >= 32)
+    return;
+
+  if (value)
+    ::Layer.activate(upload_layer_);
+  upload_layer_++;
+}
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_activate,
-                             cmd_deactivate,
-                             cmd_isActive,
-                             cmd_moveTo,
-                             cmd_state);
+FOCUS_COMMANDS(LayerFocus,
+               "layer.activate",
+               "layer.deactivate",
+               "layer.isActive",
+               "layer.moveTo",
+               "layer.state")
+
+EventHandlerResult LayerFocus::onFocusEvent(const char *input) {
+  const auto cmd_activate   = FOCUS_COMMAND("layer.activate");
+  const auto cmd_deactivate = FOCUS_COMMAND("layer.deactivate");
+  const auto cmd_isActive   = FOCUS_COMMAND("layer.isActive");
+  const auto cmd_moveTo     = FOCUS_COMMAND("layer.moveTo");
+  const auto cmd_state      = FOCUS_COMMAND("layer.state");
 
   if (::Focus.inputMatchesCommand(input, cmd_activate)) {
     if (!::Focus.isEOL()) {
@@ -79,12 +90,8 @@ EventHandlerResult LayerFocus::onFocusEvent(const char *input) {
       ::Layer.move(0);
       ::Layer.deactivate(0);
 
-      for (uint8_t i = 0; i < 32 && !::Focus.isEOL(); i++) {
-        uint8_t b;
-        ::Focus.read(b);
-        if (b)
-          ::Layer.activate(i);
-      }
+      upload_layer_ = 0;
+      ::Focus.streamArguments(uploadState, nullptr, nullptr);
     }
   } else {
     return EventHandlerResult::OK;
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <stdint.h>  // for uint16_t, uint8_t
+
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
 #include "kaleidoscope/plugin.h"                // for Plugin
 
@@ -28,6 +30,12 @@ class LayerFocus : public kaleidoscope::Plugin {
  public:
   EventHandlerResult onNameQuery();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
+
+ private:
+  // The layer the next value of a `layer.state` upload is for.
+  static uint8_t upload_layer_;
+  static void uploadState(uint16_t value);
 };
 
 }  // namespace plugin
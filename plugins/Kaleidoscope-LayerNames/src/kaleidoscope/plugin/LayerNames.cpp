@@ -37,11 +37,55 @@ EventHandlerResult LayerNames::onNameQuery() {
   return ::Focus.sendName(F("LayerNames"));
 }
 
-EventHandlerResult LayerNames::onFocusEvent(const char *input) {
-  const char *cmd_layerNames = PSTR("keymap.layerNames");
+uint16_t LayerNames::upload_pos_;
+uint8_t LayerNames::upload_left_;
+uint8_t LayerNames::upload_size_;
+bool LayerNames::has_upload_size_;
+
+void LayerNames::uploadChar(char c) {
+  if (upload_pos_ >= ::LayerNames.storage_size_)
+    return;
+
+  if (upload_left_) {
+    Runtime.storage().update(::LayerNames.storage_base_ + upload_pos_++, c);
+    upload_left_--;
+    return;
+  }
+
+  // Each name is preceded by its size, and a space.
+  if (c >= '0' && c <= '9') {
+    upload_size_     = upload_size_ * 10 + c - '0';
+    has_upload_size_ = true;
+    return;
+  }
+  if (has_upload_size_)
+    uploadSize();
+}
+
+void LayerNames::uploadSize() {
+  Runtime.storage().update(::LayerNames.storage_base_ + upload_pos_++, upload_size_);
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_layerNames);
+  // An empty name ends the list
+  if (upload_size_ == 0 ||
+      upload_size_ == ::EEPROMSettings.EEPROM_UNINITIALIZED_BYTE)
+    upload_pos_ = ::LayerNames.storage_size_;
+  else
+    upload_left_ = upload_size_;
+
+  upload_size_     = 0;
+  has_upload_size_ = false;
+}
+
+void LayerNames::uploadEnd() {
+  if (has_upload_size_ && upload_pos_ < ::LayerNames.storage_size_)
+    uploadSize();
+  Runtime.storage().commit();
+}
+
+FOCUS_COMMANDS(LayerNames, "keymap.layerNames")
+
+EventHandlerResult LayerNames::onFocusEvent(const char *input) {
+  const auto cmd_layerNames = FOCUS_COMMAND("keymap.layerNames");
 
   if (!::Focus.inputMatchesCommand(input, cmd_layerNames))
     return EventHandlerResult::OK;
@@ -63,30 +107,11 @@ EventHandlerResult LayerNames::onFocusEvent(const char *input) {
     }
     ::Focus.sendRaw(0, ::Focus.SEPARATOR, F("size="), storage_size_);
   } else {
-    uint16_t pos = 0;
-
-    while (pos < storage_size_ && !::Focus.isEOL()) {
-      uint8_t name_size;
-      ::Focus.read(name_size);
-
-      // size is followed by a space, ignore that.
-      char spc;
-      ::Focus.read(spc);
-
-      Runtime.storage().update(storage_base_ + pos++, name_size);
-
-      if (name_size == 0 ||
-          name_size == ::EEPROMSettings.EEPROM_UNINITIALIZED_BYTE)
-        break;
-
-      for (uint8_t i = 0; i < name_size; i++) {
-        char c;
-        ::Focus.read(c);
-
-        Runtime.storage().update(storage_base_ + pos++, c);
-      }
-    }
-    Runtime.storage().commit();
+    upload_pos_      = 0;
+    upload_left_     = 0;
+    upload_size_     = 0;
+    has_upload_size_ = false;
+    ::Focus.streamCharacters(uploadChar, uploadEnd);
   }
 
   return EventHandlerResult::EVENT_CONSUMED;
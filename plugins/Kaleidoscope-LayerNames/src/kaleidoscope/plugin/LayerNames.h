@@ -34,12 +34,24 @@ class LayerNames : public kaleidoscope::Plugin {
  public:
   EventHandlerResult onNameQuery();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 
   void reserve_storage(uint16_t size);
 
  private:
   uint16_t storage_base_;
   uint16_t storage_size_;
+
+  // The state of a `keymap.layerNames` upload: where the next byte goes, how
+  // many characters of the current name are left, and the size of the next
+  // one, while it's being received.
+  static uint16_t upload_pos_;
+  static uint8_t upload_left_;
+  static uint8_t upload_size_;
+  static bool has_upload_size_;
+  static void uploadChar(char c);
+  static void uploadSize();
+  static void uploadEnd();
 };
 
 }  // namespace plugin
@@ -259,6 +259,7 @@ class LongPressConfig : public Plugin {
  public:
   EventHandlerResult onSetup();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
   void disableLongPressIfUnconfigured();
 
  private:
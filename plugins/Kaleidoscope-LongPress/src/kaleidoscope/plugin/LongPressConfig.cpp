@@ -47,6 +47,11 @@ void LongPressConfig::disableLongPressIfUnconfigured() {
     ::LongPress.disable();
 }
 
+FOCUS_COMMANDS(LongPressConfig,
+               "longpress.enabled",
+               "longpress.timeout",
+               "longpress.autoshift")
+
 EventHandlerResult LongPressConfig::onFocusEvent(const char *input) {
   enum {
     ENABLED,
@@ -54,12 +59,9 @@ EventHandlerResult LongPressConfig::onFocusEvent(const char *input) {
     AUTOSHIFT,
   } subCommand;
 
-  const char *cmd_enabled   = PSTR("longpress.enabled");
-  const char *cmd_timeout   = PSTR("longpress.timeout");
-  const char *cmd_autoshift = PSTR("longpress.autoshift");
-
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_enabled, cmd_timeout, cmd_autoshift);
+  const auto cmd_enabled   = FOCUS_COMMAND("longpress.enabled");
+  const auto cmd_timeout   = FOCUS_COMMAND("longpress.timeout");
+  const auto cmd_autoshift = FOCUS_COMMAND("longpress.autoshift");
 
   if (::Focus.inputMatchesCommand(input, cmd_enabled))
     subCommand = ENABLED;
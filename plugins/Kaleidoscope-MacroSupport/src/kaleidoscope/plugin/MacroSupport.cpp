@@ -22,16 +22,21 @@
 
 #include "kaleidoscope/plugin/MacroSupport.h"
 
-#include <Arduino.h>                   // for F, __FlashStringHelper
+#include <Arduino.h>                   // for F, __FlashStringHelper, delay, pgm_read_byte
 #include <Kaleidoscope-FocusSerial.h>  // for Focus, FocusSerial
-#include <stdint.h>                    // for uint8_t
+#include <stdint.h>                    // for uint8_t, uint16_t, uintptr_t
 
 #include "kaleidoscope/KeyAddr.h"               // for KeyAddr
 #include "kaleidoscope/KeyEvent.h"              // for KeyEvent
+#include "kaleidoscope/LiveKeys.h"              // for live_keys, LiveKeys
 #include "kaleidoscope/Runtime.h"               // for Runtime, Runtime_
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult, EventHandlerResult::OK
 #include "kaleidoscope/key_defs.h"              // for Key, Key_NoKey
 #include "kaleidoscope/keyswitch_state.h"       // for INJECTED, IS_PRESSED, WAS_PRESSED
+// MacroSupport doesn't depend on the Macros plugin itself; it's just using the
+// same macro step definitions to play sequences on behalf of Macros and
+// DynamicMacros.
+#include "kaleidoscope/plugin/Macros/MacroSteps.h"  // for MACRO_ACTION_END, MACRO_ACTION_STEP_...
 
 // =============================================================================
 // `Macros` plugin code
@@ -41,6 +46,22 @@ namespace plugin {
 constexpr uint8_t press_state   = IS_PRESSED | INJECTED;
 constexpr uint8_t release_state = WAS_PRESSED | INJECTED;
 
+// Because some HID implementations coalesce reports sent within a short period
+// of time, we need to insert a small delay between programmatic press and
+// release events. In particular, Windows BLE HID can turn a press and release
+// inside the same transmission interval into a no-op, causing dropped
+// keystrokes.
+constexpr uint16_t tap_delay = 25;
+
+// -----------------------------------------------------------------------------
+uint8_t MacroCursor::read() {
+  if (!in_storage)
+    return pgm_read_byte(reinterpret_cast<const uint8_t *>(pos++));
+  if (pos >= end)
+    return MACRO_ACTION_END;
+  return Runtime.storage().read(pos++);
+}
+
 // -----------------------------------------------------------------------------
 // Public helper functions
 
@@ -59,9 +80,11 @@ void MacroSupport::press(Key key) {
 void MacroSupport::release(Key key) {
   // Before sending the release event, we need to remove the key from the active
   // macro keys array, or it will get inserted into the report anyway.
-  for (Key &macro_key : active_macro_keys_) {
-    if (macro_key == key) {
-      macro_key = Key_NoKey;
+  for (uint8_t i = 0; i < MAX_CONCURRENT_MACRO_KEYS; ++i) {
+    if (active_macro_keys_[i] == key) {
+      active_macro_keys_[i] = Key_NoKey;
+      if (i < 8)
+        latched_slots_ &= ~(1 << i);
     }
   }
   Runtime.handleKeyEvent(KeyEvent{KeyAddr::none(), release_state, key});
@@ -75,6 +98,7 @@ void MacroSupport::clear() {
     Runtime.handleKeyEvent(KeyEvent{KeyAddr::none(), release_state, macro_key});
     macro_key = Key_NoKey;
   }
+  latched_slots_ = 0;
 }
 
 void MacroSupport::tap(Key key) const {
@@ -82,16 +106,203 @@ void MacroSupport::tap(Key key) const {
   // releasing the key after pressing it. It is possible for some other plugin
   // to insert an event in between, but very unlikely.
   Runtime.handleKeyEvent(KeyEvent{KeyAddr::none(), press_state, key});
-  // Because some HID implementations coalesce reports sent within a short
-  // period of time, we need to insert a small delay between programmatic press and
-  // release events.
-  // In particular, Windows BLE HID can turn a press and release inside the same
-  // transmission interval into a no-op, causing dropped keystrokes.
-
-  delay(25);
+  delay(tap_delay);
   Runtime.handleKeyEvent(KeyEvent{KeyAddr::none(), release_state, key});
 }
 
+bool MacroSupport::playFromProgmem(const uint8_t *sequence) {
+  return enqueue(MacroCursor{reinterpret_cast<uintptr_t>(sequence), 0, false});
+}
+
+bool MacroSupport::playFromStorage(uint16_t start, uint16_t end) {
+  return enqueue(MacroCursor{start, end, true});
+}
+
+void MacroSupport::clearWhenIdle() {
+  if (playing_) {
+    clear_when_idle_ = true;
+  } else {
+    clear();
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Macro sequence playback
+
+bool MacroSupport::enqueue(const MacroCursor &cursor) {
+  if (!playing_) {
+    start(cursor);
+    advance();
+    return true;
+  }
+  // A sequence is already in progress (possibly one that triggered this
+  // request), so this one has to wait its turn.
+  if (queue_count_ == MAX_QUEUED_MACROS)
+    return false;
+  queue_[(queue_head_ + queue_count_) % MAX_QUEUED_MACROS] = cursor;
+  ++queue_count_;
+  return true;
+}
+
+void MacroSupport::start(const MacroCursor &cursor) {
+  cursor_          = cursor;
+  interval_        = 0;
+  sequence_        = 0;
+  pending_release_ = Key_NoKey;
+  playing_         = true;
+  wait(0);
+  latchModifiers();
+}
+
+// Any modifiers that are active when a sequence starts would have applied to
+// all of it if it were played in a single cycle, as it used to be. Some of
+// them won't stay active that long (e.g. a OneShot modifier gets released as
+// soon as the Macros key's event is done), so we hold them in the active macro
+// keys array until the sequence ends. Modifiers whose keys are still
+// physically held are left alone: they stay active for as long as they're
+// held, and releasing them should take effect right away.
+void MacroSupport::latchModifiers() {
+  for (KeyAddr key_addr : live_keys.activeAddrs()) {
+    Key key = live_keys[key_addr];
+    if (!key.isKeyboardModifier() ||
+        Runtime.device().isKeyswitchPressed(key_addr))
+      continue;
+    for (uint8_t i = 0; i < MAX_CONCURRENT_MACRO_KEYS && i < 8; ++i) {
+      if (active_macro_keys_[i] == Key_NoKey) {
+        active_macro_keys_[i] = key;
+        latched_slots_ |= 1 << i;
+        break;
+      }
+    }
+  }
+}
+
+void MacroSupport::releaseLatchedModifiers() {
+  for (uint8_t i = 0; latched_slots_ != 0; ++i) {
+    if (latched_slots_ & (1 << i))
+      release(active_macro_keys_[i]);
+  }
+}
+
+void MacroSupport::finish() {
+  releaseLatchedModifiers();
+  if (queue_count_ != 0) {
+    start(queue_[queue_head_]);
+    queue_head_ = (queue_head_ + 1) % MAX_QUEUED_MACROS;
+    --queue_count_;
+    return;
+  }
+  playing_ = false;
+  if (clear_when_idle_) {
+    clear_when_idle_ = false;
+    clear();
+  }
+}
+
+void MacroSupport::wait(uint16_t ms) {
+  wait_start_ = Runtime.millisAtCycleStart();
+  wait_time_  = ms;
+}
+
+// The key is held in the active macro keys array until it's released, so that
+// any other reports sent in the meantime don't release it early.
+void MacroSupport::beginTap(Key key) {
+  press(key);
+  pending_release_ = key;
+  wait(tap_delay);
+}
+
+// Play steps of the current sequence (and any queued after it) until one of
+// them has to wait for a later cycle.
+void MacroSupport::advance() {
+  while (playing_) {
+    if (!Runtime.hasTimeExpired(wait_start_, wait_time_))
+      return;
+
+    if (pending_release_ != Key_NoKey) {
+      Key key          = pending_release_;
+      pending_release_ = Key_NoKey;
+      release(key);
+      wait(interval_);
+      continue;
+    }
+
+    step();
+  }
+}
+
+// Play a single step of the current sequence. Every step is followed by a wait
+// of `interval_` milliseconds, including each tap in a `SEQ()` step.
+void MacroSupport::step() {
+  Key key = Key_NoKey;
+
+  if (sequence_ != 0) {
+    if (sequence_ == MACRO_ACTION_STEP_TAP_SEQUENCE)
+      key.setFlags(cursor_.read());
+    key.setKeyCode(cursor_.read());
+    if (key == Key_NoKey) {
+      sequence_ = 0;
+      wait(interval_);
+    } else {
+      beginTap(key);
+    }
+    return;
+  }
+
+  macro_t macro = cursor_.read();
+  switch (macro) {
+  // These are unlikely to be useful now that we have KeyEvent. I think the
+  // whole `explicit_report` came about as a result of scan-order bugs.
+  case MACRO_ACTION_STEP_EXPLICIT_REPORT:
+  case MACRO_ACTION_STEP_IMPLICIT_REPORT:
+  case MACRO_ACTION_STEP_SEND_REPORT:
+    break;
+  // End legacy macro step commands
+
+  // Timing
+  case MACRO_ACTION_STEP_INTERVAL:
+    interval_ = cursor_.read();
+    break;
+  case MACRO_ACTION_STEP_WAIT:
+    wait(cursor_.read() + interval_);
+    return;
+
+  case MACRO_ACTION_STEP_KEYDOWN:
+  case MACRO_ACTION_STEP_KEYUP:
+  case MACRO_ACTION_STEP_TAP:
+    key.setFlags(cursor_.read());
+    // Keycode variants of actions don't have flags to set.
+    // fall through
+  case MACRO_ACTION_STEP_KEYCODEDOWN:
+  case MACRO_ACTION_STEP_KEYCODEUP:
+  case MACRO_ACTION_STEP_TAPCODE:
+    key.setKeyCode(cursor_.read());
+    if (macro == MACRO_ACTION_STEP_KEYDOWN || macro == MACRO_ACTION_STEP_KEYCODEDOWN) {
+      press(key);
+    } else if (macro == MACRO_ACTION_STEP_KEYUP || macro == MACRO_ACTION_STEP_KEYCODEUP) {
+      release(key);
+    } else {
+      beginTap(key);
+      return;
+    }
+    break;
+
+  case MACRO_ACTION_STEP_TAP_SEQUENCE:
+  case MACRO_ACTION_STEP_TAP_CODE_SEQUENCE:
+    // The keys of the sequence are read and tapped one at a time by subsequent
+    // calls.
+    sequence_ = macro;
+    return;
+
+  case MACRO_ACTION_END:
+  default:
+    finish();
+    return;
+  }
+
+  wait(interval_);
+}
+
 // -----------------------------------------------------------------------------
 // Event handlers
 
@@ -108,6 +319,17 @@ EventHandlerResult MacroSupport::beforeReportingState(const KeyEvent &event) {
   return EventHandlerResult::OK;
 }
 
+EventHandlerResult MacroSupport::afterEachCycle() {
+  // Both Macros and DynamicMacros forward this hook, so it may get called more
+  // than once per cycle. Playback only moves on when the cycle start time does,
+  // so there is nothing to do until then.
+  if (Runtime.millisAtCycleStart() == advanced_at_)
+    return EventHandlerResult::OK;
+  advanced_at_ = Runtime.millisAtCycleStart();
+  advance();
+  return EventHandlerResult::OK;
+}
+
 EventHandlerResult MacroSupport::onNameQuery() {
   return ::Focus.sendName(F("MacroSupport"));
 }
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <stdint.h>  // for uint8_t, uint16_t, uintptr_t
+
 #include "kaleidoscope/KeyEvent.h"              // for KeyEvent
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
 #include "kaleidoscope/key_defs.h"              // for Key
@@ -36,9 +38,29 @@
 #define MAX_CONCURRENT_MACRO_KEYS 8
 #endif
 
+// The number of macro sequences that can be waiting to play while another one
+// is in progress. Sequences requested while the queue is full are dropped.
+#if !defined(MAX_QUEUED_MACROS)
+#define MAX_QUEUED_MACROS 4
+#endif
+
 namespace kaleidoscope {
 namespace plugin {
 
+/// A position in a macro sequence, stored either in PROGMEM (as used by the
+/// Macros plugin) or in `Runtime.storage()` (as used by DynamicMacros).
+struct MacroCursor {
+  uintptr_t pos;
+  // The end of the storage range; sequences in PROGMEM are only terminated by
+  // `MACRO_ACTION_END`.
+  uint16_t end;
+  bool in_storage;
+
+  /// Read the next byte of the sequence, advancing the cursor. Reading past
+  /// the end of a storage range returns `MACRO_ACTION_END`.
+  uint8_t read();
+};
+
 class MacroSupport : public Plugin {
  public:
   /// Send a key press event from a Macro
@@ -68,14 +90,76 @@ class MacroSupport : public Plugin {
   /// specified `key`, passing both in sequence to `Runtime.handleKeyEvent()`.
   void tap(Key key) const;
 
+  /// Queue a macro sequence stored in PROGMEM for playback
+  ///
+  /// The sequence starts playing immediately if no other sequence is in
+  /// progress, and runs until its first non-zero delay. The remaining steps
+  /// are played from `afterEachCycle()` as their delays expire, so key events
+  /// from the keyboard keep being processed in the meantime. Returns `false` if
+  /// the queue is full and the sequence was dropped.
+  bool playFromProgmem(const uint8_t *sequence);
+
+  /// Queue a macro sequence stored in `Runtime.storage()` for playback
+  ///
+  /// Like `playFromProgmem()`, but the sequence is read from storage, starting
+  /// at `start`, and stops at `end` if no `MACRO_ACTION_END` is found first.
+  bool playFromStorage(uint16_t start, uint16_t end);
+
+  /// Returns `true` if a macro sequence is playing or waiting to play.
+  bool isPlaying() const {
+    return playing_;
+  }
+
+  /// Clear all virtual keys held by Macros once playback is finished
+  ///
+  /// If no macro sequence is playing, this is the same as `clear()`. Otherwise,
+  /// the active macro keys array is cleared after the last queued sequence
+  /// ends, so that a macro key released before its sequence has finished
+  /// doesn't cut it short.
+  void clearWhenIdle();
+
   // ---------------------------------------------------------------------------
   // Event handlers
   EventHandlerResult onNameQuery();
   EventHandlerResult beforeReportingState(const KeyEvent &event);
+  EventHandlerResult afterEachCycle();
 
  private:
   // An array of key values that are active while a macro sequence is playing
   Key active_macro_keys_[MAX_CONCURRENT_MACRO_KEYS];
+  // A bitmap of the slots in the first eight entries of `active_macro_keys_`
+  // that hold modifiers latched by `latchModifiers()`.
+  uint8_t latched_slots_ = 0;
+
+  // The sequence currently being played, and the ones waiting to follow it.
+  MacroCursor cursor_;
+  MacroCursor queue_[MAX_QUEUED_MACROS];
+  uint8_t queue_head_  = 0;
+  uint8_t queue_count_ = 0;
+
+  // Playback state of the current sequence. Instead of calling `delay()`, we
+  // record when the current wait began, and how long it lasts.
+  uint16_t wait_start_ = 0;
+  uint16_t wait_time_  = 0;
+  uint8_t interval_    = 0;
+  // The cycle start time `afterEachCycle()` last played steps at.
+  uint32_t advanced_at_ = 0;
+  // Nonzero while in the middle of a `SEQ()` or `SEQc()` step.
+  uint8_t sequence_ = 0;
+  // The key to be released when the current wait ends, if it's a tap.
+  Key pending_release_  = Key_NoKey;
+  bool playing_         = false;
+  bool clear_when_idle_ = false;
+
+  bool enqueue(const MacroCursor &cursor);
+  void start(const MacroCursor &cursor);
+  void finish();
+  void wait(uint16_t ms);
+  void step();
+  void advance();
+  void beginTap(Key key);
+  void latchModifiers();
+  void releaseLatchedModifiers();
 };
 
 }  // namespace plugin
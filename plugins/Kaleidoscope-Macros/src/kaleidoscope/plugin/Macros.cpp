@@ -22,7 +22,7 @@
 
 #include "kaleidoscope/plugin/Macros.h"
 
-#include <Arduino.h>                   // for pgm_read_byte, delay, F, PROGMEM, __F...
+#include <Arduino.h>                   // for pgm_read_byte, F, PROGMEM, __FlashStr...
 #include <Kaleidoscope-FocusSerial.h>  // for Focus, FocusSerial
 #include <Kaleidoscope-Ranges.h>       // for MACRO_FIRST
 #include <stdint.h>                    // for uint8_t
@@ -50,92 +50,10 @@ namespace plugin {
 // Public helper functions
 
 void Macros::play(const macro_t *macro_p) {
-  macro_t macro    = MACRO_ACTION_END;
-  uint8_t interval = 0;
-  Key key;
-
   if (macro_p == MACRO_NONE)
     return;
 
-
-  // Define a lambda function for common key operations to reduce redundancy
-  auto setKeyAndAction = [this, &key, &macro, &macro_p]() {
-    // Keycode variants of actions don't have flags to set, but we want to make sure
-    // we're still initializing them properly.
-
-    key.setFlags((macro == MACRO_ACTION_STEP_KEYCODEDOWN || macro == MACRO_ACTION_STEP_KEYCODEUP || macro == MACRO_ACTION_STEP_TAPCODE) ? 0
-                                                                                                                                        : pgm_read_byte(macro_p++));
-    key.setKeyCode(pgm_read_byte(macro_p++));
-
-    switch (macro) {
-    case MACRO_ACTION_STEP_KEYCODEDOWN:
-    case MACRO_ACTION_STEP_KEYDOWN:
-      this->press(key);
-      break;
-    case MACRO_ACTION_STEP_KEYCODEUP:
-    case MACRO_ACTION_STEP_KEYUP:
-      this->release(key);
-      break;
-    case MACRO_ACTION_STEP_TAP:
-    case MACRO_ACTION_STEP_TAPCODE:
-      this->tap(key);
-      break;
-    default:
-      break;
-    }
-  };
-
-
-  while (true) {
-    switch (macro = pgm_read_byte(macro_p++)) {
-    // These are unlikely to be useful now that we have KeyEvent. I think the
-    // whole `explicit_report` came about as a result of scan-order bugs.
-    case MACRO_ACTION_STEP_EXPLICIT_REPORT:
-    case MACRO_ACTION_STEP_IMPLICIT_REPORT:
-    case MACRO_ACTION_STEP_SEND_REPORT:
-      break;
-    // End legacy macro step commands
-
-    // Timing
-    case MACRO_ACTION_STEP_INTERVAL:
-      interval = pgm_read_byte(macro_p++);
-      break;
-    case MACRO_ACTION_STEP_WAIT: {
-      uint8_t wait = pgm_read_byte(macro_p++);
-      delay(wait);
-      break;
-    }
-
-    case MACRO_ACTION_STEP_KEYDOWN:
-    case MACRO_ACTION_STEP_KEYUP:
-    case MACRO_ACTION_STEP_TAP:
-    case MACRO_ACTION_STEP_KEYCODEDOWN:
-    case MACRO_ACTION_STEP_KEYCODEUP:
-    case MACRO_ACTION_STEP_TAPCODE:
-      setKeyAndAction();
-      break;
-
-    case MACRO_ACTION_STEP_TAP_SEQUENCE:
-    case MACRO_ACTION_STEP_TAP_CODE_SEQUENCE: {
-      bool isKeycodeSequence = macro == MACRO_ACTION_STEP_TAP_CODE_SEQUENCE;
-      while (true) {
-        key.setFlags(isKeycodeSequence ? 0 : pgm_read_byte(macro_p++));
-        key.setKeyCode(pgm_read_byte(macro_p++));
-        if (key == Key_NoKey)
-          break;
-        tap(key);
-        delay(interval);
-      }
-      break;
-    }
-
-    case MACRO_ACTION_END:
-    default:
-      return;
-    }
-
-    delay(interval);
-  }
+  ::MacroSupport.playFromProgmem(macro_p);
 }
 
 const macro_t *Macros::type(const char *string) const {
@@ -265,8 +183,9 @@ EventHandlerResult Macros::onKeyEvent(KeyEvent &event) {
     // changed by the user-defined `macroAction()` function, we clear the array
     // of active macro keys so that they won't get "stuck on".  There won't be a
     // subsequent event that Macros will recognize as actionable, so we need to
-    // do it here.
-    clear();
+    // do it here. If the sequence is still playing, that has to wait until
+    // it's done.
+    ::MacroSupport.clearWhenIdle();
   }
 
   // Return `OK` to let Kaleidoscope finish processing this event as normal.
@@ -77,6 +77,11 @@ class Macros : public kaleidoscope::Plugin {
   }
 
   /// Play a macro sequence of key events
+  ///
+  /// The sequence is played by `MacroSupport`, which starts it right away and
+  /// plays any steps that follow a delay from later cycles (see
+  /// `MacroSupport.playFromProgmem()`). If another sequence is already playing,
+  /// this one is queued after it.
   void play(const macro_t *macro_ptr);
 
   // Templates provide a `type()` function that takes a variable number of
@@ -99,6 +104,9 @@ class Macros : public kaleidoscope::Plugin {
   EventHandlerResult beforeReportingState(const KeyEvent &event) {
     return ::MacroSupport.beforeReportingState(event);
   }
+  EventHandlerResult afterEachCycle() {
+    return ::MacroSupport.afterEachCycle();
+  }
 
  private:
   // Translate and ASCII character value to a corresponding `Key`
@@ -22,13 +22,16 @@
 
 #include "kaleidoscope/plugin/MagicCombo.h"
 
-#include <Arduino.h>                   // for F, __FlashStringHelper, pgm_read_byte
+#include <Arduino.h>                   // for F, __FlashStringHelper, pgm_read_byte, pgm_read_ptr
 #include <Kaleidoscope-FocusSerial.h>  // for Focus, FocusSerial
 #include <stdint.h>                    // for uint16_t, int8_t, uint8_t
 
+#include "kaleidoscope/KeyAddr.h"               // for KeyAddr
+#include "kaleidoscope/KeyAddrBitfield.h"       // for KeyAddrBitfield
 #include "kaleidoscope/Runtime.h"               // for Runtime, Runtime_
 #include "kaleidoscope/device/device.h"         // for Device
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult, EventHandlerResult::OK
+#include "kaleidoscope/progmem_helpers.h"       // for cloneFromProgmem
 
 namespace kaleidoscope {
 namespace plugin {
@@ -42,33 +45,53 @@ EventHandlerResult MagicCombo::onNameQuery() {
 }
 
 EventHandlerResult MagicCombo::afterEachCycle() {
-  for (uint8_t i = 0; i < magiccombo::combos_length; i++) {
-    bool match = true;
-    uint8_t j;
+  // A combo only matches if exactly its keyswitches are pressed, so there's no
+  // need to look at which ones are unless their number is right for at least
+  // one of them.
+  uint8_t pressed_count = Runtime.device().pressedKeyswitchCount();
+  if (pressed_count == 0 || pressed_count > MAX_COMBO_LENGTH) {
+    if (matched_combo_ != no_combo_) {
+      pressed_addrs_.clear();
+      matched_combo_ = no_combo_;
+    }
+    return EventHandlerResult::OK;
+  }
 
-    for (j = 0; j < MAX_COMBO_LENGTH; j++) {
-      int8_t comboKey = pgm_read_byte(&(magiccombo::combos[i].keys[j]));
+  // Only look for a matching combo when the set of pressed keyswitches has
+  // changed. Until it changes again, a matching combo's action gets triggered
+  // (again) each time the minimum interval has passed.
+  KeyAddrBitfield pressed_addrs;
+  Runtime.device().forEachPressedKeyswitch([&pressed_addrs](KeyAddr key_addr) {
+    pressed_addrs.set(key_addr);
+  });
+  if (pressed_addrs != pressed_addrs_) {
+    pressed_addrs_ = pressed_addrs;
+    matched_combo_ = findCombo(pressed_count);
+  }
 
-      if (comboKey == 0)
-        break;
+  if (matched_combo_ != no_combo_ &&
+      Runtime.hasTimeExpired(start_time_, getMinInterval())) {
+    ComboAction action = (ComboAction)pgm_read_ptr((void const **)&(magiccombo::combos[matched_combo_].action));
 
-      match &= Runtime.device().isKeyswitchPressed(comboKey);
-      if (!match)
-        break;
-    }
+    (*action)(matched_combo_);
+    start_time_ = Runtime.millisAtCycleStart();
+  }
 
-    if (j != Runtime.device().pressedKeyswitchCount())
-      match = false;
+  return EventHandlerResult::OK;
+}
 
-    if (match && Runtime.hasTimeExpired(start_time_, getMinInterval())) {
-      ComboAction action = (ComboAction)pgm_read_ptr((void const **)&(magiccombo::combos[i].action));
+uint8_t MagicCombo::findCombo(uint8_t pressed_count) {
+  // Only combos of the right size need their bitfields compared.
+  for (uint8_t i = 0; i < magiccombo::combos_length; i++) {
+    if (pgm_read_byte(&(magiccombo::combo_masks[i].size)) != pressed_count)
+      continue;
 
-      (*action)(i);
-      start_time_ = Runtime.millisAtCycleStart();
-    }
+    ComboMask mask = cloneFromProgmem(magiccombo::combo_masks[i]);
+    if (mask.keyswitches == pressed_addrs_)
+      return i;
   }
 
-  return EventHandlerResult::OK;
+  return no_combo_;
 }
 
 }  // namespace plugin
@@ -25,6 +25,8 @@
 #include <Arduino.h>  // for PROGMEM
 #include <stdint.h>   // for uint16_t, uint8_t, int8_t
 
+#include "kaleidoscope/KeyAddr.h"               // for KeyAddr
+#include "kaleidoscope/KeyAddrBitfield.h"       // for KeyAddrBitfield
 #include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
 #include "kaleidoscope/plugin.h"                // for Plugin
 // -----------------------------------------------------------------------------
@@ -39,16 +41,22 @@
 
 #define MAX_COMBO_LENGTH 5
 
-#define USE_MAGIC_COMBOS(...)                                      \
-  namespace kaleidoscope {                                         \
-  namespace plugin {                                               \
-  namespace magiccombo {                                           \
-  const kaleidoscope::plugin::MagicCombo::Combo combos[] PROGMEM = \
-    {__VA_ARGS__};                                                 \
-                                                                   \
-  const uint8_t combos_length = sizeof(combos) / sizeof(*combos);  \
-  }                                                                \
-  }                                                                \
+#define USE_MAGIC_COMBOS(...)                                                    \
+  namespace kaleidoscope {                                                       \
+  namespace plugin {                                                             \
+  namespace magiccombo {                                                         \
+  constexpr kaleidoscope::plugin::MagicCombo::Combo combos[] PROGMEM =           \
+    {__VA_ARGS__};                                                               \
+                                                                                 \
+  const uint8_t combos_length = sizeof(combos) / sizeof(*combos);                \
+                                                                                 \
+  constexpr kaleidoscope::plugin::MagicCombo::ComboMaskTable<                    \
+    sizeof(combos) / sizeof(*combos)>                                            \
+    combo_mask_table PROGMEM{combos};                                            \
+  const kaleidoscope::plugin::MagicCombo::ComboMask *const combo_masks =         \
+    combo_mask_table.masks;                                                      \
+  }                                                                              \
+  }                                                                              \
   }
 
 namespace kaleidoscope {
@@ -62,6 +70,33 @@ class MagicCombo : public kaleidoscope::Plugin {
     int8_t keys[MAX_COMBO_LENGTH + 1];
   };
 
+  /// The keyswitches of a `Combo`, as a bitfield, along with their number
+  struct ComboMask {
+    KeyAddrBitfield keyswitches;
+    uint8_t size;
+  };
+
+  /// The `ComboMask` of each combo, computed at compile time by
+  /// `USE_MAGIC_COMBOS()`
+  template<uint8_t _combos_length>
+  struct ComboMaskTable {
+    ComboMask masks[_combos_length];
+
+    constexpr explicit ComboMaskTable(Combo const (&combos)[_combos_length])
+      : masks{} {
+      for (uint8_t i = 0; i < _combos_length; i++) {
+        for (uint8_t j = 0; j < MAX_COMBO_LENGTH; j++) {
+          int8_t key_index = combos[i].keys[j];
+          if (key_index == 0)
+            break;
+          // Key indexes are one-based (see `device/key_indexes.h`).
+          masks[i].keyswitches.set(KeyAddr(uint8_t(key_index - 1)));
+          masks[i].size++;
+        }
+      }
+    }
+  };
+
 #ifndef NDEPRECATED
   DEPRECATED(MAGICCOMBO_MIN_INTERVAL)
   static uint16_t min_interval;
@@ -93,13 +128,25 @@ class MagicCombo : public kaleidoscope::Plugin {
   EventHandlerResult afterEachCycle();
 
  private:
+  static constexpr uint8_t no_combo_ = 0xFF;
+
   uint16_t start_time_   = 0;
   uint16_t min_interval_ = 500;
+
+  // The keyswitches that were pressed when combos were last matched, as read
+  // from the device, so that plugins consuming or aborting keyswitch events
+  // can't throw them off. Combos are only matched again when these change.
+  KeyAddrBitfield pressed_addrs_;
+  // The index of the combo that matches `pressed_addrs_`, or `no_combo_`
+  uint8_t matched_combo_ = no_combo_;
+
+  uint8_t findCombo(uint8_t pressed_count);
 };
 
 namespace magiccombo {
 extern const MagicCombo::Combo combos[];
 extern const uint8_t combos_length;
+extern const MagicCombo::ComboMask *const combo_masks;
 }  // namespace magiccombo
 
 }  // namespace plugin
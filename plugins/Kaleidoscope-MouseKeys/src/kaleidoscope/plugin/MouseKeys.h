@@ -205,6 +205,7 @@ class MouseKeysConfig : public Plugin {
  public:
   EventHandlerResult onSetup();
   EventHandlerResult onFocusEvent(const char *command);
+  static bool focusCommand(uint16_t hash, const char *command);
 
  private:
   // The base address in persistent storage for configuration data:
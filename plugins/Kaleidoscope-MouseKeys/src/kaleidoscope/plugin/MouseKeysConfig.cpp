@@ -54,6 +54,13 @@ EventHandlerResult MouseKeysConfig::onSetup() {
 }
 
 // -----------------------------------------------------------------------------
+FOCUS_COMMANDS(MouseKeysConfig,
+               "mousekeys.scroll_interval",
+               "mousekeys.init_speed",
+               "mousekeys.base_speed",
+               "mousekeys.accel_duration",
+               "mousekeys.warp_grid_size")
+
 EventHandlerResult MouseKeysConfig::onFocusEvent(const char *input) {
   enum Command : uint8_t {
     SCROLL_INTERVAL,
@@ -62,19 +69,11 @@ EventHandlerResult MouseKeysConfig::onFocusEvent(const char *input) {
     ACCEL_DURATION,
     WARP_GRID_SIZE,
   } cmd;
-  const char *cmd_scroll_interval = PSTR("mousekeys.scroll_interval");
-  const char *cmd_initial_speed   = PSTR("mousekeys.init_speed");
-  const char *cmd_base_speed      = PSTR("mousekeys.base_speed");
-  const char *cmd_accel_duration  = PSTR("mousekeys.accel_duration");
-  const char *cmd_warp_grid_size  = PSTR("mousekeys.warp_grid_size");
-
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(
-      cmd_scroll_interval,
-      cmd_initial_speed,
-      cmd_base_speed,
-      cmd_accel_duration,
-      cmd_warp_grid_size);
+  const auto cmd_scroll_interval = FOCUS_COMMAND("mousekeys.scroll_interval");
+  const auto cmd_initial_speed   = FOCUS_COMMAND("mousekeys.init_speed");
+  const auto cmd_base_speed      = FOCUS_COMMAND("mousekeys.base_speed");
+  const auto cmd_accel_duration  = FOCUS_COMMAND("mousekeys.accel_duration");
+  const auto cmd_warp_grid_size  = FOCUS_COMMAND("mousekeys.warp_grid_size");
 
   if (::Focus.inputMatchesCommand(input, cmd_scroll_interval))
     cmd = Command::SCROLL_INTERVAL;
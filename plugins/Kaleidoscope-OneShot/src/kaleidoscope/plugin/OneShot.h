@@ -265,6 +265,7 @@ class OneShotConfig : public Plugin {
   EventHandlerResult onNameQuery();
   EventHandlerResult onSetup();
   EventHandlerResult onFocusEvent(const char *command);
+  static bool focusCommand(uint16_t hash, const char *command);
 
  private:
   // The base address in persistent storage for configuration data:
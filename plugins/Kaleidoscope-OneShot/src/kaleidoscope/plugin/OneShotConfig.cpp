@@ -49,6 +49,14 @@ EventHandlerResult OneShotConfig::onNameQuery() {
   return ::Focus.sendName(F("OneShotConfig"));
 }
 
+FOCUS_COMMANDS(OneShotConfig,
+               "oneshot.timeout",
+               "oneshot.hold_timeout",
+               "oneshot.double_tap_timeout",
+               "oneshot.stickable_keys",
+               "oneshot.auto_mods",
+               "oneshot.auto_layers")
+
 EventHandlerResult OneShotConfig::onFocusEvent(const char *input) {
   enum Command : uint8_t {
     TIMEOUT,
@@ -58,21 +66,12 @@ EventHandlerResult OneShotConfig::onFocusEvent(const char *input) {
     AUTO_MODS,
     AUTO_LAYERS,
   } cmd;
-  const char *cmd_timeout            = PSTR("oneshot.timeout");
-  const char *cmd_hold_timeout       = PSTR("oneshot.hold_timeout");
-  const char *cmd_double_tap_timeout = PSTR("oneshot.double_tap_timeout");
-  const char *cmd_stickable_keys     = PSTR("oneshot.stickable_keys");
-  const char *cmd_auto_mods          = PSTR("oneshot.auto_mods");
-  const char *cmd_auto_layers        = PSTR("oneshot.auto_layers");
-
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(
-      cmd_timeout,
-      cmd_hold_timeout,
-      cmd_double_tap_timeout,
-      cmd_stickable_keys,
-      cmd_auto_mods,
-      cmd_auto_layers);
+  const auto cmd_timeout            = FOCUS_COMMAND("oneshot.timeout");
+  const auto cmd_hold_timeout       = FOCUS_COMMAND("oneshot.hold_timeout");
+  const auto cmd_double_tap_timeout = FOCUS_COMMAND("oneshot.double_tap_timeout");
+  const auto cmd_stickable_keys     = FOCUS_COMMAND("oneshot.stickable_keys");
+  const auto cmd_auto_mods          = FOCUS_COMMAND("oneshot.auto_mods");
+  const auto cmd_auto_layers        = FOCUS_COMMAND("oneshot.auto_layers");
 
   if (::Focus.inputMatchesCommand(input, cmd_timeout))
     cmd = Command::TIMEOUT;
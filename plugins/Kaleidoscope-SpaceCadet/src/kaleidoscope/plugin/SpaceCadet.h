@@ -150,6 +150,7 @@ class SpaceCadetConfig : public kaleidoscope::Plugin {
  public:
   EventHandlerResult onSetup();
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
 
   void disableSpaceCadetIfUnconfigured();
 
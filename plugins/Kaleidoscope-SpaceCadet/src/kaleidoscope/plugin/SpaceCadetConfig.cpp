@@ -51,12 +51,11 @@ void SpaceCadetConfig::disableSpaceCadetIfUnconfigured() {
   }
 }
 
-EventHandlerResult SpaceCadetConfig::onFocusEvent(const char *input) {
-  const char *cmd_mode    = PSTR("spacecadet.mode");
-  const char *cmd_timeout = PSTR("spacecadet.timeout");
+FOCUS_COMMANDS(SpaceCadetConfig, "spacecadet.mode", "spacecadet.timeout")
 
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_mode, cmd_timeout);
+EventHandlerResult SpaceCadetConfig::onFocusEvent(const char *input) {
+  const auto cmd_mode    = FOCUS_COMMAND("spacecadet.mode");
+  const auto cmd_timeout = FOCUS_COMMAND("spacecadet.timeout");
 
   if (::Focus.inputMatchesCommand(input, cmd_mode)) {
     if (::Focus.isEOL()) {
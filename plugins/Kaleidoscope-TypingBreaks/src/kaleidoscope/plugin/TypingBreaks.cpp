@@ -135,6 +135,16 @@ EventHandlerResult TypingBreaks::onSetup() {
 }
 
 
+FOCUS_COMMANDS(TypingBreaks,
+               "typingbreaks.idleTimeLimit",
+               "typingbreaks.lockTimeOut",
+               "typingbreaks.lockLength",
+               "typingbreaks.leftMaxKeys",
+               "typingbreaks.rightMaxKeys",
+               "typingbreaks.leftKeys",
+               "typingbreaks.rightKeys",
+               "typingbreaks.lockSecsRemaining")
+
 EventHandlerResult TypingBreaks::onFocusEvent(const char *input) {
   enum {
     IDLE_TIME_LIMIT,
@@ -147,24 +157,14 @@ EventHandlerResult TypingBreaks::onFocusEvent(const char *input) {
     LOCK_SECS_REMAINING,
   } subCommand;
 
-  const char *cmd_idleTimeLimit = PSTR("typingbreaks.idleTimeLimit");
-  const char *cmd_lockTimeOut   = PSTR("typingbreaks.lockTimeOut");
-  const char *cmd_lockLength    = PSTR("typingbreaks.lockLength");
-  const char *cmd_leftMaxKeys   = PSTR("typingbreaks.leftMaxKeys");
-  const char *cmd_rightMaxKeys  = PSTR("typingbreaks.rightMaxKeys");
-  const char *cmd_leftKeys      = PSTR("typingbreaks.leftKeys");
-  const char *cmd_rightKeys     = PSTR("typingbreaks.rightKeys");
-  const char *cmd_lockSecsRem   = PSTR("typingbreaks.lockSecsRemaining");
-  if (::Focus.inputMatchesHelp(input))
-    return ::Focus.printHelp(cmd_idleTimeLimit,
-                             cmd_lockTimeOut,
-                             cmd_lockLength,
-                             cmd_leftMaxKeys,
-                             cmd_rightMaxKeys,
-                             cmd_leftKeys,
-                             cmd_rightKeys,
-                             cmd_lockSecsRem);
-
+  const auto cmd_idleTimeLimit = FOCUS_COMMAND("typingbreaks.idleTimeLimit");
+  const auto cmd_lockTimeOut   = FOCUS_COMMAND("typingbreaks.lockTimeOut");
+  const auto cmd_lockLength    = FOCUS_COMMAND("typingbreaks.lockLength");
+  const auto cmd_leftMaxKeys   = FOCUS_COMMAND("typingbreaks.leftMaxKeys");
+  const auto cmd_rightMaxKeys  = FOCUS_COMMAND("typingbreaks.rightMaxKeys");
+  const auto cmd_leftKeys      = FOCUS_COMMAND("typingbreaks.leftKeys");
+  const auto cmd_rightKeys     = FOCUS_COMMAND("typingbreaks.rightKeys");
+  const auto cmd_lockSecsRem   = FOCUS_COMMAND("typingbreaks.lockSecsRemaining");
   if (::Focus.inputMatchesCommand(input, cmd_idleTimeLimit))
     subCommand = IDLE_TIME_LIMIT;
   else if (::Focus.inputMatchesCommand(input, cmd_lockTimeOut))
@@ -46,6 +46,7 @@ class TypingBreaks : public kaleidoscope::Plugin {
   EventHandlerResult onNameQuery();
   EventHandlerResult onKeyEvent(KeyEvent &event);
   EventHandlerResult onFocusEvent(const char *input);
+  static bool focusCommand(uint16_t hash, const char *command);
   EventHandlerResult onSetup();
 
  private:
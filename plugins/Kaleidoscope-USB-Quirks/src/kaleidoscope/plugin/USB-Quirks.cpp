@@ -70,7 +70,7 @@ void USBQuirks::toggleKeyboardProtocol() {
   if (key_addr.isValid()) {
     ::LEDControl.setCrgbAt(key_addr, CRGB(0, 0, 255));
   }
-  Runtime.device().syncLeds();
+  ::LEDControl.showFrame();
   /*
    * Release keys, because after detach, Windows 10 remembers keys that
    * were pressed (from the MagicCombo that activated this function).
@@ -25,4 +25,5 @@
 #include "kaleidoscope/plugin/LEDMode.h"
 #include "kaleidoscope/plugin/LEDControl.h"
 #include "kaleidoscope/plugin/LEDControl/LEDUtils.h"
+#include "kaleidoscope/plugin/LEDControl/ColorMath.h"
 #include "kaleidoscope/plugin/LEDControl/LED-Off.h"
@@ -0,0 +1,61 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2013-2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "kaleidoscope/HookProfile.h"
+
+namespace kaleidoscope {
+namespace profiling {
+
+HookStats *HookProfile::first_ = nullptr;
+
+void HookProfile::record(HookStats &stats,
+                         const __FlashStringHelper *plugin,
+                         const __FlashStringHelper *hook,
+                         uint32_t elapsed_us) {
+  if (stats.hook == nullptr) {
+    stats.plugin = plugin;
+    stats.hook   = hook;
+    stats.next   = first_;
+    first_       = &stats;
+  }
+
+  uint16_t elapsed = elapsed_us > 0xFFFF ? 0xFFFF : elapsed_us;
+  if (stats.calls == 0 || elapsed < stats.min_us)
+    stats.min_us = elapsed;
+  if (elapsed > stats.max_us)
+    stats.max_us = elapsed;
+  stats.total_us += elapsed_us;
+  ++stats.calls;
+}
+
+void HookProfile::reset() {
+  for (HookStats *stats = first_; stats != nullptr; stats = stats->next) {
+    stats->calls    = 0;
+    stats->total_us = 0;
+    stats->min_us   = 0;
+    stats->max_us   = 0;
+  }
+}
+
+}  // namespace profiling
+}  // namespace kaleidoscope
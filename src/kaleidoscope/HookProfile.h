@@ -0,0 +1,107 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2013-2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <Arduino.h>  // for __FlashStringHelper, micros
+#include <stdint.h>   // for uint16_t, uint32_t
+
+#include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
+
+namespace kaleidoscope {
+namespace profiling {
+
+/// The call count and cost of one plugin's handler for one hook
+///
+/// Each of these is a static variable of the code that calls the handler, so
+/// they only exist for the handlers plugins actually implement. They are linked
+/// together the first time the handler is called.
+struct HookStats {
+  HookStats *next;
+  const __FlashStringHelper *plugin;
+  const __FlashStringHelper *hook;
+  uint32_t calls;
+  // All times are in microseconds, and include the time spent in any hooks
+  // that were called from within the handler.
+  uint32_t total_us;
+  uint16_t min_us;
+  uint16_t max_us;
+};
+
+/// The hook profiler
+///
+/// When a sketch defines `KALEIDOSCOPE_PROFILE_HOOKS` before including
+/// `Kaleidoscope.h`, the hook dispatch generated by `KALEIDOSCOPE_INIT_PLUGINS()`
+/// times every call of every plugin's event handlers, and records it here.
+/// Without it, nothing is recorded, and none of the profiling code is compiled
+/// into the firmware.
+class HookProfile {
+ public:
+  static void record(HookStats &stats,
+                     const __FlashStringHelper *plugin,
+                     const __FlashStringHelper *hook,
+                     uint32_t elapsed_us);
+
+  /// Returns the first recorded handler, or `nullptr` if there are none. The
+  /// rest of them are reached through `HookStats::next`.
+  static const HookStats *first() {
+    return first_;
+  }
+
+  /// Clears the statistics of every handler.
+  static void reset();
+
+ private:
+  static HookStats *first_;
+};
+
+// Calls a plugin's handler for a hook, timing the call if the plugin
+// implements the handler. `_id` is unique to each plugin instance, so that each
+// of them gets its own `HookStats`.
+template<bool _implemented>
+struct ProfiledCall {
+  template<typename EventHandler, int _id, typename Plugin, typename... Args>
+  static EventHandlerResult call(const __FlashStringHelper *plugin_name,
+                                 Plugin &plugin,
+                                 Args &&...hook_args) {
+    static HookStats stats;
+
+    uint32_t start            = micros();
+    EventHandlerResult result = EventHandler::call(plugin, hook_args...);
+    HookProfile::record(stats, plugin_name, EventHandler::name(), micros() - start);
+    return result;
+  }
+};
+
+template<>
+struct ProfiledCall<false> {
+  template<typename EventHandler, int _id, typename Plugin, typename... Args>
+  static EventHandlerResult call(const __FlashStringHelper * /*plugin_name*/,
+                                 Plugin &plugin,
+                                 Args &&...hook_args) {
+    return EventHandler::call(plugin, hook_args...);
+  }
+};
+
+}  // namespace profiling
+}  // namespace kaleidoscope
@@ -24,7 +24,7 @@
 
 #include <Arduino.h>  // for bitClear, bitRead, bitSet, bitWrite
 #include <stdint.h>   // for uint8_t
-#include <string.h>   // for memset
+#include <string.h>   // for memcmp, memset
 
 #include "kaleidoscope/KeyAddr.h"  // for KeyAddr
 
@@ -64,7 +64,7 @@ class KeyAddrBitfield {
     // assert(k.toInt() < size);
     return bitRead(data_[blockIndex(k)], bitIndex(k));
   }
-  void set(KeyAddr k) {
+  constexpr void set(KeyAddr k) {
     // assert(k.toInt() < size);
     bitSet(data_[blockIndex(k)], bitIndex(k));
   }
@@ -80,6 +80,13 @@ class KeyAddrBitfield {
     memset(data_, 0, sizeof(data_));
   }
 
+  bool operator==(const KeyAddrBitfield &other) const {
+    return memcmp(data_, other.data_, sizeof(data_)) == 0;
+  }
+  bool operator!=(const KeyAddrBitfield &other) const {
+    return !(*this == other);
+  }
+
   // This function returns the number of set bits in the bitfield up to and
   // including the bit at index `k`. Two important things to note: it doesn't
   // verify that the bit for index `k` is set (the caller must do so first,
@@ -103,6 +110,10 @@ class KeyAddrBitfield {
     // assert(block_index < total_blocks);
     return data_[block_index];
   }
+  const uint8_t &block(uint8_t block_index) const {
+    // assert(block_index < total_blocks);
+    return data_[block_index];
+  }
 
  private:
   uint8_t data_[total_blocks] = {};
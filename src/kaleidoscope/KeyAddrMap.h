@@ -68,10 +68,14 @@ class KeyAddrMap {
   // Or, if we need write access to the entries in the array:
   //
   // for (Key &key : key_map) {...}
+  //
+  // A `const` map can only be iterated over by value, or `const` reference.
  private:
   class Iterator;
+  class ConstIterator;
 
   friend class ThisType::Iterator;
+  friend class ThisType::ConstIterator;
 
  public:
   Iterator begin() {
@@ -80,6 +84,12 @@ class KeyAddrMap {
   Iterator end() {
     return {*this, KeyAddr(_size)};
   }
+  ConstIterator begin() const {
+    return {*this, KeyAddr(uint8_t(0))};
+  }
+  ConstIterator end() const {
+    return {*this, KeyAddr(_size)};
+  }
 
  private:
   class Iterator {
@@ -101,6 +111,26 @@ class KeyAddrMap {
     ThisType &map_;
     KeyAddr key_addr_;
   };
+
+  class ConstIterator {
+   public:
+    ConstIterator(const ThisType &map, KeyAddr key_addr)
+      : map_(map), key_addr_(key_addr) {}
+    bool operator!=(const ConstIterator &other) const {
+      return key_addr_ != other.key_addr_;
+    }
+    const _ContentType &operator*() const {
+      return map_[key_addr_];
+    }
+    ConstIterator &operator++() {
+      ++key_addr_;
+      return *this;
+    }
+
+   private:
+    const ThisType &map_;
+    KeyAddr key_addr_;
+  };
 };
 
 }  // namespace kaleidoscope
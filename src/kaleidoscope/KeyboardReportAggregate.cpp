@@ -0,0 +1,186 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2013-2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kaleidoscope/KeyboardReportAggregate.h"
+
+#include <string.h>  // for memset
+
+#include "kaleidoscope/key_defs.h"  // for Key, CTRL_HELD, GUI_HELD, LALT_HELD, RALT_HELD
+
+namespace kaleidoscope {
+
+namespace {
+
+// Returns a bitmap of the modifiers contributed by a Keyboard key, where bit
+// `i` represents the modifier keycode `HID_KEYBOARD_FIRST_MODIFIER + i`. This
+// mirrors `Runtime.addToReport()`, which only keeps the modifier flags of
+// "intentional" modifier keys.
+uint8_t modifierBits(Key key) {
+  if (!key.isKeyboardModifier())
+    return 0;
+
+  uint8_t bits  = 1 << (key.getKeyCode() - HID_KEYBOARD_FIRST_MODIFIER);
+  uint8_t flags = key.getFlags();
+  if (flags & CTRL_HELD)
+    bits |= 1 << (HID_KEYBOARD_LEFT_CONTROL - HID_KEYBOARD_FIRST_MODIFIER);
+  if (flags & SHIFT_HELD)
+    bits |= 1 << (HID_KEYBOARD_LEFT_SHIFT - HID_KEYBOARD_FIRST_MODIFIER);
+  if (flags & LALT_HELD)
+    bits |= 1 << (HID_KEYBOARD_LEFT_ALT - HID_KEYBOARD_FIRST_MODIFIER);
+  if (flags & RALT_HELD)
+    bits |= 1 << (HID_KEYBOARD_RIGHT_ALT - HID_KEYBOARD_FIRST_MODIFIER);
+  if (flags & GUI_HELD)
+    bits |= 1 << (HID_KEYBOARD_LEFT_GUI - HID_KEYBOARD_FIRST_MODIFIER);
+  return bits;
+}
+
+// Mod-layer keys add a modifier to the report while held.
+Key reportKey(Key key) {
+  if (key.isModLayerKey()) {
+    uint8_t mod = key.getKeyCode() % 8;
+    return Key(Key_LeftControl.getRaw() + mod);
+  }
+  return key;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+void KeyboardReportAggregate::add(Key key) {
+  key = reportKey(key);
+
+  if (key.isKeyboardKey()) {
+    if (key.isKeyboardModifier()) {
+      addModifiers(modifierBits(key));
+    } else {
+      addKeycode(key.getKeyCode());
+    }
+    return;
+  }
+
+  if (key.isConsumerControlKey())
+    addConsumerKey(key);
+}
+
+bool KeyboardReportAggregate::remove(Key key) {
+  key = reportKey(key);
+
+  bool exact = true;
+  if (key.isKeyboardKey()) {
+    if (key.isKeyboardModifier()) {
+      exact = removeModifiers(modifierBits(key));
+    } else {
+      exact = removeKeycode(key.getKeyCode());
+    }
+  } else if (key.isConsumerControlKey()) {
+    exact = removeConsumerKey(key);
+  }
+
+  if (!exact)
+    invalidate();
+  return exact;
+}
+
+void KeyboardReportAggregate::clear() {
+  memset(keycodes_, 0, sizeof(keycodes_));
+  memset(modifier_counts_, 0, sizeof(modifier_counts_));
+  memset(consumer_counts_, 0, sizeof(consumer_counts_));
+  duplicate_keycodes_ = 0;
+  valid_              = true;
+}
+
+// -----------------------------------------------------------------------------
+void KeyboardReportAggregate::addKeycode(uint8_t keycode) {
+  uint8_t &block = keycodes_[keycode / 8];
+  uint8_t bit    = 1 << (keycode % 8);
+  if (block & bit) {
+    // Saturate rather than wrap; once this is non-zero, the next removal will
+    // force a rebuild anyway.
+    if (duplicate_keycodes_ < 0xFF)
+      ++duplicate_keycodes_;
+  }
+  block |= bit;
+}
+
+bool KeyboardReportAggregate::removeKeycode(uint8_t keycode) {
+  uint8_t &block = keycodes_[keycode / 8];
+  uint8_t bit    = 1 << (keycode % 8);
+  if (!(block & bit) || duplicate_keycodes_ != 0)
+    return false;
+  block &= ~bit;
+  return true;
+}
+
+void KeyboardReportAggregate::addModifiers(uint8_t modifiers) {
+  for (uint8_t i = 0; i < modifier_count; ++i) {
+    if (modifiers & (1 << i))
+      ++modifier_counts_[i];
+  }
+}
+
+bool KeyboardReportAggregate::removeModifiers(uint8_t modifiers) {
+  bool exact = true;
+  for (uint8_t i = 0; i < modifier_count; ++i) {
+    if (!(modifiers & (1 << i)))
+      continue;
+    if (modifier_counts_[i] == 0) {
+      exact = false;
+    } else {
+      --modifier_counts_[i];
+    }
+  }
+  return exact;
+}
+
+void KeyboardReportAggregate::addConsumerKey(Key key) {
+  uint8_t empty_slot = max_consumer_codes;
+  for (uint8_t i = 0; i < max_consumer_codes; ++i) {
+    if (consumer_counts_[i] == 0) {
+      if (empty_slot == max_consumer_codes)
+        empty_slot = i;
+    } else if (consumer_keys_[i] == key) {
+      ++consumer_counts_[i];
+      return;
+    }
+  }
+  // The Consumer Control report itself only has room for this many codes, but
+  // `Runtime.addToReport()` doesn't know that, so we let the slow path deal
+  // with any overflow the same way it always has.
+  if (empty_slot == max_consumer_codes) {
+    invalidate();
+    return;
+  }
+  consumer_keys_[empty_slot]   = key;
+  consumer_counts_[empty_slot] = 1;
+}
+
+bool KeyboardReportAggregate::removeConsumerKey(Key key) {
+  for (uint8_t i = 0; i < max_consumer_codes; ++i) {
+    if (consumer_counts_[i] != 0 && consumer_keys_[i] == key) {
+      --consumer_counts_[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace kaleidoscope
@@ -0,0 +1,100 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2013-2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>  // for uint8_t
+
+#include "kaleidoscope/key_defs.h"  // for Key
+
+namespace kaleidoscope {
+
+/// The combined HID report contributions of all active `live_keys` entries
+///
+/// `LiveKeys` keeps one of these up to date as entries are activated and
+/// cleared, so that `Runtime.prepareKeyboardReport()` can populate a new report
+/// without visiting every key on the keyboard. Each active `Key` contributes
+/// exactly what `Runtime.addToReport()` would add for it (absent any
+/// `onAddToReport()` plugin handlers): a Keyboard keycode, the modifiers from
+/// its flags (for "intentional" modifier keys only), or a Consumer Control
+/// code.
+///
+/// Modifiers are reference-counted, because they are frequently shared by
+/// several active keys. Non-modifier keycodes and Consumer Control codes are
+/// tracked more cheaply; if one of them can't be removed exactly (because more
+/// than one key contributed it), the aggregate marks itself invalid, and the
+/// next report is built the slow way, which also rebuilds the aggregate.
+class KeyboardReportAggregate {
+ public:
+  static constexpr uint8_t keycode_bytes      = 32;
+  static constexpr uint8_t modifier_count     = 8;
+  static constexpr uint8_t max_consumer_codes = 4;
+
+  /// Add the contribution of an active `live_keys` entry.
+  void add(Key key);
+
+  /// Remove the contribution of a previously-added entry. Returns `false` (and
+  /// invalidates the aggregate) if that can't be done exactly.
+  bool remove(Key key);
+
+  /// Reset to the empty (and valid) state.
+  void clear();
+
+  bool isValid() const {
+    return valid_;
+  }
+  void invalidate() {
+    valid_ = false;
+  }
+
+  /// Returns a bitmap byte of active Keyboard keycodes `8 * i` to `8 * i + 7`.
+  uint8_t keycodeBlock(uint8_t i) const {
+    return keycodes_[i];
+  }
+  /// Returns `true` if the modifier `HID_KEYBOARD_FIRST_MODIFIER + i` is active.
+  bool isModifierActive(uint8_t i) const {
+    return modifier_counts_[i] != 0;
+  }
+  /// Returns the Consumer Control `Key` in slot `i`, or `Key_NoKey` if empty.
+  Key consumerKey(uint8_t i) const {
+    return consumer_counts_[i] != 0 ? consumer_keys_[i] : Key_NoKey;
+  }
+
+ private:
+  uint8_t keycodes_[keycode_bytes]             = {};
+  uint8_t modifier_counts_[modifier_count]     = {};
+  Key consumer_keys_[max_consumer_codes]       = {};
+  uint8_t consumer_counts_[max_consumer_codes] = {};
+  // The number of times a non-modifier keycode was added while it was already
+  // present. While this is non-zero, removing one isn't necessarily exact.
+  uint8_t duplicate_keycodes_ = 0;
+  bool valid_                 = true;
+
+  void addKeycode(uint8_t keycode);
+  bool removeKeycode(uint8_t keycode);
+  void addModifiers(uint8_t modifiers);
+  bool removeModifiers(uint8_t modifiers);
+  void addConsumerKey(Key key);
+  bool removeConsumerKey(Key key);
+};
+
+}  // namespace kaleidoscope
@@ -22,10 +22,12 @@
 
 #pragma once
 
-#include "kaleidoscope/KeyAddr.h"     // for KeyAddr
-#include "kaleidoscope/KeyAddrMap.h"  // for KeyAddrMap<>::Iterator, KeyAddrMap
-#include "kaleidoscope/KeyMap.h"      // for KeyMap
-#include "kaleidoscope/key_defs.h"    // for Key, Key_Masked, Key_Inactive
+#include "kaleidoscope/KeyAddr.h"                  // for KeyAddr
+#include "kaleidoscope/KeyAddrBitfield.h"          // for KeyAddrBitfield
+#include "kaleidoscope/KeyAddrMap.h"               // for KeyAddrMap<>::Iterator, KeyAddrMap
+#include "kaleidoscope/KeyMap.h"                   // for KeyMap
+#include "kaleidoscope/KeyboardReportAggregate.h"  // for KeyboardReportAggregate
+#include "kaleidoscope/key_defs.h"                 // for Key, Key_Masked, Key_Inactive
 
 namespace kaleidoscope {
 
@@ -47,10 +49,15 @@ namespace kaleidoscope {
 /// engaged), and the `Key` value is what the that key is "sending" at the
 /// time. At the end of its processing of a `KeyEvent`, Kaleidoscope will use
 /// the contents of this array to populate the Keyboard HID reports.
+///
+/// Entries can only be changed through `activate()`, `clear()`, and `mask()`,
+/// so that `LiveKeys` can keep track of which entries are active, and of their
+/// combined contributions to the HID reports, as they change.
 
 class LiveKeys {
  public:
-  // For array-style subscript addressing of entries in a read-only context:
+  // For array-style subscript addressing of entries. This is read-only; use
+  // `activate()`, `clear()`, or `mask()` to change an entry.
   const Key &operator[](KeyAddr key_addr) const {
     if (key_addr.isValid()) {
       return key_map_[key_addr];
@@ -59,33 +66,23 @@ class LiveKeys {
     return dummy_;
   }
 
-  // For array-style subscript addressing of entries by reference. The client
-  // code can alter values in the array this way.
-  Key &operator[](KeyAddr key_addr) {
-    if (key_addr.isValid()) {
-      return key_map_[key_addr];
-    }
-    dummy_ = Key_Masked;
-    return dummy_;
-  }
-
   /// Set an entry to "active" with a specified `Key` value.
   void activate(KeyAddr key_addr, Key key) {
     if (key_addr.isValid())
-      key_map_[key_addr] = key;
+      update(key_addr, key);
   }
 
   /// Deactivate an entry by setting its value to `Key_Inactive`.
   void clear(KeyAddr key_addr) {
     if (key_addr.isValid())
-      key_map_[key_addr] = Key_Inactive;
+      update(key_addr, Key_Inactive);
   }
 
   /// Mask a key by setting its entry to `Key_Masked`. The key will become
   /// unmasked by Kaleidoscope on release (but not on a key press event).
   void mask(KeyAddr key_addr) {
     if (key_addr.isValid())
-      key_map_[key_addr] = Key_Masked;
+      update(key_addr, Key_Masked);
   }
 
   /// Clear the entire array by setting all values to `Key_Inactive`.
@@ -93,18 +90,58 @@ class LiveKeys {
     for (Key &key : key_map_) {
       key = Key_Inactive;
     }
+    active_addrs_.clear();
+    report_aggregate_.clear();
   }
 
   /// Returns an iterator for use in range-based for loops:
   ///
   ///   for (Key key : live_keys.all()) {...}
-  KeyMap &all() {
+  ///
+  /// The entries are read-only: changing one directly would leave the active
+  /// addresses and the report aggregate out of date.
+  const KeyMap &all() const {
     return key_map_;
   }
 
+  /// Returns a bitfield of the addresses of active entries (those that are
+  /// neither `Key_Inactive` nor `Key_Masked`), for iterating over only the keys
+  /// that are active:
+  ///
+  ///   for (KeyAddr key_addr : live_keys.activeAddrs()) {...}
+  const KeyAddrBitfield &activeAddrs() const {
+    return active_addrs_;
+  }
+
+  /// Returns the combined HID report contributions of all active entries.
+  KeyboardReportAggregate &reportAggregate() {
+    return report_aggregate_;
+  }
+
+  static constexpr bool isActive(Key key) {
+    return key != Key_Inactive && key != Key_Masked;
+  }
+
  private:
   KeyMap key_map_;
+  KeyAddrBitfield active_addrs_;
+  KeyboardReportAggregate report_aggregate_;
   mutable Key dummy_{0, 0};
+
+  // Replace an entry, updating the active entries bitfield and the report
+  // aggregate with the difference between the old and new values.
+  void update(KeyAddr key_addr, Key key) {
+    Key &entry = key_map_[key_addr];
+    if (isActive(entry))
+      report_aggregate_.remove(entry);
+    entry = key;
+    if (isActive(key)) {
+      active_addrs_.set(key_addr);
+      report_aggregate_.add(key);
+    } else {
+      active_addrs_.clear(key_addr);
+    }
+  }
 };
 
 extern LiveKeys live_keys;
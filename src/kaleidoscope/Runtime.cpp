@@ -27,6 +27,7 @@
 
 #include "kaleidoscope/KeyAddr.h"                   // for KeyAddr, MatrixAddr, MatrixAddr...
 #include "kaleidoscope/KeyEvent.h"                  // for KeyEvent
+#include "kaleidoscope/KeyboardReportAggregate.h"   // for KeyboardReportAggregate
 #include "kaleidoscope/LiveKeys.h"                  // for LiveKeys, live_keys
 #include "kaleidoscope/device/device.h"             // for Base<>::HID, VirtualProps::HID
 #include "kaleidoscope/driver/hid/base/Keyboard.h"  // for Keyboard
@@ -215,29 +216,62 @@ void Runtime_::prepareKeyboardReport(const KeyEvent &event) {
   // before building the new report, start clean
   device().hid().keyboard().releaseAllKeys();
 
-  // Build report from composite keymap cache. This can be much more efficient
-  // with a bitfield. What we should be doing here is going through the array
-  // and checking for HID values (Keyboard, Consumer, System) and directly
-  // adding them to their respective reports. This comes before the old plugin
-  // hooks are called for the new event so that the report will be full complete
-  // except for that new event.
-  for (KeyAddr key_addr : KeyAddr::all()) {
-    // Skip this event's key addr; we will deal with that later. This is most
-    // important in the case of a key release, because we can't safely remove
-    // any keycode(s) added to the report later.
-    if (key_addr == event.addr)
-      continue;
+  // The report is built from the contents of `live_keys`, except for this
+  // event's key addr; we will deal with that later. This is most important in
+  // the case of a key release, because we can't safely remove any keycode(s)
+  // added to the report later.
+  //
+  // If no plugin needs to see each active key via `onAddToReport()`, we can
+  // copy the report aggregate that `live_keys` maintains, which costs the same
+  // no matter how many keys are held. We temporarily take this event's key out
+  // of it, and if that can't be done exactly, we fall back to visiting each
+  // active key instead, which also rebuilds the aggregate.
+  KeyboardReportAggregate &aggregate = live_keys.reportAggregate();
+  if (!Hooks::onAddToReportIsImplemented() && aggregate.isValid()) {
+    Key event_entry = live_keys[event.addr];
+    if (!LiveKeys::isActive(event_entry)) {
+      copyToReport(aggregate);
+      return;
+    }
+    if (aggregate.remove(event_entry)) {
+      copyToReport(aggregate);
+      aggregate.add(event_entry);
+      return;
+    }
+  }
 
+  aggregate.clear();
+  for (KeyAddr key_addr : live_keys.activeAddrs()) {
     Key key = live_keys[key_addr];
+    aggregate.add(key);
 
-    // If the key is idle or masked, we can ignore it.
-    if (key == Key_Inactive || key == Key_Masked)
+    if (key_addr == event.addr)
       continue;
 
     addToReport(key);
   }
 }
 
+// ----------------------------------------------------------------------------
+void Runtime_::copyToReport(const KeyboardReportAggregate &aggregate) {
+  for (uint8_t i = 0; i < KeyboardReportAggregate::keycode_bytes; ++i) {
+    uint8_t block = aggregate.keycodeBlock(i);
+    for (uint8_t bit = 0; block != 0; ++bit, block >>= 1) {
+      if (block & 1)
+        hid().keyboard().pressRawKey(Key(8 * i + bit, KEY_FLAGS));
+    }
+  }
+  for (uint8_t i = 0; i < KeyboardReportAggregate::modifier_count; ++i) {
+    if (aggregate.isModifierActive(i))
+      hid().keyboard().pressRawKey(Key(HID_KEYBOARD_FIRST_MODIFIER + i, KEY_FLAGS));
+  }
+  for (uint8_t i = 0; i < KeyboardReportAggregate::max_consumer_codes; ++i) {
+    Key key = aggregate.consumerKey(i);
+    if (key != Key_NoKey)
+      hid().keyboard().pressConsumerControl(key);
+  }
+}
+
 // ----------------------------------------------------------------------------
 void Runtime_::addToReport(Key key) {
   // First, call any relevant plugin handlers, to give them a chance to add
@@ -24,15 +24,16 @@
 
 #include <stdint.h>  // for uint32_t
 
-#include "kaleidoscope/KeyAddr.h"               // for KeyAddr
-#include "kaleidoscope/KeyEvent.h"              // for KeyEvent
-#include "kaleidoscope/LiveKeys.h"              // for LiveKeys, live_keys
-#include "kaleidoscope/device/device.h"         // for Device
-#include "kaleidoscope/event_handler_result.h"  // for EventHandlerResult
-#include "kaleidoscope/hooks.h"                 // for Hooks
-#include "kaleidoscope/key_defs.h"              // for Key, Key_Transparent
-#include "kaleidoscope/layers.h"                // for Layer, Layer_
-#include "kaleidoscope_internal/device.h"       // for device
+#include "kaleidoscope/KeyAddr.h"                  // for KeyAddr
+#include "kaleidoscope/KeyEvent.h"                 // for KeyEvent
+#include "kaleidoscope/KeyboardReportAggregate.h"  // for KeyboardReportAggregate
+#include "kaleidoscope/LiveKeys.h"                 // for LiveKeys, live_keys
+#include "kaleidoscope/device/device.h"            // for Device
+#include "kaleidoscope/event_handler_result.h"     // for EventHandlerResult
+#include "kaleidoscope/hooks.h"                    // for Hooks
+#include "kaleidoscope/key_defs.h"                 // for Key, Key_Transparent
+#include "kaleidoscope/layers.h"                   // for Layer, Layer_
+#include "kaleidoscope_internal/device.h"          // for device
 
 namespace kaleidoscope {
 
@@ -89,6 +90,8 @@ class Runtime_ {
   }
 
   void rebootBootloader() {
+    // Don't lose commits that are still deferred
+    device().storage().flush();
     device().rebootBootloader();
   }
 
@@ -178,6 +181,10 @@ class Runtime_ {
    * already responded to the new event that triggered the forthcoming report),
    * then populates the new report based on the values stored in the `live_keys`
    * state array.
+   *
+   * If no plugin implements `onAddToReport()`, the report is copied from the
+   * aggregate that `live_keys` keeps up to date; otherwise `addToReport()` is
+   * called for each active key, as plugins expect.
    */
   void prepareKeyboardReport(const KeyEvent &event);
 
@@ -190,6 +197,14 @@ class Runtime_ {
    */
   void addToReport(Key key);
 
+  /** Add the contents of a report aggregate to the USB HID report(s)
+   *
+   * This method is used by `prepareKeyboardReport()` to copy the combined
+   * contributions of all active keys to the Keyboard & Consumer Control HID
+   * reports without calling `addToReport()` for each of them.
+   */
+  void copyToReport(const KeyboardReportAggregate &aggregate);
+
   /** Send the new USB HID report(s)
    *
    * This method is called by `handleKeyEvent()` after `prepareKeyboardReport()`
@@ -0,0 +1,157 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2013-2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>  // for pgm_read_byte, pgm_read_word
+#include <stdint.h>   // for uint8_t, uint16_t
+
+#include "kaleidoscope/KeyAddr.h"          // for KeyAddr
+#include "kaleidoscope/KeyAddrBitfield.h"  // for KeyAddrBitfield
+#include "kaleidoscope/key_defs.h"         // for Key, Key_NoKey, Key_Transparent
+
+namespace kaleidoscope {
+namespace sparse_keymap {
+
+// A sparse layer stores the one key that most of the layer is made of (its
+// "fill" key: either `Key_Transparent` or `Key_NoKey`), a `KeyAddrBitfield` of
+// the keys that differ from it, and those keys packed in `KeyAddr` order. The
+// position of a key in the packed list is the number of bits set before its own
+// in the bitfield, which is what `KeyAddrBitfield::ordinal()` computes.
+//
+// The same encoding is used for keymaps compiled into PROGMEM by `KEYMAPS()`
+// (when `KALEIDOSCOPE_SPARSE_KEYMAPS` is defined), and for custom layers stored
+// by EEPROM-Keymap.
+
+// Returns the fill key for the `count` keys of a layer: `Key_NoKey` if there are
+// more of those than of `Key_Transparent`, and `Key_Transparent` otherwise.
+constexpr Key fillKey(Key const *keys, uint16_t count) {
+  uint16_t transparent = 0;
+  uint16_t blank       = 0;
+  for (uint16_t i = 0; i < count; ++i) {
+    if (keys[i] == Key_Transparent)
+      ++transparent;
+    if (keys[i] == Key_NoKey)
+      ++blank;
+  }
+  return (blank > transparent) ? Key_NoKey : Key_Transparent;
+}
+
+// Returns the number of keys of a layer that differ from its fill key.
+constexpr uint16_t countKeys(Key const *keys, uint16_t count) {
+  Key fill       = fillKey(keys, count);
+  uint16_t total = 0;
+  for (uint16_t i = 0; i < count; ++i) {
+    if (keys[i] != fill)
+      ++total;
+  }
+  return total;
+}
+
+// Returns the number of keys that differ from their layer's fill key, in a whole
+// keymap.
+template<uint8_t _layer_count, uint16_t _layer_size>
+constexpr uint16_t countKeys(Key const (&keymap)[_layer_count][_layer_size]) {
+  uint16_t total = 0;
+  for (uint8_t layer = 0; layer < _layer_count; ++layer)
+    total += countKeys(keymap[layer], _layer_size);
+  return total;
+}
+
+// Returns the number of bits set in the low `count` bits of `block`.
+inline uint8_t popcountBelow(uint8_t block, uint8_t count) {
+  return __builtin_popcount(block & ~(0xff << count));
+}
+
+// The index of a sparse layer in PROGMEM. On top of the bitfield and the fill
+// key, it holds the number of bits set in the bitfield before each of its
+// blocks, so that finding a key's position in the packed list takes a single
+// `popcount`, and the position of the layer's first key in the list shared by
+// all layers.
+struct Layer {
+  KeyAddrBitfield present;
+  uint8_t ordinals[KeyAddrBitfield::total_blocks] = {};
+  uint16_t first                                  = 0;
+  Key fill                                        = Key_Transparent;
+
+  // Looks up a key, with `this` and `keys` both in PROGMEM.
+  Key lookup(Key const *keys, KeyAddr key_addr) const {
+    uint8_t block_index = KeyAddrBitfield::blockIndex(key_addr);
+    uint8_t bit_index   = KeyAddrBitfield::bitIndex(key_addr);
+    uint8_t block       = pgm_read_byte(&present.block(block_index));
+
+    if (!bitRead(block, bit_index))
+      return fill.readFromProgmem();
+
+    uint16_t index = pgm_read_word(&first) +
+                     pgm_read_byte(&ordinals[block_index]) +
+                     popcountBelow(block, bit_index);
+    return keys[index].readFromProgmem();
+  }
+};
+
+/// A whole keymap, in the sparse encoding
+///
+/// This is computed at compile time from `keymaps_linear` by `KEYMAPS()`, when
+/// the sketch defines `KALEIDOSCOPE_SPARSE_KEYMAPS`, and stored in PROGMEM in
+/// its place.
+template<uint8_t _layer_count, uint16_t _key_count>
+struct Table {
+  static_assert(_layer_count > 0, "KEYMAPS() must define at least one layer");
+
+  Layer layers[_layer_count];
+  // Keep at least one element, so a keymap made only of fill keys still works.
+  Key keys[_key_count > 0 ? _key_count : 1];
+
+  template<uint16_t _layer_size>
+  constexpr explicit Table(Key const (&keymap)[_layer_count][_layer_size])
+    : layers{}, keys{} {
+    static_assert(_layer_size <= KeyAddrBitfield::size,
+                  "A keymap layer has more keys than the device");
+
+    uint16_t k = 0;
+    for (uint8_t l = 0; l < _layer_count; ++l) {
+      Key fill        = fillKey(keymap[l], _layer_size);
+      layers[l].fill  = fill;
+      layers[l].first = k;
+
+      uint8_t count = 0;
+      for (uint16_t i = 0; i < _layer_size; ++i) {
+        if (i % KeyAddrBitfield::block_size == 0)
+          layers[l].ordinals[i / KeyAddrBitfield::block_size] = count;
+        if (keymap[l][i] != fill) {
+          layers[l].present.set(KeyAddr(uint8_t(i)));
+          keys[k++] = keymap[l][i];
+          ++count;
+        }
+      }
+    }
+  }
+
+  // Looks up a key, with `this` in PROGMEM.
+  Key lookup(uint8_t layer, KeyAddr key_addr) const {
+    return layers[layer].lookup(keys, key_addr);
+  }
+};
+
+}  // namespace sparse_keymap
+}  // namespace kaleidoscope
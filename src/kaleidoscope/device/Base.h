@@ -331,6 +331,21 @@ class Base {
   void actOnMatrixScan(void) {
     key_scanner_.actOnMatrixScan();
   }
+  /**
+   * Set the debounce time of the key scanner, in milliseconds.
+   *
+   * Key scanners that don't debounce (or leave it to the hardware) ignore this.
+   */
+  void setDebounceTime(uint8_t ms) {
+    key_scanner_.setDebounceTime(ms);
+  }
+  /**
+   * Returns the debounce time of the key scanner, in milliseconds, or 0 if it
+   * doesn't debounce.
+   */
+  uint8_t debounceTime() {
+    return key_scanner_.debounceTime();
+  }
   /** @} */
 
   /** @defgroup kaleidoscope_hardware_reattach Kaleidoscope::Hardware/Attach & Detach
@@ -423,6 +438,19 @@ class Base {
   uint8_t pressedKeyswitchCount() {
     return key_scanner_.pressedKeyswitchCount();
   }
+  /**
+   * Call `callback(key_addr)` for every key switch that is currently pressed.
+   *
+   * This is a lot cheaper than calling @ref isKeyswitchPressed for every key
+   * on the keyboard, because the key scanners skip over released keys a whole
+   * row at a time.
+   *
+   * @param callback is a function or lambda taking a `KeyAddr`.
+   */
+  template<typename _Callback>
+  void forEachPressedKeyswitch(_Callback callback) {
+    key_scanner_.forEachPressedKeyswitch(callback);
+  }
 
   /**
    * Check if a key was pressed at a given position on the previous scan
@@ -581,9 +609,12 @@ class Base {
   void initSerial() {}
 
   /**
-   * Called between processing cycles, can be used for power management
+   * Called between processing cycles, can be used for power management, and
+   * for storage drivers' background work
    */
-  void betweenCycles() {}
+  void betweenCycles() {
+    storage_.betweenCycles();
+  }
 
   /** @} */
 
@@ -32,6 +32,7 @@
 // From system:
 #include <stdint.h>      // for uint8_t, uint16_t
 #include <stdlib.h>      // for exit, size_t
+#include <string.h>      // for memcmp
 #include <virtual_io.h>  // for getLineOfInput, isInte...
 #include <sstream>       // for operator<<, string
 #include <string>        // for operator==, char_traits
@@ -41,7 +42,7 @@
 #include "kaleidoscope/device/virtual/DefaultHIDReportConsumer.h"  // for DefaultHIDReportConsumer
 #include "kaleidoscope/device/virtual/Logging.h"                   // for log_error, logging
 #include "kaleidoscope/key_defs.h"                                 // for Key_NoKey
-#include "kaleidoscope/keyswitch_state.h"                          // for IS_PRESSED, WAS_PRESSED
+#include "kaleidoscope/keyswitch_state.h"                          // for IS_PRESSED, WAS_PRESSED, keyToggledOff, keyToggledOn
 
 // FIXME: This relates to virtual/cores/arduino/EEPROM.h.
 //        EEPROM static data must be defined here as only
@@ -266,7 +267,7 @@ void VirtualKeyScanner::actOnMatrixScan() {
       break;
     }
 
-    if (key_state != 0)
+    if (keyToggledOn(key_state) || keyToggledOff(key_state))
       handleKeyswitchEvent(Key_NoKey, key_addr, key_state);
     keystates_prev_[key_addr.toInt()] = keystates_[key_addr.toInt()];
 
@@ -321,9 +322,7 @@ bool VirtualKeyScanner::anythingHeld() {
 //##############################################################################
 
 void VirtualLEDDriver::setup() {
-  for (int i = 0; i < led_count; i++) {
-    led_states_[i] = CRGB(0, 0, 0);
-  }
+  fill(CRGB(0, 0, 0));
 }
 
 void VirtualLEDDriver::syncLeds() {
@@ -338,6 +337,8 @@ void VirtualLEDDriver::syncLeds() {
 
   ss << std::endl;
   logLEDStates(ss.str());
+
+  clearDirty();
 }
 
 void VirtualLEDDriver::setCrgbAt(uint8_t i, cRGB color) {
@@ -345,7 +346,7 @@ void VirtualLEDDriver::setCrgbAt(uint8_t i, cRGB color) {
     log_error("Virtual::setCrgbAt: Index %d out of bounds\n", i);
     return;
   }
-  led_states_[i] = color;
+  storeColor(led_states_[i], i, color);
 }
 
 cRGB VirtualLEDDriver::getCrgbAt(uint8_t i) const {
@@ -356,6 +357,23 @@ cRGB VirtualLEDDriver::getCrgbAt(uint8_t i) const {
   return led_states_[i];
 }
 
+void VirtualLEDDriver::blit(const cRGB *colors, uint8_t first, uint8_t count) {
+  if (static_cast<int>(first) + count > static_cast<int>(led_count)) {
+    log_error("Virtual::blit: Range %d+%d out of bounds\n", first, count);
+    return;
+  }
+  if (memcmp(&led_states_[first], colors, count * sizeof(cRGB)) == 0)
+    return;
+
+  for (uint8_t i = 0; i < count; i++)
+    storeColor(led_states_[first + i], first + i, colors[i]);
+}
+
+void VirtualLEDDriver::fill(cRGB color) {
+  for (uint8_t i = 0; i < led_count; i++)
+    storeColor(led_states_[i], i, color);
+}
+
 }  // namespace virt
 }  // namespace device
 
@@ -75,6 +75,13 @@ class VirtualKeyScanner
 
   uint8_t pressedKeyswitchCount() const;
   bool isKeyswitchPressed(KeyAddr key_addr) const;
+  template<typename _Callback>
+  void forEachPressedKeyswitch(_Callback callback) const {
+    for (auto key_addr : KeyAddr::all()) {
+      if (isKeyswitchPressed(key_addr))
+        callback(key_addr);
+    }
+  }
 
   uint8_t previousPressedKeyswitchCount() const;
   bool wasKeyswitchPressed(KeyAddr key_addr) const;
@@ -111,6 +118,8 @@ class VirtualLEDDriver
   void syncLeds();
   void setCrgbAt(uint8_t i, cRGB color);
   cRGB getCrgbAt(uint8_t i) const;
+  void blit(const cRGB *colors, uint8_t first, uint8_t count);
+  void fill(cRGB color);
 
  private:
   cRGB led_states_[led_count];  // NOLINT(runtime/arrays)
@@ -25,9 +25,10 @@
 
 #include <stdint.h>  // for uint16_t, uint8_t
 
-#include "kaleidoscope/device/avr/pins_and_ports.h"  // IWYU pragma: keep
-#include "kaleidoscope/driver/keyscanner/Base.h"     // for BaseProps
-#include "kaleidoscope/driver/keyscanner/None.h"     // for None
+#include "kaleidoscope/device/avr/pins_and_ports.h"    // IWYU pragma: keep
+#include "kaleidoscope/driver/keyscanner/Base.h"       // for BaseProps
+#include "kaleidoscope/driver/keyscanner/Debouncer.h"  // for SymmetricDebouncer
+#include "kaleidoscope/driver/keyscanner/None.h"       // for None
 
 #ifndef KALEIDOSCOPE_VIRTUAL_BUILD
 #include <avr/wdt.h>
@@ -41,6 +42,14 @@ struct ATmegaProps : kaleidoscope::driver::keyscanner::BaseProps {
   static const uint16_t keyscan_interval = 1500;
   typedef uint16_t RowState;
 
+  /*
+   * Four samples at the default scan interval, which is what this key scanner
+   * has always used. Boards may pick a different debouncer, or debounce time.
+   */
+  static constexpr uint8_t debounce_ms = 5;
+  template<typename _Props>
+  using Debouncer = kaleidoscope::driver::keyscanner::SymmetricDebouncer<_Props>;
+
   /*
    * The following two lines declare an empty array. Both of these must be
    * shadowed by the descendant keyscanner description class.
@@ -78,10 +87,11 @@ class ATmega : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
     }
 
     setScanCycleTime(_KeyScannerProps::keyscan_interval);
+    setDebounceTime(_KeyScannerProps::debounce_ms);
   }
 
 
-  /* setScanCycleTime takes a value of between 0 and 8192. This corresponds (roughly) to the number of microseconds to wait between scanning the key matrix. Our debouncing algorithm does four checks before deciding that a result is valid. Most normal mechanical switches specify a 5ms debounce period. On an ATMega32U4, 1700 gets you about 5ms of debouncing.
+  /* setScanCycleTime takes a value of between 0 and 8192. This corresponds (roughly) to the number of microseconds to wait between scanning the key matrix. The debouncer turns its debounce time into a number of scans based on the interval the key scanner was set up with, so changing it at runtime does not rescale the debounce time.
 
   Because keycanning is triggered by an interrupt but not run in that interrupt, the actual amount of time between scans is prone to a little bit of jitter.
 
@@ -98,7 +108,7 @@ class ATmega : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
   }
 
   __attribute__((optimize(2))) void readMatrix(void) {
-    typename _KeyScannerProps::RowState any_debounced_changes = 0;
+    uint8_t now = millis();
 
     for (uint8_t current_row = 0; current_row < _KeyScannerProps::matrix_rows; current_row++) {
       OUTPUT_TOGGLE(_KeyScannerProps::matrix_row_pins[current_row]);
@@ -106,13 +116,8 @@ class ATmega : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
 
       OUTPUT_TOGGLE(_KeyScannerProps::matrix_row_pins[current_row]);
 
-      any_debounced_changes |= debounce(hot_pins, &matrix_state_[current_row].debouncer);
-
-      if (any_debounced_changes) {
-        for (uint8_t current_row = 0; current_row < _KeyScannerProps::matrix_rows; current_row++) {
-          matrix_state_[current_row].current = matrix_state_[current_row].debouncer.debounced_state;
-        }
-      }
+      if (debouncer_.debounce(current_row, hot_pins, now))
+        matrix_state_[current_row].current = debouncer_.state(current_row);
     }
   }
   void scanMatrix() {
@@ -125,11 +130,12 @@ class ATmega : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
 
   void __attribute__((optimize(2))) actOnMatrixScan() {
     for (uint8_t row = 0; row < _KeyScannerProps::matrix_rows; row++) {
-      for (uint8_t col = 0; col < _KeyScannerProps::matrix_columns; col++) {
+      // Only keys that toggled on or off make an event, so we only visit those.
+      typename _KeyScannerProps::RowState changes = matrix_state_[row].previous ^ matrix_state_[row].current;
+      for (; changes != 0; changes &= changes - 1) {
+        uint8_t col      = __builtin_ctzl(changes);
         uint8_t keyState = (bitRead(matrix_state_[row].previous, col) << 0) | (bitRead(matrix_state_[row].current, col) << 1);
-        if (keyState) {
-          ThisType::handleKeyswitchEvent(Key_NoKey, typename _KeyScannerProps::KeyAddr(row, col), keyState);
-        }
+        ThisType::handleKeyswitchEvent(Key_NoKey, typename _KeyScannerProps::KeyAddr(row, col), keyState);
       }
       matrix_state_[row].previous = matrix_state_[row].current;
     }
@@ -146,6 +152,13 @@ class ATmega : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
   bool isKeyswitchPressed(typename _KeyScannerProps::KeyAddr key_addr) {
     return (bitRead(matrix_state_[key_addr.row()].current, key_addr.col()) != 0);
   }
+  template<typename _Callback>
+  void forEachPressedKeyswitch(_Callback callback) {
+    for (uint8_t row = 0; row < _KeyScannerProps::matrix_rows; row++) {
+      for (typename _KeyScannerProps::RowState pressed = matrix_state_[row].current; pressed != 0; pressed &= pressed - 1)
+        callback(typename _KeyScannerProps::KeyAddr(row, __builtin_ctzl(pressed)));
+    }
+  }
 
   uint8_t previousPressedKeyswitchCount() {
     uint8_t count = 0;
@@ -160,31 +173,26 @@ class ATmega : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
                     key_addr.col()) != 0);
   }
 
+  void setDebounceTime(uint8_t ms) {
+    debouncer_.setDebounceTime(ms, _KeyScannerProps::keyscan_interval);
+  }
+  uint8_t debounceTime() {
+    return debouncer_.debounceTime();
+  }
+
   bool do_scan_;
 
 
  protected:
-  /*
-    each of these variables are storing the state for a row of keys
-
-    so for key 0, the counter is represented by db0[0] and db1[0]
-    and the state in debounced_state[0].
-  */
-  struct debounce_t {
-    typename _KeyScannerProps::RowState db0;              // counter bit 0
-    typename _KeyScannerProps::RowState db1;              // counter bit 1
-    typename _KeyScannerProps::RowState debounced_state;  // debounced state
-  };
-
   struct row_state_t {
     typename _KeyScannerProps::RowState previous;
     typename _KeyScannerProps::RowState current;
-    debounce_t debouncer;
   };
 
  private:
   typedef _KeyScannerProps KeyScannerProps_;
   static row_state_t matrix_state_[_KeyScannerProps::matrix_rows];
+  typename _KeyScannerProps::template Debouncer<_KeyScannerProps> debouncer_;
 
   /*
    * This function has loop unrolling disabled on purpose: we want to give the
@@ -210,30 +218,6 @@ class ATmega : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
 
     return hot_pins;
   }
-
-  static inline typename _KeyScannerProps::RowState debounce(
-    typename _KeyScannerProps::RowState sample, debounce_t *debouncer) {
-    typename _KeyScannerProps::RowState delta, changes;
-
-    // Use xor to detect changes from last stable state:
-    // if a key has changed, it's bit will be 1, otherwise 0
-    delta = sample ^ debouncer->debounced_state;
-
-    // Increment counters and reset any unchanged bits:
-    // increment bit 1 for all changed keys
-    debouncer->db1 = ((debouncer->db1) ^ (debouncer->db0)) & delta;
-    // increment bit 0 for all changed keys
-    debouncer->db0 = ~(debouncer->db0) & delta;
-
-    // Calculate returned change set: if delta is still true
-    // and the counter has wrapped back to 0, the key is changed.
-
-    changes = ~(~delta | (debouncer->db0) | (debouncer->db1));
-    // Update state: in this case use xor to flip any bit that is true in changes.
-    debouncer->debounced_state ^= changes;
-
-    return changes;
-  }
 };
 #else   // ifndef KALEIDOSCOPE_VIRTUAL_BUILD
 template<typename _KeyScannerProps>
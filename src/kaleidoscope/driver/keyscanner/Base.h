@@ -60,6 +60,8 @@ class Base {
   bool isKeyswitchPressed(KeyAddr key_addr) {
     return false;
   }
+  template<typename _Callback>
+  void forEachPressedKeyswitch(_Callback callback) {}
 
   uint8_t previousPressedKeyswitchCount() {
     return 0;
@@ -67,6 +69,11 @@ class Base {
   bool wasKeyswitchPressed(KeyAddr key_addr) {
     return false;
   }
+
+  void setDebounceTime(uint8_t ms) {}
+  uint8_t debounceTime() {
+    return 0;
+  }
 };
 
 }  // namespace keyscanner
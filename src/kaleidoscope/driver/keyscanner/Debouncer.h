@@ -0,0 +1,245 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2013-2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>  // for uint8_t, uint32_t
+
+namespace kaleidoscope {
+namespace driver {
+namespace keyscanner {
+
+// The debouncers below are shared by the matrix key scanners. Each of them
+// works on a whole row of samples at a time (one bit per key, in a `RowState`),
+// and returns the set of keys whose debounced state has changed with that
+// sample. They all have the same interface:
+//
+// - `setDebounceTime(ms, scan_interval_micros)` sets the debounce time; the
+//   sample-counting debouncers turn it into a number of scans.
+// - `debounceTime()` returns the debounce time, in milliseconds, as it is in
+//   effect: the sample-counting debouncers can count at most seven scans, so a
+//   longer time is cut down to what those cover.
+// - `debounce(row, sample, now)` feeds a new sample of `row` to the debouncer,
+//   and returns the keys that changed state. `now` is the time of the sample in
+//   milliseconds; only the low byte is used.
+// - `state(row)` returns the debounced state of `row`.
+//
+// A key scanner's props select one of them with a `Debouncer` alias template,
+// and its default debounce time with `debounce_ms`.
+
+namespace debounce {
+
+// A bit-sliced counter, one per bit of a row: `plane[i]` holds bit `i` of every
+// key's count. The counters can count up to `max_count`.
+template<typename _RowState>
+struct VerticalCounter {
+  static constexpr uint8_t planes    = 3;
+  static constexpr uint8_t max_count = (1 << planes) - 1;
+
+  _RowState plane[planes];
+
+  // Increments the counters of the keys in `keys`, and resets every other one.
+  // Returns the keys whose counters have reached `count`, and resets those too.
+  _RowState increment(_RowState keys, uint8_t count) {
+    _RowState carry   = keys;
+    _RowState reached = keys;
+    for (uint8_t i = 0; i < planes; i++) {
+      _RowState bits = plane[i];
+      plane[i]       = (bits ^ carry) & keys;
+      carry &= bits;
+      reached &= (count & (1 << i)) ? plane[i] : ~plane[i];
+    }
+    for (uint8_t i = 0; i < planes; i++)
+      plane[i] &= ~reached;
+    return reached;
+  }
+};
+
+// Returns the number of consecutive scans that cover `ms` milliseconds, which is
+// at least one (no debouncing at all), and at most `max_count`.
+inline uint8_t samplesFor(uint8_t ms, uint32_t scan_interval_micros) {
+  uint32_t samples = (ms * 1000UL + scan_interval_micros - 1) / scan_interval_micros;
+  if (samples < 1)
+    return 1;
+  if (samples > VerticalCounter<uint8_t>::max_count)
+    return VerticalCounter<uint8_t>::max_count;
+  return samples;
+}
+
+// Returns the time `samples` scans cover, if that falls short of `ms` because
+// the count was capped, or `ms` otherwise.
+inline uint8_t effectiveMs(uint8_t ms, uint8_t samples, uint32_t scan_interval_micros) {
+  uint32_t covered = samples * scan_interval_micros / 1000;
+  return covered < ms ? covered : ms;
+}
+
+}  // namespace debounce
+
+/// Symmetric N-sample debouncer
+///
+/// A key changes state once it has been sampled in the new state as many times
+/// in a row as the debounce time covers, for presses and releases alike. This
+/// is what the key scanners have always done (with a fixed four samples), and
+/// it is robust against both contact bounce and noise, at the cost of delaying
+/// every event by the full debounce time.
+template<typename _KeyScannerProps>
+class SymmetricDebouncer {
+ public:
+  typedef typename _KeyScannerProps::RowState RowState;
+
+  void setDebounceTime(uint8_t ms, uint32_t scan_interval_micros) {
+    samples_     = debounce::samplesFor(ms, scan_interval_micros);
+    debounce_ms_ = debounce::effectiveMs(ms, samples_, scan_interval_micros);
+  }
+  uint8_t debounceTime() const {
+    return debounce_ms_;
+  }
+
+  RowState debounce(uint8_t row, RowState sample, uint8_t now) {
+    row_t &r         = rows_[row];
+    RowState changes = r.counter.increment(sample ^ r.state, samples_);
+    r.state ^= changes;
+    return changes;
+  }
+
+  RowState state(uint8_t row) const {
+    return rows_[row].state;
+  }
+
+ private:
+  struct row_t {
+    debounce::VerticalCounter<RowState> counter;
+    RowState state;
+  };
+
+  row_t rows_[_KeyScannerProps::matrix_rows] = {};
+  uint8_t debounce_ms_                       = 0;
+  uint8_t samples_                           = 1;
+};
+
+/// Eager-press, deferred-release debouncer
+///
+/// A press is reported as soon as it is sampled, and a release only once the
+/// key has been sampled released as many times in a row as the debounce time
+/// covers. Contact bounce right after a press shows up as short releases, which
+/// never last long enough to be reported, so presses have no added latency,
+/// and only releases are delayed. A single released sample is never taken as a
+/// release, unless the debounce time is zero.
+template<typename _KeyScannerProps>
+class EagerPressDebouncer {
+ public:
+  typedef typename _KeyScannerProps::RowState RowState;
+
+  void setDebounceTime(uint8_t ms, uint32_t scan_interval_micros) {
+    samples_ = debounce::samplesFor(ms, scan_interval_micros);
+    if (ms != 0 && samples_ < 2)
+      samples_ = 2;
+    debounce_ms_ = debounce::effectiveMs(ms, samples_, scan_interval_micros);
+  }
+  uint8_t debounceTime() const {
+    return debounce_ms_;
+  }
+
+  RowState debounce(uint8_t row, RowState sample, uint8_t now) {
+    row_t &r          = rows_[row];
+    RowState pressed  = sample & ~r.state;
+    RowState released = r.counter.increment(~sample & r.state, samples_);
+    RowState changes  = pressed | released;
+    r.state ^= changes;
+    return changes;
+  }
+
+  RowState state(uint8_t row) const {
+    return rows_[row].state;
+  }
+
+ private:
+  struct row_t {
+    debounce::VerticalCounter<RowState> counter;
+    RowState state;
+  };
+
+  row_t rows_[_KeyScannerProps::matrix_rows] = {};
+  uint8_t debounce_ms_                       = 0;
+  uint8_t samples_                           = 1;
+};
+
+/// Per-key timestamp debouncer
+///
+/// Every change is reported as soon as it is sampled, after which the key is
+/// locked in its new state until the debounce time has passed. Both presses and
+/// releases are reported without delay, and the debounce time is independent
+/// of the scan interval, but it needs a timestamp for every key, and noise on
+/// a line is reported as a short key press.
+template<typename _KeyScannerProps>
+class TimestampDebouncer {
+ public:
+  typedef typename _KeyScannerProps::RowState RowState;
+
+  void setDebounceTime(uint8_t ms, uint32_t scan_interval_micros) {
+    debounce_ms_ = ms;
+  }
+  uint8_t debounceTime() const {
+    return debounce_ms_;
+  }
+
+  RowState debounce(uint8_t row, RowState sample, uint8_t now) {
+    row_t &r = rows_[row];
+
+    // Only the locked keys need their timestamps checked, one by one.
+    for (RowState locked = r.locked; locked != 0; locked &= locked - 1) {
+      uint8_t col = __builtin_ctzl(locked);
+      if (uint8_t(now - r.changed_at[col]) >= debounce_ms_)
+        r.locked &= ~(RowState(1) << col);
+    }
+
+    RowState changes = (sample ^ r.state) & ~r.locked;
+    if (changes == 0)
+      return 0;
+
+    r.state ^= changes;
+    if (debounce_ms_ != 0) {
+      r.locked |= changes;
+      for (RowState changed = changes; changed != 0; changed &= changed - 1)
+        r.changed_at[__builtin_ctzl(changed)] = now;
+    }
+    return changes;
+  }
+
+  RowState state(uint8_t row) const {
+    return rows_[row].state;
+  }
+
+ private:
+  struct row_t {
+    RowState state;
+    RowState locked;
+    uint8_t changed_at[_KeyScannerProps::matrix_columns];
+  };
+
+  row_t rows_[_KeyScannerProps::matrix_rows] = {};
+  uint8_t debounce_ms_                       = 0;
+};
+
+}  // namespace keyscanner
+}  // namespace driver
+}  // namespace kaleidoscope
@@ -24,6 +24,7 @@
 
 #ifdef ARDUINO_ARCH_NRF52
 #include "kaleidoscope/driver/keyscanner/Base.h"
+#include "kaleidoscope/driver/keyscanner/Debouncer.h"
 #include "kaleidoscope/keyswitch_state.h"
 #include "FreeRTOS.h"
 #include "queue.h"
@@ -42,6 +43,13 @@ struct NRF52KeyScannerProps : kaleidoscope::driver::keyscanner::BaseProps {
   /// @brief Type used to store the state of a matrix row
   typedef uint16_t RowState;
 
+  /// @brief Default debounce time in milliseconds (three scans)
+  static constexpr uint8_t debounce_ms = 4;
+
+  /// @brief The debouncer, shadowed by boards that want a different one
+  template<typename _P>
+  using Debouncer = kaleidoscope::driver::keyscanner::SymmetricDebouncer<_P>;
+
   /*
    * The following two arrays must be shadowed by the descendant keyscanner
    * description class to define the actual matrix pins.
@@ -186,6 +194,8 @@ class NRF52KeyScanner : public Base<_Props>, public TimerHandlerInterface {
       pinMode(_Props::matrix_col_pins[i], INPUT_PULLUP);
     }
 
+    setDebounceTime(_Props::debounce_ms);
+
     // Configure hardware timer for scanning
     NRF_TIMER1->MODE      = TIMER_MODE_MODE_Timer;            // Set timer mode
     NRF_TIMER1->BITMODE   = TIMER_BITMODE_BITMODE_32Bit;      // 32-bit timer
@@ -242,6 +252,15 @@ class NRF52KeyScanner : public Base<_Props>, public TimerHandlerInterface {
     return bitRead(matrix_state_[key_addr.row()].current, key_addr.col());
   }
 
+  /// @brief Call `callback(key_addr)` for every pressed key
+  template<typename _Callback>
+  void forEachPressedKeyswitch(_Callback callback) {
+    for (uint8_t row = 0; row < _Props::matrix_rows; row++) {
+      for (typename _Props::RowState pressed = matrix_state_[row].current; pressed != 0; pressed &= pressed - 1)
+        callback(KeyAddr(row, __builtin_ctz(pressed)));
+    }
+  }
+
   /// @brief Check if there are any events queued in the buffer
   /// @return true if there are events waiting to be processed
   bool hasQueuedEvents() const {
@@ -260,49 +279,67 @@ class NRF52KeyScanner : public Base<_Props>, public TimerHandlerInterface {
     return bitRead(matrix_state_[key_addr.row()].previous, key_addr.col());
   }
 
+  /// @brief Set the debounce time, in milliseconds
+  void setDebounceTime(uint8_t ms) {
+    // The debouncer is used by the scan timer's interrupt handler, which must
+    // not see it half updated.
+    bool timer_enabled = NVIC_GetEnableIRQ(TIMER1_IRQn);
+    NVIC_DisableIRQ(TIMER1_IRQn);
+    debouncer_.setDebounceTime(ms, _Props::keyscan_interval_micros);
+    if (timer_enabled)
+      NVIC_EnableIRQ(TIMER1_IRQn);
+  }
+
+  uint8_t debounceTime() {
+    return debouncer_.debounceTime();
+  }
+
   /// @brief Process any changes in the matrix state and generate key events
   void actOnMatrixScan() {
     // Process any state changes
     for (uint8_t row = 0; row < _Props::matrix_rows; row++) {
       typename _Props::RowState changes = matrix_state_[row].previous ^ matrix_state_[row].current;
-      if (changes) {
-        for (uint8_t col = 0; col < _Props::matrix_columns; col++) {
-          if (bitRead(changes, col)) {
-            // Get previous and current state to form keyState
-            uint8_t keyState = (bitRead(matrix_state_[row].previous, col) << 0) |
-                               (bitRead(matrix_state_[row].current, col) << 1);
-            ThisType::handleKeyswitchEvent(Key_NoKey, KeyAddr(row, col), keyState);
-          }
-        }
+      for (; changes != 0; changes &= changes - 1) {
+        uint8_t col = __builtin_ctz(changes);
+        // Get previous and current state to form keyState
+        uint8_t keyState = (bitRead(matrix_state_[row].previous, col) << 0) |
+                           (bitRead(matrix_state_[row].current, col) << 1);
+        ThisType::handleKeyswitchEvent(Key_NoKey, KeyAddr(row, col), keyState);
       }
     }
   }
 
   // Timer handler interface implementation
   void handleTimer() override {
+    uint8_t now = millis();
+
     for (uint8_t row = 0; row < _Props::matrix_rows; row++) {
       digitalWrite(_Props::matrix_row_pins[row], LOW);
       delayMicroseconds(10);
+      typename _Props::RowState sample = 0;
       for (uint8_t col = 0; col < _Props::matrix_columns; col++) {
-        bool current_state = !digitalRead(_Props::matrix_col_pins[col]);
-
-        if (current_state != getMatrixState(row, col)) {
-          if (++debounce_counters_[row][col] >= DEBOUNCE_THRESHOLD) {
-            if (!queueKeyEvent(row, col, current_state)) {
-              // Queue is full, we'll try again next scan
-              continue;
-            }
-            debounce_counters_[row][col] = 0;
-          }
-        }
+        sample |= typename _Props::RowState(!digitalRead(_Props::matrix_col_pins[col])) << col;
       }
       digitalWrite(_Props::matrix_row_pins[row], HIGH);
+
+      debouncer_.debounce(row, sample, now);
+
+      // Queue every debounced change that hasn't been queued yet; if the queue
+      // is full, the rest are retried on the next scan.
+      typename _Props::RowState pending = debouncer_.state(row) ^ queued_state_[row];
+      for (; pending != 0; pending &= pending - 1) {
+        uint8_t col = __builtin_ctz(pending);
+        if (!queueKeyEvent(row, col, bitRead(debouncer_.state(row), col)))
+          break;
+        queued_state_[row] ^= typename _Props::RowState(1) << col;
+      }
     }
   }
 
  private:
-  static constexpr uint8_t DEBOUNCE_THRESHOLD = 3;
-  static uint8_t debounce_counters_[_Props::matrix_rows][_Props::matrix_columns];
+  typename _Props::template Debouncer<_Props> debouncer_;
+  // The debounced state of every key, as far as it has been queued
+  typename _Props::RowState queued_state_[_Props::matrix_rows] = {};
 
   static void gpio_handler(uint32_t pin) {
     // Wake-on-key handler
@@ -310,9 +347,6 @@ class NRF52KeyScanner : public Base<_Props>, public TimerHandlerInterface {
 };
 
 // Static member initialization
-template<typename _Props>
-uint8_t NRF52KeyScanner<_Props>::debounce_counters_[_Props::matrix_rows][_Props::matrix_columns] = {0};
-
 template<typename _Props>
 StaticQueue_t NRF52KeyScanner<_Props>::event_queue_buffer_;
 
@@ -23,9 +23,10 @@
 
 #pragma once
 
-#include <stdint.h>                               // for uint16_t, uint8_t, uint32_t
-#include "kaleidoscope/driver/keyscanner/Base.h"  // for BaseProps
-#include "kaleidoscope/driver/keyscanner/None.h"  // for None
+#include <stdint.h>                                    // for uint16_t, uint8_t, uint32_t
+#include "kaleidoscope/driver/keyscanner/Base.h"       // for BaseProps
+#include "kaleidoscope/driver/keyscanner/Debouncer.h"  // for SymmetricDebouncer
+#include "kaleidoscope/driver/keyscanner/None.h"       // for None
 
 
 namespace kaleidoscope {
@@ -37,6 +38,14 @@ struct SimpleProps : kaleidoscope::driver::keyscanner::BaseProps {
   static const uint32_t keyscan_interval_micros = 1500;
   typedef uint16_t RowState;
 
+  /*
+   * Four samples at the default scan interval. Boards may pick a different
+   * debouncer, or debounce time.
+   */
+  static constexpr uint8_t debounce_ms = 5;
+  template<typename _Props>
+  using Debouncer = kaleidoscope::driver::keyscanner::SymmetricDebouncer<_Props>;
+
   /*
    * The following two lines declare an empty array. Both of these must be
    * shadowed by the descendant keyscanner description class.
@@ -50,22 +59,9 @@ struct SimpleProps : kaleidoscope::driver::keyscanner::BaseProps {
 template<typename _KeyScannerProps>
 class Simple : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
  protected:
-  /*
-    each of these variables are storing the state for a row of keys
-
-    so for key 0, the counter is represented by db0[0] and db1[0]
-    and the state in debounced_state[0].
-  */
-  struct debounce_t {
-    typename _KeyScannerProps::RowState db0;              // counter bit 0
-    typename _KeyScannerProps::RowState db1;              // counter bit 1
-    typename _KeyScannerProps::RowState debounced_state;  // debounced state
-  };
-
   struct row_state_t {
     typename _KeyScannerProps::RowState previous;
     typename _KeyScannerProps::RowState current;
-    debounce_t debouncer;
   };
 
  private:
@@ -73,6 +69,7 @@ class Simple : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
   typedef _KeyScannerProps KeyScannerProps_;
   static row_state_t matrix_state_[_KeyScannerProps::matrix_rows];
   static uint32_t next_scan_at_;
+  typename _KeyScannerProps::template Debouncer<_KeyScannerProps> debouncer_;
 
  protected:
   // Protected methods for subclasses to modify matrix state
@@ -106,11 +103,13 @@ class Simple : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
       pinMode(_KeyScannerProps::matrix_row_pins[i], OUTPUT);
       digitalWrite(_KeyScannerProps::matrix_row_pins[i], HIGH);
     }
+
+    setDebounceTime(_KeyScannerProps::debounce_ms);
   }
 
 
   __attribute__((optimize(3))) void readMatrix(void) {
-    typename _KeyScannerProps::RowState any_debounced_changes = 0;
+    uint8_t now = millis();
 
     for (uint8_t current_row = 0; current_row < _KeyScannerProps::matrix_rows; current_row++) {
       digitalWrite(_KeyScannerProps::matrix_row_pins[current_row], LOW);
@@ -118,13 +117,8 @@ class Simple : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
       digitalWrite(_KeyScannerProps::matrix_row_pins[current_row], HIGH);
 
 
-      any_debounced_changes |= debounce(hot_pins, &matrix_state_[current_row].debouncer);
-
-      if (any_debounced_changes) {
-        for (uint8_t current_row = 0; current_row < _KeyScannerProps::matrix_rows; current_row++) {
-          matrix_state_[current_row].current = matrix_state_[current_row].debouncer.debounced_state;
-        }
-      }
+      if (debouncer_.debounce(current_row, hot_pins, now))
+        matrix_state_[current_row].current = debouncer_.state(current_row);
     }
     postReadMatrix();
   }
@@ -143,11 +137,12 @@ class Simple : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
 
   void __attribute__((optimize(3))) actOnMatrixScan() {
     for (uint8_t row = 0; row < _KeyScannerProps::matrix_rows; row++) {
-      for (uint8_t col = 0; col < _KeyScannerProps::matrix_columns; col++) {
+      // Only keys that toggled on or off make an event, so we only visit those.
+      typename _KeyScannerProps::RowState changes = matrix_state_[row].previous ^ matrix_state_[row].current;
+      for (; changes != 0; changes &= changes - 1) {
+        uint8_t col      = __builtin_ctzl(changes);
         uint8_t keyState = (bitRead(matrix_state_[row].previous, col) << 0) | (bitRead(matrix_state_[row].current, col) << 1);
-        if (keyState) {
-          ThisType::handleKeyswitchEvent(Key_NoKey, typename _KeyScannerProps::KeyAddr(row, col), keyState);
-        }
+        ThisType::handleKeyswitchEvent(Key_NoKey, typename _KeyScannerProps::KeyAddr(row, col), keyState);
       }
     }
   }
@@ -169,6 +164,13 @@ class Simple : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
   bool isKeyswitchPressed(typename _KeyScannerProps::KeyAddr key_addr) {
     return (bitRead(matrix_state_[key_addr.row()].current, key_addr.col()) != 0);
   }
+  template<typename _Callback>
+  void forEachPressedKeyswitch(_Callback callback) {
+    for (uint8_t row = 0; row < _KeyScannerProps::matrix_rows; row++) {
+      for (typename _KeyScannerProps::RowState pressed = matrix_state_[row].current; pressed != 0; pressed &= pressed - 1)
+        callback(typename _KeyScannerProps::KeyAddr(row, __builtin_ctzl(pressed)));
+    }
+  }
 
   uint8_t previousPressedKeyswitchCount() {
     uint8_t count = 0;
@@ -183,6 +185,13 @@ class Simple : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
                     key_addr.col()) != 0);
   }
 
+  void setDebounceTime(uint8_t ms) {
+    debouncer_.setDebounceTime(ms, _KeyScannerProps::keyscan_interval_micros);
+  }
+  uint8_t debounceTime() {
+    return debouncer_.debounceTime();
+  }
+
 
  private:
   /*
@@ -210,30 +219,6 @@ class Simple : public kaleidoscope::driver::keyscanner::Base<_KeyScannerProps> {
 
     return hot_pins;
   }
-
-  static inline typename _KeyScannerProps::RowState debounce(
-    typename _KeyScannerProps::RowState sample, debounce_t *debouncer) {
-    typename _KeyScannerProps::RowState delta, changes;
-
-    // Use xor to detect changes from last stable state:
-    // if a key has changed, it's bit will be 1, otherwise 0
-    delta = sample ^ debouncer->debounced_state;
-
-    // Increment counters and reset any unchanged bits:
-    // increment bit 1 for all changed keys
-    debouncer->db1 = ((debouncer->db1) ^ (debouncer->db0)) & delta;
-    // increment bit 0 for all changed keys
-    debouncer->db0 = ~(debouncer->db0) & delta;
-
-    // Calculate returned change set: if delta is still true
-    // and the counter has wrapped back to 0, the key is changed.
-
-    changes = ~(~delta | (debouncer->db0) | (debouncer->db1));
-    // Update state: in this case use xor to flip any bit that is true in changes.
-    debouncer->debounced_state ^= changes;
-
-    return changes;
-  }
 };
 #else   // ifndef KALEIDOSCOPE_VIRTUAL_BUILD
 template<typename _KeyScannerProps>
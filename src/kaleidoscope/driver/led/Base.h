@@ -47,9 +47,6 @@ struct BaseProps {
 template<typename _LEDDriverProps>
 class Base {
  public:
-  Base()
-    : active_leds_(0), last_led_activity_time_(0) {}
-
   void setup() {}
   void syncLeds(void) {}
   void setCrgbAt(uint8_t i, cRGB color) {}
@@ -58,6 +55,34 @@ class Base {
       0, 0, 0};
     return c;
   }
+
+  // Bulk access, for code that sets more than a few LEDs at a time. `blit()`
+  // copies `count` colors to the LEDs starting at index `first`, and `fill()`
+  // sets every LED to the same color. Like `setCrgbAt()`, they only need to
+  // take effect once `syncLeds()` is called, and only the LEDs whose color
+  // changes are marked dirty.
+  void blit(const cRGB *colors, uint8_t first, uint8_t count) {}
+  void fill(cRGB color) {}
+
+  /**
+   * @brief The range of LEDs changed since the last `syncLeds()`
+   *
+   * Every LED is dirty until the first `syncLeds()`, since the color the
+   * hardware shows before that is unknown.
+   *
+   * @param first is set to the index of the first LED that changed
+   * @param last is set to the index of the last LED that changed
+   *
+   * @returns false if no LED changed, in which case neither is set
+   */
+  static bool dirtyRange(uint8_t &first, uint8_t &last) {
+    if (dirty_first_ > dirty_last_)
+      return false;
+
+    first = dirty_first_;
+    last  = dirty_last_;
+    return true;
+  }
   void setBrightness(uint8_t brightness) {}
   uint8_t getBrightness() {
     return 255;
@@ -86,7 +111,7 @@ class Base {
    * @param will_be_on true if the LED will be turned on
    * @param was_off true if the LED was previously off
    */
-  void updateLEDState(bool will_be_on, bool was_off) {
+  static void updateLEDState(bool will_be_on, bool was_off) {
     if (will_be_on && was_off) {
       active_leds_++;
       last_led_activity_time_ = millis();
@@ -105,7 +130,7 @@ class Base {
    * @param will_be_on true if the LEDs will be turned on
    * @param was_off true if all LEDs were previously off
    */
-  void updateAllLEDState(bool will_be_on, bool was_off) {
+  static void updateAllLEDState(bool will_be_on, bool was_off) {
     if (will_be_on && was_off) {
       active_leds_            = _LEDDriverProps::led_count;
       last_led_activity_time_ = millis();
@@ -206,12 +231,63 @@ class Base {
  protected:
   typedef _LEDDriverProps Props_;
   /** Number of LEDs that are currently lit (non-black) */
-  uint16_t active_leds_;
+  static uint16_t active_leds_;
 
   /** Timestamp of the last LED state change in milliseconds */
-  uint32_t last_led_activity_time_;
+  static uint32_t last_led_activity_time_;
+
+  /** The dirty range, empty when `dirty_first_ > dirty_last_` */
+  static uint8_t dirty_first_;
+  static uint8_t dirty_last_;
+
+  /**
+   * @brief Store the color of an LED in the driver's copy of it
+   *
+   * Does nothing if the LED already has that color. Otherwise, it marks the LED
+   * dirty, and keeps track of whether it is lit.
+   *
+   * @param slot is where the driver keeps the color of the LED
+   * @param i is the index of the LED
+   * @param color is the color to set it to
+   *
+   * @returns true if the color of the LED changed
+   */
+  static bool storeColor(cRGB &slot, uint8_t i, cRGB color) {
+    if (slot.r == color.r && slot.g == color.g && slot.b == color.b)
+      return false;
+
+    updateLEDState(color.r != 0 || color.g != 0 || color.b != 0,
+                   slot.r == 0 && slot.g == 0 && slot.b == 0);
+    markDirty(i, i);
+    slot = color;
+    return true;
+  }
+
+  static void markDirty(uint8_t first, uint8_t last) {
+    if (first < dirty_first_)
+      dirty_first_ = first;
+    if (last > dirty_last_)
+      dirty_last_ = last;
+  }
+  static void markAllDirty() {
+    dirty_first_ = 0;
+    dirty_last_  = _LEDDriverProps::led_count - 1;
+  }
+  static void clearDirty() {
+    dirty_first_ = no_led;
+    dirty_last_  = 0;
+  }
 };
 
+template<typename _LEDDriverProps>
+uint16_t Base<_LEDDriverProps>::active_leds_ = 0;
+template<typename _LEDDriverProps>
+uint32_t Base<_LEDDriverProps>::last_led_activity_time_ = 0;
+template<typename _LEDDriverProps>
+uint8_t Base<_LEDDriverProps>::dirty_first_ = _LEDDriverProps::led_count > 0 ? 0 : no_led;
+template<typename _LEDDriverProps>
+uint8_t Base<_LEDDriverProps>::dirty_last_ = _LEDDriverProps::led_count > 0 ? _LEDDriverProps::led_count - 1 : 0;
+
 }  // namespace led
 }  // namespace driver
 }  // namespace kaleidoscope
@@ -25,6 +25,7 @@
 #include "kaleidoscope/driver/led/Base.h"
 #include "kaleidoscope/driver/led/Color.h"
 #include <Adafruit_NeoPixel.h>
+#include <string.h>  // for memcmp
 
 namespace kaleidoscope {
 namespace driver {
@@ -40,8 +41,13 @@ struct WS2812Props : public BaseProps {
 template<typename _LEDDriverProps>
 class WS2812 : public Base<_LEDDriverProps> {
  private:
+  typedef Base<_LEDDriverProps> ParentType;
+
   Adafruit_NeoPixel pixels;
-  bool modified_ = false;
+  // The colors of the LEDs, before `Adafruit_NeoPixel` scales them to the
+  // brightness. They are copied to it when the LEDs are synced, so that the
+  // colors can be compared and set in bulk, and read back as they were set.
+  cRGB leds_[_LEDDriverProps::led_count];
 
  public:
   WS2812()
@@ -53,40 +59,61 @@ class WS2812 : public Base<_LEDDriverProps> {
     pixels.show();             // Initialize all pixels to 'off'
     pixels.setBrightness(50);  // Set initial brightness
 
-    for (int i = 0; i < _LEDDriverProps::led_count; i++) {
-      pixels.setPixelColor(i, pixels.Color(0, 150, 150));
-    }
-    modified_ = true;
+    fill(CRGB(0, 150, 150));
 
     syncLeds();
   }
 
 
   void syncLeds() {
-    if (modified_) {
-      pixels.show();
-      modified_ = false;
+    uint8_t first, last;
+    if (!ParentType::dirtyRange(first, last))
+      return;
+
+    for (uint8_t i = first; i <= last; i++) {
+      pixels.setPixelColor(i, pixels.Color(leds_[i].r, leds_[i].g, leds_[i].b));
     }
+    pixels.show();
+    ParentType::clearDirty();
   }
 
   void setCrgbAt(uint8_t i, cRGB color) {
+    if (i >= _LEDDriverProps::led_count)
+      return;
 
-    pixels.setPixelColor(i, pixels.Color(color.r, color.g, color.b));
-    modified_ = true;
+    ParentType::storeColor(leds_[i], i, color);
   }
 
   cRGB getCrgbAt(uint8_t i) {
-    uint32_t color = pixels.getPixelColor(i);
-    cRGB rgb;
-    rgb.r = (color >> 16) & 0xFF;
-    rgb.g = (color >> 8) & 0xFF;
-    rgb.b = color & 0xFF;
-    return rgb;
+    if (i >= _LEDDriverProps::led_count)
+      return CRGB(0, 0, 0);
+
+    return leds_[i];
+  }
+
+  void blit(const cRGB *colors, uint8_t first, uint8_t count) {
+    if (first >= _LEDDriverProps::led_count)
+      return;
+    if (count > _LEDDriverProps::led_count - first)
+      count = _LEDDriverProps::led_count - first;
+
+    if (memcmp(&leds_[first], colors, count * sizeof(cRGB)) == 0)
+      return;
+
+    for (uint8_t i = 0; i < count; i++)
+      ParentType::storeColor(leds_[first + i], first + i, colors[i]);
+  }
+
+  void fill(cRGB color) {
+    for (uint8_t i = 0; i < _LEDDriverProps::led_count; i++)
+      ParentType::storeColor(leds_[i], i, color);
   }
 
   void setBrightness(uint8_t brightness) {
     pixels.setBrightness(brightness);
-    modified_ = true;
+    // Scaling the colors `Adafruit_NeoPixel` already has loses precision, so
+    // all of them are copied to it again on the next sync.
+    ParentType::markAllDirty();
   }
 
   uint8_t getBrightness() {
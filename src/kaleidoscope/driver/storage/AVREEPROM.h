@@ -63,6 +63,41 @@ class AVREEPROM : public kaleidoscope::driver::storage::Base<_StorageProps> {
     EEPROM.update(idx, val);
   }
 
+  void readBlock(uint16_t offset, void *data, uint16_t size) {
+#ifdef __AVR__
+    eeprom_read_block(data, reinterpret_cast<const void *>(offset), size);
+#else
+    uint8_t *bytes = static_cast<uint8_t *>(data);
+    for (uint16_t i = 0; i < size; i++)
+      bytes[i] = EEPROM.read(offset + i);
+#endif
+  }
+
+  void writeBlock(uint16_t offset, const void *data, uint16_t size) {
+#ifdef __AVR__
+    eeprom_update_block(data, reinterpret_cast<void *>(offset), size);
+#else
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (uint16_t i = 0; i < size; i++)
+      EEPROM.update(offset + i, bytes[i]);
+#endif
+  }
+
+  void fill(uint16_t offset, uint8_t value, uint16_t size) {
+    for (uint16_t i = 0; i < size; i++)
+      EEPROM.update(offset + i, value);
+  }
+
+  int compareBlock(uint16_t offset, const void *data, uint16_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (uint16_t i = 0; i < size; i++) {
+      uint8_t b = EEPROM.read(offset + i);
+      if (b != bytes[i])
+        return b - bytes[i];
+    }
+    return 0;
+  }
+
   bool isSliceUninitialized(uint16_t offset, uint16_t size) {
     for (uint16_t o = offset; o < offset + size; o++) {
       if (this->read(o) != _StorageProps::uninitialized_byte)
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <stdint.h>  // for uint16_t, uint8_t
+#include <string.h>  // for memset
 
 namespace kaleidoscope {
 namespace driver {
@@ -32,6 +33,9 @@ namespace storage {
 struct BaseProps {
   static constexpr uint16_t length            = 0;
   static constexpr uint8_t uninitialized_byte = 0xff;
+  // How long, in milliseconds, drivers that defer commits wait for more of
+  // them before flushing.
+  static constexpr uint16_t commit_delay = 500;
 };
 
 template<typename _StorageProps>
@@ -55,6 +59,18 @@ class Base {
 
   void update(int idx, uint8_t val) {}
 
+  // Bulk access, for code that reads or writes more than a few bytes at a time.
+  // `writeBlock()` and `fill()` only write the bytes that change, like
+  // `update()`, and `compareBlock()` compares like `memcmp()`.
+  void readBlock(uint16_t offset, void *data, uint16_t size) {
+    memset(data, 0, size);
+  }
+  void writeBlock(uint16_t offset, const void *data, uint16_t size) {}
+  void fill(uint16_t offset, uint8_t value, uint16_t size) {}
+  int compareBlock(uint16_t offset, const void *data, uint16_t size) {
+    return 0;
+  }
+
   bool isSliceUninitialized(uint16_t offset, uint16_t size) {
     return false;
   }
@@ -64,7 +80,13 @@ class Base {
   }
 
   void setup() {}
+
+  // Drivers that write to flash may defer `commit()`, and coalesce the commits
+  // that follow it into one flush, done from `betweenCycles()`. `flush()` writes
+  // everything that was committed right away.
   void commit() {}
+  void flush() {}
+  void betweenCycles() {}
 
   void erase() {
     for (uint16_t i = 0; i < length(); i++) {
@@ -0,0 +1,63 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Arduino.h>  // for millis
+#include <stdint.h>   // for uint16_t, uint32_t
+
+namespace kaleidoscope {
+namespace driver {
+namespace storage {
+
+// Coalesces the `commit()` calls of a storage driver: a commit only requests a
+// flush, which becomes due once no other commit was requested for
+// `_commit_delay` milliseconds. Plugins commit after every change, so a burst
+// of changes, like a keymap upload, ends up written to flash once.
+template<uint16_t _commit_delay>
+class CommitScheduler {
+ public:
+  void request() {
+    pending_      = true;
+    requested_at_ = millis();
+  }
+
+  bool isPending() const {
+    return pending_;
+  }
+
+  bool isDue() const {
+    return pending_ && millis() - requested_at_ >= _commit_delay;
+  }
+
+  void clear() {
+    pending_ = false;
+  }
+
+ private:
+  bool pending_          = false;
+  uint32_t requested_at_ = 0;
+};
+
+}  // namespace storage
+}  // namespace driver
+}  // namespace kaleidoscope
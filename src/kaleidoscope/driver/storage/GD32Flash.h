@@ -28,7 +28,8 @@
 #include <FlashAsEEPROM.h>
 #include <FlashStorage.h>
 
-#include "kaleidoscope/driver/storage/Base.h"
+#include "kaleidoscope/driver/storage/Base.h"             // for BaseProps
+#include "kaleidoscope/driver/storage/CommitScheduler.h"  // for CommitScheduler
 
 namespace kaleidoscope {
 namespace driver {
@@ -45,6 +46,35 @@ class GD32Flash : public EEPROMClass<_StorageProps::length> {
     EEPROMClass<_StorageProps::length>::begin();
   }
 
+  // The emulated EEPROM is buffered in RAM, but only reachable a byte at a
+  // time.
+  void readBlock(uint16_t offset, void *data, uint16_t size) {
+    uint8_t *bytes = static_cast<uint8_t *>(data);
+    for (uint16_t i = 0; i < size; i++)
+      bytes[i] = this->read(offset + i);
+  }
+
+  void writeBlock(uint16_t offset, const void *data, uint16_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (uint16_t i = 0; i < size; i++)
+      this->update(offset + i, bytes[i]);
+  }
+
+  void fill(uint16_t offset, uint8_t value, uint16_t size) {
+    for (uint16_t i = 0; i < size; i++)
+      this->update(offset + i, value);
+  }
+
+  int compareBlock(uint16_t offset, const void *data, uint16_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (uint16_t i = 0; i < size; i++) {
+      uint8_t b = this->read(offset + i);
+      if (b != bytes[i])
+        return b - bytes[i];
+    }
+    return 0;
+  }
+
   bool isSliceUninitialized(uint16_t offset, uint16_t size) {
     for (uint16_t o = offset; o < offset + size; o++) {
       if (this->read(o) != _StorageProps::uninitialized_byte)
@@ -52,12 +82,30 @@ class GD32Flash : public EEPROMClass<_StorageProps::length> {
     }
     return true;
   }
+
+  // Every commit rewrites the emulated EEPROM's flash pages, so commits are
+  // deferred, and coalesced. `EEPROMClass` can only rewrite all of them at
+  // once, so the flush can't be spread over cycles: devices that can't afford
+  // that should use `JournaledFlash` on top of `GD32FlashPages` instead.
+  void commit() {
+    scheduler_.request();
+  }
+  void flush() {
+    scheduler_.clear();
+    EEPROMClass<_StorageProps::length>::commit();
+  }
+  void betweenCycles() {
+    if (scheduler_.isDue())
+      flush();
+  }
+
   void erase() {
-    for (uint16_t i = 0; i < this->length(); i++) {
-      this->update(i, _StorageProps::uninitialized_byte);
-    }
-    this->commit();
+    fill(0, _StorageProps::uninitialized_byte, this->length());
+    flush();
   }
+
+ private:
+  CommitScheduler<_StorageProps::commit_delay> scheduler_;
 };
 
 }  // namespace storage
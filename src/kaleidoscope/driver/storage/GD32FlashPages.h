@@ -0,0 +1,86 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifdef ARDUINO_ARCH_GD32
+
+#include <Arduino.h>
+#include <gd32f30x_fmc.h>  // for fmc_page_erase, fmc_word_program
+#include <stdint.h>        // for uint8_t, uint16_t, uint32_t
+#include <string.h>        // for memcpy
+
+namespace kaleidoscope {
+namespace driver {
+namespace storage {
+
+// Raw access to `_page_count` pages of the GD32F30x's internal flash, starting
+// at `_base_address`, for `JournaledFlash` to run on. Addresses and pages are
+// relative to the start of that area, which must be page aligned, and left out
+// of the firmware image.
+template<uint32_t _base_address, uint16_t _page_size, uint8_t _page_count>
+class GD32FlashPages {
+ public:
+  static constexpr uint16_t page_size   = _page_size;
+  static constexpr uint8_t page_count   = _page_count;
+  static constexpr uint8_t program_unit = 4;
+
+  static_assert(_base_address % _page_size == 0,
+                "GD32FlashPages must start on a page boundary");
+
+  void read(uint32_t address, void *data, uint16_t size) {
+    memcpy(data, reinterpret_cast<const void *>(_base_address + address), size);
+  }
+
+  void program(uint32_t address, const void *data, uint16_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+    fmc_unlock();
+    for (uint16_t i = 0; i < size; i += program_unit) {
+      uint32_t word;
+      memcpy(&word, bytes + i, program_unit);
+      // Words that are still erased can be skipped.
+      if (word != 0xffffffff)
+        fmc_word_program(_base_address + address + i, word);
+      clearFlags();
+    }
+    fmc_lock();
+  }
+
+  void erasePage(uint8_t page) {
+    fmc_unlock();
+    fmc_page_erase(_base_address + page * _page_size);
+    clearFlags();
+    fmc_lock();
+  }
+
+ private:
+  static void clearFlags() {
+    fmc_flag_clear(FMC_FLAG_BANK0_END | FMC_FLAG_BANK0_WPERR | FMC_FLAG_BANK0_PGERR);
+  }
+};
+
+}  // namespace storage
+}  // namespace driver
+}  // namespace kaleidoscope
+
+#endif  // ifdef ARDUINO_ARCH_GD32
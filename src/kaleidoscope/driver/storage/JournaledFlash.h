@@ -0,0 +1,645 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>  // for uint8_t, uint16_t, uint32_t
+#include <string.h>  // for memcmp, memcpy, memset
+
+#include "kaleidoscope/driver/storage/Base.h"             // for Base, BaseProps
+#include "kaleidoscope/driver/storage/CommitScheduler.h"  // for CommitScheduler
+
+namespace kaleidoscope {
+namespace driver {
+namespace storage {
+
+// A log-structured storage driver for EEPROM emulated in flash.
+//
+// The whole storage is kept in RAM. Instead of rewriting all of it when it is
+// flushed, only the chunks that changed are appended to a journal, as
+// records of an offset, a length, the new bytes, and a check byte. When the
+// journal fills up, the RAM image is written out to a snapshot bank, one flash
+// page operation at a time from `betweenCycles()`, while new records go to a
+// second journal. At `setup()`, the newest complete bank is loaded, and the
+// journals written since are replayed on top of it.
+//
+// Banks and journals each come in pairs, so that there is always a complete
+// copy of the storage in flash: a bank's header is programmed last, and a
+// journal is only erased once a bank that includes it is complete.
+//
+// `commit()` only schedules a flush, for when no other commit was made for
+// `_StorageProps::commit_delay` milliseconds. The flush is then spread over
+// cycles, appending at most a page worth of records per cycle, in increasing
+// address order. `flush()` does it all at once.
+//
+// If power is lost, the storage is left as it was after the last complete
+// flush, plus some of the chunks of the flush in progress, if any: each 8-byte
+// chunk is either entirely old, or entirely new. Changes that were coalesced
+// into the same flush are not ordered with respect to each other, so a plugin
+// that needs one change to be in flash before it makes another must call
+// `flush()` in between.
+//
+// The flash itself is accessed through `_StorageProps::Flash`, which must
+// provide `page_size`, `page_count` and `program_unit` constants, and `read()`,
+// `program()` and `erasePage()` methods. See `SimulatedFlash` for the RAM-backed
+// one used in the virtual build.
+struct JournaledFlashProps : kaleidoscope::driver::storage::BaseProps {
+  static constexpr uint16_t length = 16384;
+  // The number of flash pages in each of the two journals.
+  static constexpr uint8_t journal_pages = 2;
+};
+
+template<typename _StorageProps>
+class JournaledFlash : public kaleidoscope::driver::storage::Base<_StorageProps> {
+ public:
+  typedef typename _StorageProps::Flash Flash;
+
+ private:
+  static constexpr uint16_t storage_size  = _StorageProps::length;
+  static constexpr uint8_t journal_pages  = _StorageProps::journal_pages;
+  static constexpr uint32_t page_size     = Flash::page_size;
+  static constexpr uint8_t program_unit   = Flash::program_unit;
+  static constexpr uint32_t journal_size  = journal_pages * page_size;
+
+  // Changes are tracked, and journaled, in chunks of this many bytes.
+  static constexpr uint8_t chunk_size     = 8;
+  static constexpr uint16_t chunk_count   = storage_size / chunk_size;
+  static constexpr uint8_t max_record_len = 248;
+
+  static constexpr uint16_t bank_magic           = 0x4b42;  // "BK"
+  static constexpr uint16_t journal_magic        = 0x4a4c;  // "LJ"
+  static constexpr uint8_t bank_header_size      = 8;
+  static constexpr uint8_t journal_header_size   = 4;
+  static constexpr uint8_t record_header_size    = 3;
+  static constexpr uint16_t bank_pages           =
+    (bank_header_size + storage_size + page_size - 1) / page_size;
+  static constexpr uint8_t no_bank               = 0xff;
+
+  static_assert(storage_size % chunk_size == 0,
+                "JournaledFlash length must be a multiple of 8 bytes");
+  static_assert(chunk_size % program_unit == 0 &&
+                  bank_header_size % program_unit == 0 &&
+                  journal_header_size % program_unit == 0,
+                "JournaledFlash needs a flash program unit of at most 8 bytes");
+  static_assert(2 * bank_pages + 2 * journal_pages <= Flash::page_count,
+                "JournaledFlash needs more flash pages");
+  static_assert(journal_size >= journal_header_size + 2 * (max_record_len + 8),
+                "JournaledFlash journals are too small");
+
+  static Flash flash_;
+  static uint8_t contents_[storage_size];
+  static uint8_t dirty_[(chunk_count + 7) / 8];
+  static bool is_dirty_;
+  static CommitScheduler<_StorageProps::commit_delay> scheduler_;
+
+  static uint8_t active_bank_;
+  static uint16_t bank_seq_;
+  static uint8_t active_journal_;
+  static uint16_t journal_seq_;
+  static uint32_t journal_pos_;
+  // Whether the inactive journal still holds records that are not in a bank.
+  static bool other_journal_used_;
+
+  // The next step of the compaction in progress, or 0 if there is none.
+  static uint16_t compact_step_;
+  static uint8_t compact_bank_;
+  static uint16_t compact_jseq_;
+
+  static bool newer(uint16_t a, uint16_t b) {
+    return int16_t(a - b) > 0;
+  }
+
+  static uint16_t bankPage(uint8_t bank) {
+    return bank * bank_pages;
+  }
+  static uint32_t bankAddress(uint8_t bank) {
+    return bankPage(bank) * page_size;
+  }
+  static uint16_t journalPage(uint8_t journal) {
+    return 2 * bank_pages + journal * journal_pages;
+  }
+  static uint32_t journalAddress(uint8_t journal) {
+    return journalPage(journal) * page_size;
+  }
+
+  static uint16_t recordSize(uint8_t len) {
+    uint16_t size = record_header_size + len + 1;
+    return (size + program_unit - 1) / program_unit * program_unit;
+  }
+
+  static uint8_t checkByte(const uint8_t *record, uint16_t size) {
+    uint8_t check = 0x5a;
+    for (uint16_t i = 0; i < size; i++)
+      check += record[i];
+    // Never 0xff, so that a record torn before its check byte is always caught.
+    return (check == 0xff) ? 0 : check;
+  }
+
+  static void markDirty(uint16_t offset, uint16_t size) {
+    for (uint16_t chunk = offset / chunk_size; chunk <= (offset + size - 1) / chunk_size; chunk++)
+      dirty_[chunk / 8] |= 1 << (chunk % 8);
+    is_dirty_ = true;
+  }
+
+  // Copies `size` bytes from `data` to `offset`, marking the chunks that
+  // actually change as dirty.
+  static void updateBlock(uint16_t offset, const uint8_t *data, uint16_t size) {
+    while (size > 0) {
+      uint16_t run = chunk_size - offset % chunk_size;
+      if (run > size)
+        run = size;
+      if (memcmp(contents_ + offset, data, run) != 0) {
+        memcpy(contents_ + offset, data, run);
+        markDirty(offset, run);
+      }
+      offset += run;
+      data += run;
+      size -= run;
+    }
+  }
+
+  static bool isChunkDirty(uint16_t chunk) {
+    return dirty_[chunk / 8] & (1 << (chunk % 8));
+  }
+
+  static void clearChunk(uint16_t chunk) {
+    dirty_[chunk / 8] &= ~(1 << (chunk % 8));
+  }
+
+  // Headers are programmed magic last, so that a torn one is never valid.
+
+  // Reads the bank header of `bank`, returning false if it isn't complete.
+  static bool readBankHeader(uint8_t bank, uint16_t &seq, uint16_t &jseq) {
+    uint16_t header[4];
+    flash_.read(bankAddress(bank), header, sizeof(header));
+    seq  = header[0];
+    jseq = header[1];
+    return header[3] == bank_magic && header[2] == uint16_t(bank_magic ^ seq ^ jseq);
+  }
+
+  static void programBankHeader(uint8_t bank, uint16_t seq, uint16_t jseq) {
+    uint16_t header[4] = {seq, jseq, uint16_t(bank_magic ^ seq ^ jseq), bank_magic};
+    flash_.program(bankAddress(bank), header, sizeof(header));
+  }
+
+  // Programs the part of the storage that falls into page `page` of `bank`.
+  static void programBankPage(uint8_t bank, uint16_t page) {
+    uint32_t start = page * page_size;
+    uint32_t end   = start + page_size;
+    if (start < bank_header_size)
+      start = bank_header_size;
+    if (end > bank_header_size + storage_size)
+      end = bank_header_size + storage_size;
+    flash_.program(bankAddress(bank) + start,
+                   contents_ + start - bank_header_size,
+                   end - start);
+  }
+
+  static bool readJournalHeader(uint8_t journal, uint16_t &seq) {
+    uint16_t header[2];
+    flash_.read(journalAddress(journal), header, sizeof(header));
+    seq = header[0];
+    return header[1] == journal_magic;
+  }
+
+  static void startJournal(uint8_t journal, uint16_t seq) {
+    uint16_t header[2] = {seq, journal_magic};
+    flash_.program(journalAddress(journal), header, sizeof(header));
+    active_journal_ = journal;
+    journal_seq_    = seq;
+    journal_pos_    = journal_header_size;
+  }
+
+  static bool isJournalErased(uint8_t journal) {
+    uint8_t buffer[32];
+    for (uint32_t pos = 0; pos < journal_size; pos += sizeof(buffer)) {
+      flash_.read(journalAddress(journal) + pos, buffer, sizeof(buffer));
+      for (uint8_t i = 0; i < sizeof(buffer); i++) {
+        if (buffer[i] != 0xff)
+          return false;
+      }
+    }
+    return true;
+  }
+
+  static void eraseJournal(uint8_t journal) {
+    for (uint8_t page = 0; page < journal_pages; page++)
+      flash_.erasePage(journalPage(journal) + page);
+  }
+
+  // Applies the records of `journal` to `contents_`. Returns false if it ends
+  // with a torn record, in which case nothing more can be appended to it.
+  static bool replayJournal(uint8_t journal) {
+    uint8_t record[record_header_size + max_record_len + 1];
+    uint32_t pos = journal_header_size;
+
+    while (pos + record_header_size <= journal_size) {
+      flash_.read(journalAddress(journal) + pos, record, record_header_size);
+      uint16_t offset = record[0] | (record[1] << 8);
+      uint8_t len     = record[2];
+      if (offset == 0xffff && len == 0xff)
+        break;
+
+      uint16_t size = recordSize(len);
+      if (len == 0 || len > max_record_len || offset + len > storage_size ||
+          pos + size > journal_size) {
+        journal_pos_ = journal_size;
+        return false;
+      }
+
+      flash_.read(journalAddress(journal) + pos + record_header_size,
+                  record + record_header_size,
+                  len + 1);
+      if (record[record_header_size + len] != checkByte(record, record_header_size + len)) {
+        journal_pos_ = journal_size;
+        return false;
+      }
+
+      memcpy(contents_ + offset, record + record_header_size, len);
+      pos += size;
+    }
+
+    journal_pos_ = pos;
+    return true;
+  }
+
+  // Appends a record of `len` bytes from `offset`, which the active journal
+  // must have room for, and marks those bytes clean.
+  static void appendRecord(uint16_t offset, uint8_t len) {
+    uint16_t size = recordSize(len);
+
+    uint8_t record[record_header_size + max_record_len + 1 + 8];
+    memset(record, 0xff, size);
+    record[0] = offset & 0xff;
+    record[1] = offset >> 8;
+    record[2] = len;
+    memcpy(record + record_header_size, contents_ + offset, len);
+    record[record_header_size + len] = checkByte(record, record_header_size + len);
+
+    flash_.program(journalAddress(active_journal_) + journal_pos_, record, size);
+    journal_pos_ += size;
+
+    for (uint16_t chunk = offset / chunk_size; chunk < (offset + len) / chunk_size; chunk++)
+      clearChunk(chunk);
+  }
+
+  // Appends records for the dirty chunks, until about `budget` bytes were
+  // programmed. When the journal is full, it starts a compaction to switch to
+  // the other one, or, if a compaction is still using that, runs one step of
+  // it instead. Returns true once nothing is left to flush.
+  static bool flushStep(uint16_t budget) {
+    uint16_t programmed = 0;
+    uint16_t chunk      = 0;
+
+    while (true) {
+      while (chunk < chunk_count && !isChunkDirty(chunk))
+        chunk++;
+      if (chunk == chunk_count)
+        break;
+      if (programmed >= budget)
+        return false;
+
+      uint16_t first = chunk;
+      while (chunk < chunk_count && isChunkDirty(chunk) &&
+             (chunk - first + 1) * chunk_size <= max_record_len)
+        chunk++;
+      uint8_t len = (chunk - first) * chunk_size;
+
+      if (journal_pos_ + recordSize(len) > journal_size) {
+        if (compact_step_ != 0) {
+          if (programmed == 0)
+            compactionStep();
+          return false;
+        }
+        startCompaction();
+        chunk = first;
+        continue;
+      }
+
+      appendRecord(first * chunk_size, len);
+      programmed += recordSize(len);
+    }
+
+    is_dirty_ = false;
+    if (compact_step_ == 0 && journal_pos_ > journal_size / 2)
+      startCompaction();
+    return true;
+  }
+
+  // Switches to the other journal, if it is free, and starts writing a bank
+  // that includes everything journaled so far.
+  static void startCompaction() {
+    if (!other_journal_used_) {
+      startJournal(1 - active_journal_, journal_seq_ + 1);
+      other_journal_used_ = true;
+    }
+    compact_bank_ = (active_bank_ == 0) ? 1 : 0;
+    compact_jseq_ = journal_seq_;
+    compact_step_ = 1;
+  }
+
+  // Runs a single flash page operation of the compaction in progress.
+  static void compactionStep() {
+    uint16_t step = compact_step_++ - 1;
+
+    if (step < bank_pages) {
+      flash_.erasePage(bankPage(compact_bank_) + step);
+      return;
+    }
+    step -= bank_pages;
+
+    if (step < bank_pages) {
+      programBankPage(compact_bank_, step);
+      return;
+    }
+    step -= bank_pages;
+
+    if (step == 0) {
+      programBankHeader(compact_bank_, bank_seq_ + 1, compact_jseq_);
+      active_bank_ = compact_bank_;
+      bank_seq_++;
+      return;
+    }
+    step -= 1;
+
+    flash_.erasePage(journalPage(1 - active_journal_) + step);
+    if (step == journal_pages - 1) {
+      other_journal_used_ = false;
+      compact_step_       = 0;
+    }
+  }
+
+  static void format() {
+    for (uint16_t page = 0; page < 2 * bank_pages + 2 * journal_pages; page++)
+      flash_.erasePage(page);
+    active_bank_        = no_bank;
+    bank_seq_           = 0;
+    other_journal_used_ = false;
+    compact_step_       = 0;
+    startJournal(0, 1);
+  }
+
+ public:
+  // For tests and diagnostics.
+  static Flash &flash() {
+    return flash_;
+  }
+  static bool isCompacting() {
+    return compact_step_ != 0;
+  }
+  static bool isFlushPending() {
+    return scheduler_.isPending();
+  }
+
+  template<typename T>
+  static T &get(uint16_t offset, T &t) {
+    if (offset + sizeof(T) > storage_size)
+      return t;
+
+    memcpy(&t, contents_ + offset, sizeof(T));
+    return t;
+  }
+
+  template<typename T>
+  static const T &put(uint16_t offset, T &t) {
+    if (offset + sizeof(T) > storage_size)
+      return t;
+
+    updateBlock(offset, reinterpret_cast<const uint8_t *>(&t), sizeof(T));
+    return t;
+  }
+
+  uint8_t read(int idx) {
+    if (idx < 0 || idx >= storage_size)
+      return 0;
+    return contents_[idx];
+  }
+
+  void write(int idx, uint8_t val) {
+    if (idx < 0 || idx >= storage_size)
+      return;
+    contents_[idx] = val;
+    markDirty(idx, 1);
+  }
+
+  void update(int idx, uint8_t val) {
+    if (read(idx) != val)
+      write(idx, val);
+  }
+
+  void readBlock(uint16_t offset, void *data, uint16_t size) {
+    if (offset + size > storage_size)
+      return;
+    memcpy(data, contents_ + offset, size);
+  }
+
+  void writeBlock(uint16_t offset, const void *data, uint16_t size) {
+    if (offset + size > storage_size)
+      return;
+    updateBlock(offset, static_cast<const uint8_t *>(data), size);
+  }
+
+  void fill(uint16_t offset, uint8_t value, uint16_t size) {
+    if (offset + size > storage_size)
+      return;
+    for (uint16_t i = 0; i < size; i++) {
+      if (contents_[offset + i] != value) {
+        contents_[offset + i] = value;
+        markDirty(offset + i, 1);
+      }
+    }
+  }
+
+  int compareBlock(uint16_t offset, const void *data, uint16_t size) {
+    if (offset + size > storage_size)
+      return -1;
+    return memcmp(contents_ + offset, data, size);
+  }
+
+  bool isSliceUninitialized(uint16_t offset, uint16_t size) {
+    if (offset + size > storage_size)
+      return false;
+    for (uint16_t i = 0; i < size; i++) {
+      if (contents_[offset + i] != _StorageProps::uninitialized_byte)
+        return false;
+    }
+    return true;
+  }
+
+  const uint16_t length() {
+    return _StorageProps::length;
+  }
+
+  void setup() {
+    memset(contents_, _StorageProps::uninitialized_byte, storage_size);
+    memset(dirty_, 0, sizeof(dirty_));
+    is_dirty_     = false;
+    compact_step_ = 0;
+    scheduler_.clear();
+
+    // Load the newest complete bank
+    active_bank_  = no_bank;
+    uint16_t jseq = 0;
+    for (uint8_t bank = 0; bank < 2; bank++) {
+      uint16_t seq, bank_jseq;
+      if (readBankHeader(bank, seq, bank_jseq) &&
+          (active_bank_ == no_bank || newer(seq, bank_seq_))) {
+        active_bank_ = bank;
+        bank_seq_    = seq;
+        jseq         = bank_jseq;
+      }
+    }
+    if (active_bank_ != no_bank) {
+      flash_.read(bankAddress(active_bank_) + bank_header_size, contents_, storage_size);
+    } else {
+      bank_seq_ = 0;
+    }
+
+    // Find the journals, and the one to replay first
+    uint16_t seqs[2];
+    bool valid[2];
+    for (uint8_t journal = 0; journal < 2; journal++)
+      valid[journal] = readJournalHeader(journal, seqs[journal]);
+
+    if (active_bank_ == no_bank) {
+      if (!valid[0] && !valid[1]) {
+        format();
+        return;
+      }
+      if (valid[0] && valid[1])
+        jseq = newer(seqs[0], seqs[1]) ? seqs[1] : seqs[0];
+      else
+        jseq = valid[0] ? seqs[0] : seqs[1];
+    }
+
+    // Replay the journal the bank was written from, and then the one started
+    // after it, if any.
+    uint8_t replayed = 0;
+    bool writable    = true;
+    for (uint16_t seq = jseq; seq != uint16_t(jseq + 2); seq++) {
+      for (uint8_t journal = 0; journal < 2; journal++) {
+        if (valid[journal] && seqs[journal] == seq) {
+          writable        = replayJournal(journal);
+          active_journal_ = journal;
+          journal_seq_    = seq;
+          replayed++;
+        }
+      }
+    }
+
+    if (replayed == 0) {
+      // A bank, but no journal to go with it: start a fresh one.
+      uint8_t journal = 0;
+      if (!isJournalErased(journal))
+        eraseJournal(journal);
+      startJournal(journal, jseq);
+    }
+    other_journal_used_ = (replayed == 2);
+
+    uint8_t other = 1 - active_journal_;
+    if (!other_journal_used_ && !isJournalErased(other))
+      eraseJournal(other);
+
+    if (!writable)
+      journal_pos_ = journal_size;
+
+    // Finish a compaction that was interrupted.
+    if (other_journal_used_)
+      startCompaction();
+  }
+
+  void commit() {
+    scheduler_.request();
+  }
+
+  void flush() {
+    scheduler_.clear();
+    while (!flushStep(0xffff)) {}
+  }
+
+  // Flushes and compaction are spread over cycles, about one flash page at a
+  // time. Compaction waits for changes to be flushed, so that they don't end up
+  // in a bank before they are due.
+  void betweenCycles() {
+    if (scheduler_.isDue()) {
+      if (flushStep(page_size))
+        scheduler_.clear();
+      return;
+    }
+    if (compact_step_ != 0 && !is_dirty_)
+      compactionStep();
+  }
+
+  void erase() {
+    memset(contents_, _StorageProps::uninitialized_byte, storage_size);
+    memset(dirty_, 0, sizeof(dirty_));
+    is_dirty_ = false;
+    scheduler_.clear();
+    format();
+  }
+};
+
+template<typename _StorageProps>
+typename JournaledFlash<_StorageProps>::Flash JournaledFlash<_StorageProps>::flash_;
+
+template<typename _StorageProps>
+uint8_t JournaledFlash<_StorageProps>::contents_[JournaledFlash<_StorageProps>::storage_size];
+
+template<typename _StorageProps>
+uint8_t JournaledFlash<_StorageProps>::dirty_[(JournaledFlash<_StorageProps>::chunk_count + 7) / 8];
+
+template<typename _StorageProps>
+bool JournaledFlash<_StorageProps>::is_dirty_ = false;
+
+template<typename _StorageProps>
+CommitScheduler<_StorageProps::commit_delay> JournaledFlash<_StorageProps>::scheduler_;
+
+template<typename _StorageProps>
+uint8_t JournaledFlash<_StorageProps>::active_bank_ = 0xff;
+
+template<typename _StorageProps>
+uint16_t JournaledFlash<_StorageProps>::bank_seq_ = 0;
+
+template<typename _StorageProps>
+uint8_t JournaledFlash<_StorageProps>::active_journal_ = 0;
+
+template<typename _StorageProps>
+uint16_t JournaledFlash<_StorageProps>::journal_seq_ = 0;
+
+template<typename _StorageProps>
+uint32_t JournaledFlash<_StorageProps>::journal_pos_ = 0;
+
+template<typename _StorageProps>
+bool JournaledFlash<_StorageProps>::other_journal_used_ = false;
+
+template<typename _StorageProps>
+uint16_t JournaledFlash<_StorageProps>::compact_step_ = 0;
+
+template<typename _StorageProps>
+uint8_t JournaledFlash<_StorageProps>::compact_bank_ = 0;
+
+template<typename _StorageProps>
+uint16_t JournaledFlash<_StorageProps>::compact_jseq_ = 0;
+
+}  // namespace storage
+}  // namespace driver
+}  // namespace kaleidoscope
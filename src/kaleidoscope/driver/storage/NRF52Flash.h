@@ -28,6 +28,7 @@
 #include <Adafruit_LittleFS.h>
 #include <InternalFileSystem.h>
 #include "kaleidoscope/driver/storage/Base.h"
+#include "kaleidoscope/driver/storage/CommitScheduler.h"
 
 namespace kaleidoscope {
 namespace driver {
@@ -49,10 +50,16 @@ template<typename _StorageProps>
 class NRF52Flash : public kaleidoscope::driver::storage::Base<_StorageProps> {
  private:
   static constexpr const char *EEPROM_PATH = "/eeprom.dat";
+  static constexpr const char *TEMP_PATH   = "/eeprom.tmp";
+  // The number of bytes a flush writes per cycle.
+  static constexpr uint16_t flush_budget   = 256;
   static Adafruit_LittleFS_Namespace::File file;
   static bool is_initialized;
   static uint8_t *contents;  // Add buffer to store file contents
   static bool dirty_;        // Add flag to track if contents have changed
+  static CommitScheduler<_StorageProps::commit_delay> scheduler_;
+  static bool flushing_;
+  static uint16_t flush_pos_;
 
   static bool init() {
     if (is_initialized) return true;
@@ -141,26 +148,48 @@ class NRF52Flash : public kaleidoscope::driver::storage::Base<_StorageProps> {
     return result;
   }
 
-  static bool writeToFile() {
-
-    //TODO(jesse): I'd rather truncate the file, but there's a bug in truncate(0)
-    // That causes "assertion "pcache->block == 0xffffffff" failed"
-    // Delete existing file first
-    InternalFS.remove(EEPROM_PATH);
+  // Writes the next `budget` bytes of the contents to a temporary file, which
+  // replaces the old one once complete, so that a flush interrupted by a power
+  // loss leaves the previous file intact. Changes made while a flush is in
+  // progress leave the contents dirty, for the next flush to pick up. Returns
+  // true once there is nothing left to write.
+  static bool flushStep(uint16_t budget) {
+    if (!flushing_) {
+      if (!dirty_)
+        return true;
 
-    // Create new file
-    if (!file.open(EEPROM_PATH, Adafruit_LittleFS_Namespace::FILE_O_WRITE)) {
-      DEBUG_MSG("[NRF52Flash] Failed to open file for writing");
-      return false;
+      //TODO(jesse): I'd rather truncate the file, but there's a bug in truncate(0)
+      // That causes "assertion "pcache->block == 0xffffffff" failed"
+      InternalFS.remove(TEMP_PATH);
+      if (!file.open(TEMP_PATH, Adafruit_LittleFS_Namespace::FILE_O_WRITE)) {
+        DEBUG_MSG("[NRF52Flash] Failed to open file for writing");
+        return true;
+      }
+      dirty_     = false;
+      flushing_  = true;
+      flush_pos_ = 0;
     }
 
-    size_t written = file.write(contents, _StorageProps::length);
-    file.close();
-    if (written != _StorageProps::length) {
+    uint16_t size = _StorageProps::length - flush_pos_;
+    if (size > budget)
+      size = budget;
+    if (file.write(contents + flush_pos_, size) != size) {
       DEBUG_MSG("[NRF52Flash] Write failed");
-      return false;
+      file.close();
+      flushing_ = false;
+      dirty_    = true;
+      return true;
     }
+    flush_pos_ += size;
+    if (flush_pos_ < _StorageProps::length)
+      return false;
 
+    file.close();
+    flushing_ = false;
+    if (!InternalFS.rename(TEMP_PATH, EEPROM_PATH)) {
+      DEBUG_MSG("[NRF52Flash] Failed to replace file");
+      dirty_ = true;
+    }
     return true;
   }
 
@@ -209,31 +238,53 @@ class NRF52Flash : public kaleidoscope::driver::storage::Base<_StorageProps> {
     }
   }
 
-  bool isSliceUninitialized(uint16_t offset, uint16_t size) {
-    if (!file.open(EEPROM_PATH, Adafruit_LittleFS_Namespace::FILE_O_READ)) {
-      return true;
-    }
-    if (!file.seek(offset)) {
-      file.close();
-      return true;
+  void readBlock(uint16_t offset, void *data, uint16_t size) {
+    if (!init() || !checkBounds(offset, size)) {
+      return;
     }
+    memcpy(data, contents + offset, size);
+  }
 
-    uint8_t *buffer  = new uint8_t[size];
-    size_t read_size = file.read(buffer, size);
-    file.close();
+  void writeBlock(uint16_t offset, const void *data, uint16_t size) {
+    if (!init() || !checkBounds(offset, size)) {
+      return;
+    }
+    if (memcmp(contents + offset, data, size) != 0) {
+      memcpy(contents + offset, data, size);
+      dirty_ = true;
+    }
+  }
 
-    bool uninitialized = true;
-    if (read_size == size) {
-      for (uint16_t i = 0; i < size; i++) {
-        if (buffer[i] != _StorageProps::uninitialized_byte) {
-          uninitialized = false;
-          break;
-        }
+  void fill(uint16_t offset, uint8_t value, uint16_t size) {
+    if (!init() || !checkBounds(offset, size)) {
+      return;
+    }
+    for (uint16_t i = 0; i < size; i++) {
+      if (contents[offset + i] != value) {
+        memset(contents + offset, value, size);
+        dirty_ = true;
+        return;
       }
     }
+  }
 
-    delete[] buffer;
-    return uninitialized;
+  int compareBlock(uint16_t offset, const void *data, uint16_t size) {
+    if (!init() || !checkBounds(offset, size)) {
+      return -1;
+    }
+    return memcmp(contents + offset, data, size);
+  }
+
+  bool isSliceUninitialized(uint16_t offset, uint16_t size) {
+    if (!init() || !checkBounds(offset, size)) {
+      return true;
+    }
+    for (uint16_t i = 0; i < size; i++) {
+      if (contents[offset + i] != _StorageProps::uninitialized_byte) {
+        return false;
+      }
+    }
+    return true;
   }
 
   const uint16_t length() {
@@ -247,17 +298,34 @@ class NRF52Flash : public kaleidoscope::driver::storage::Base<_StorageProps> {
     }
   }
 
+  // Every commit rewrites the whole file, so commits are deferred, and
+  // coalesced. The rewrite is then spread over cycles, `flush_budget` bytes at
+  // a time. `flush()` does it all at once.
   void commit() {
-    if (dirty_) {
-      if (writeToFile()) {
-        dirty_ = false;
-      } else {
-        DEBUG_MSG("[NRF52Flash] Write failed");
-      }
+    scheduler_.request();
+  }
+
+  void flush() {
+    scheduler_.clear();
+    // Finish the flush in progress, if any, then write what changed since.
+    while (!flushStep(_StorageProps::length)) {}
+    while (!flushStep(_StorageProps::length)) {}
+  }
+
+  void betweenCycles() {
+    if (flushing_) {
+      flushStep(flush_budget);
+    } else if (scheduler_.isDue()) {
+      scheduler_.clear();
+      flushStep(flush_budget);
     }
   }
 
   void erase() {
+    if (flushing_) {
+      file.close();
+      flushing_ = false;
+    }
     // format the internal filesystem
     InternalFS.format();
     // erase the in-memory contents
@@ -277,6 +345,15 @@ uint8_t *NRF52Flash<_StorageProps>::contents = nullptr;
 template<typename _StorageProps>
 bool NRF52Flash<_StorageProps>::dirty_ = false;
 
+template<typename _StorageProps>
+CommitScheduler<_StorageProps::commit_delay> NRF52Flash<_StorageProps>::scheduler_;
+
+template<typename _StorageProps>
+bool NRF52Flash<_StorageProps>::flushing_ = false;
+
+template<typename _StorageProps>
+uint16_t NRF52Flash<_StorageProps>::flush_pos_ = 0;
+
 }  // namespace storage
 }  // namespace driver
 }  // namespace kaleidoscope
@@ -0,0 +1,111 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifdef KALEIDOSCOPE_VIRTUAL_BUILD
+
+#include <stdint.h>  // for uint8_t, uint16_t, uint32_t
+#include <string.h>  // for memcpy, memset
+
+namespace kaleidoscope {
+namespace driver {
+namespace storage {
+
+// A RAM-backed stand-in for a page of NOR flash, for `JournaledFlash` to run on
+// in the virtual build. Like the real thing, erasing sets a whole page to
+// `0xff`, and programming can only clear bits, in units of `program_unit`
+// bytes. It also counts erases and programmed bytes, and can simulate losing
+// power in the middle of programming.
+template<uint16_t _page_size, uint8_t _page_count>
+class SimulatedFlash {
+ public:
+  static constexpr uint16_t page_size   = _page_size;
+  static constexpr uint8_t page_count   = _page_count;
+  static constexpr uint8_t program_unit = 4;
+
+  SimulatedFlash() {
+    memset(memory_, 0xff, sizeof(memory_));
+  }
+
+  void read(uint32_t address, void *data, uint16_t size) {
+    memcpy(data, memory_ + address, size);
+  }
+
+  void program(uint32_t address, const void *data, uint16_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+    if (address % program_unit != 0 || size % program_unit != 0)
+      program_errors_++;
+
+    for (uint16_t i = 0; i < size; i++) {
+      if (power_left_ == 0)
+        return;
+      if (power_left_ > 0)
+        power_left_--;
+
+      // Programming can't turn a 0 bit back into a 1.
+      if ((memory_[address + i] & bytes[i]) != bytes[i])
+        program_errors_++;
+      memory_[address + i] &= bytes[i];
+      bytes_programmed_++;
+    }
+  }
+
+  void erasePage(uint8_t page) {
+    if (power_left_ == 0)
+      return;
+    memset(memory_ + page * page_size, 0xff, page_size);
+    erase_counts_[page]++;
+  }
+
+  // Stops programming and erasing after `bytes` more bytes have been
+  // programmed, as if the power was cut. A negative value restores power.
+  void cutPowerAfter(int32_t bytes) {
+    power_left_ = bytes;
+  }
+
+  uint32_t eraseCount(uint8_t page) const {
+    return erase_counts_[page];
+  }
+  uint32_t bytesProgrammed() const {
+    return bytes_programmed_;
+  }
+  // The number of times programming was misaligned, or tried to set a bit
+  // that wasn't erased.
+  uint32_t programErrors() const {
+    return program_errors_;
+  }
+
+ private:
+  uint8_t memory_[page_size * page_count];
+  uint32_t erase_counts_[page_count]  = {};
+  uint32_t bytes_programmed_          = 0;
+  uint32_t program_errors_            = 0;
+  int32_t power_left_                 = -1;
+};
+
+}  // namespace storage
+}  // namespace driver
+}  // namespace kaleidoscope
+
+#endif  // ifdef KALEIDOSCOPE_VIRTUAL_BUILD
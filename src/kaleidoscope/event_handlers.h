@@ -241,6 +241,16 @@ class SignatureCheckDummy {};
                 _NOT_ABORTABLE,                                           __NL__ \
                 (),(),(), /* non template */                              __NL__ \
                 (), (), ##__VA_ARGS__)                                    __NL__ \
+   /* Called when the contents of storage were replaced behind the     */ __NL__ \
+   /* back of the plugins that own them, such as by an upload of the   */ __NL__ \
+   /* whole of it. Plugins that keep copies of what they store in RAM  */ __NL__ \
+   /* should reload or drop them.                                      */ __NL__ \
+   OPERATION(onStorageChange,                                             __NL__ \
+             1,                                                           __NL__ \
+             _CURRENT_IMPLEMENTATION,                                     __NL__ \
+                _NOT_ABORTABLE,                                           __NL__ \
+                (),(),(), /* non template */                              __NL__ \
+                (), (), ##__VA_ARGS__)                                    __NL__ \
    /* Called immediately before the LEDs get updated. This is for */      __NL__ \
    /* plugins that override the current LED mode. */                      __NL__ \
    OPERATION(beforeSyncingLeds,                                           __NL__ \
@@ -364,6 +374,10 @@ class SignatureCheckDummy {};
       OP(onLEDModeChange, 1)                                            __NL__ \
    END(onLEDModeChange, 1)                                              __NL__ \
                                                                         __NL__ \
+   START(onStorageChange, 1)                                            __NL__ \
+      OP(onStorageChange, 1)                                            __NL__ \
+   END(onStorageChange, 1)                                              __NL__ \
+                                                                        __NL__ \
    START(beforeSyncingLeds, 1)                                          __NL__ \
       OP(beforeSyncingLeds, 1)                                          __NL__ \
    END(beforeSyncingLeds, 1)                                            __NL__ \
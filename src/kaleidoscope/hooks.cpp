@@ -54,6 +54,12 @@ _FOR_EACH_EVENT_HANDLER(INSTANTIATE_WEAK_HOOK_FUNCTION)
 
 #undef INSTANTIATE_WEAK_HOOK_FUNCTION
 
+// Without KALEIDOSCOPE_INIT_PLUGINS(...), there are no plugins, and therefore
+// no `onAddToReport()` handlers.
+__attribute__((weak)) bool Hooks::onAddToReportIsImplemented() {
+  return false;
+}
+
 namespace sketch_exploration {
 class Sketch;
 }
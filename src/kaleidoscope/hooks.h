@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <stdint.h>  // for uint16_t
+
 #include "kaleidoscope/KeyEvent.h"                 // IWYU pragma: keep
 #include "kaleidoscope/event_handler_result.h"     // for EventHandlerResult
 #include "kaleidoscope/event_handlers.h"           // for _FOR_EACH_EVENT_HANDLER
@@ -36,6 +38,7 @@ class Runtime_;  // IWYU pragma: keep
 namespace plugin {
 // Forward declarations to enable friend declarations.
 class FocusSerial;
+class FocusEEPROMCommand;
 class LEDControl;
 }  // namespace plugin
 
@@ -68,6 +71,7 @@ class Hooks {
   friend class Layer_;
   friend class Runtime_;
   friend class plugin::FocusSerial;
+  friend class plugin::FocusEEPROMCommand;
   friend class plugin::LEDControl;
   friend class driver::ble::BLEBluefruit;  // Allow BLEBluefruit to trigger hooks
   friend void sketch_exploration::pluginsExploreSketch();
@@ -90,6 +94,16 @@ class Hooks {
 
 #undef DEFINE_WEAK_HOOK_FUNCTION
   // clang-format on
+
+  // Returns `true` if any plugin in the sketch implements `onAddToReport()`.
+  // When none do, `Runtime_` can build HID reports from the `live_keys` report
+  // aggregate instead of visiting each active key.
+  static bool onAddToReportIsImplemented();
+
+  // Calls `onFocusEvent()` only for the plugins whose `FOCUS_COMMANDS()` table
+  // has the command. `hash` is the command's hash. With `help` set, the tables
+  // are listed instead.
+  static EventHandlerResult onFocusCommand(const char *input, uint16_t hash, bool help);
 };
 
 }  // namespace kaleidoscope
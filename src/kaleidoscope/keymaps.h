@@ -33,8 +33,10 @@ extern const Key keymaps_linear[][kaleidoscope_internal::device.matrix_rows * ka
 
 namespace kaleidoscope {
 
-inline Key keyFromKeymap(uint8_t layer, KeyAddr key_addr) {
-  return keymaps_linear[layer][key_addr.toInt()].readFromProgmem();
-}
+// Looks a key up in the keymap defined by `KEYMAPS()`. The default version reads
+// `keymaps_linear`; when the sketch defines `KALEIDOSCOPE_SPARSE_KEYMAPS`,
+// `KEYMAPS()` replaces it with one that reads the sparse encoding of the keymap
+// instead, so that `keymaps_linear` isn't needed in the firmware at all.
+Key keyFromKeymap(uint8_t layer, KeyAddr key_addr);
 
 }  // namespace kaleidoscope
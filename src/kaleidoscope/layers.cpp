@@ -24,6 +24,7 @@
 #include <string.h>  // for memmove, memset
 
 #include "kaleidoscope/KeyAddr.h"          // for MatrixAddr, MatrixAddr<>::Range, KeyAddr
+#include "kaleidoscope/KeyAddrBitfield.h"  // for KeyAddrBitfield, KeyAddrBitfield::Iterator
 #include "kaleidoscope/KeyAddrMap.h"       // for KeyAddrMap<>::Iterator, KeyAddrMap
 #include "kaleidoscope/KeyEvent.h"         // for KeyEvent
 #include "kaleidoscope/KeyMap.h"           // for KeyMap
@@ -56,9 +57,14 @@ int8_t Layer_::active_layers_[MAX_ACTIVE_LAYERS];
 uint8_t Layer_::active_layer_keymap_[kaleidoscope_internal::device.numKeys()];
 Layer_::GetKeyFunction Layer_::getKey = &Layer_::getKeyFromPROGMEM;
 
+KeyAddrBitfield Layer_::layer_masks_[MAX_MASKED_LAYERS];
+Layer_::GetKeyFunction Layer_::masked_get_key_ = nullptr;
+uint8_t Layer_::masked_layer_count_;
+
 void Layer_::setup() {
-  // Update the active layer cache (every entry will be `0` to start)
-  Layer.updateActiveLayers();
+  // Compute the layer masks, and update the active layer cache (every entry
+  // will be `0` to start)
+  Layer.updateLayerMasks();
 }
 
 void Layer_::handleLayerKeyEvent(const KeyEvent &event) {
@@ -103,7 +109,7 @@ void Layer_::handleLayerKeyEvent(const KeyEvent &event) {
         activate(target_layer_shifted);
         // We can't just change `event.key` here because `live_keys[]` has
         // already been updated by the time `handleLayerKeyEvent()` gets called.
-        live_keys[event.addr] = ShiftToLayer(target_layer);
+        live_keys.activate(event.addr, ShiftToLayer(target_layer));
       }
       break;
 
@@ -144,33 +150,65 @@ void Layer_::handleLayerKeyEvent(const KeyEvent &event) {
   }
 }
 
+__attribute__((weak)) Key keyFromKeymap(uint8_t layer, KeyAddr key_addr) {
+  return keymaps_linear[layer][key_addr.toInt()].readFromProgmem();
+}
+
 Key Layer_::getKeyFromPROGMEM(uint8_t layer, KeyAddr key_addr) {
   return keyFromKeymap(layer, key_addr);
 }
 
-void Layer_::updateActiveLayers(void) {
-  // First, set every entry in the active layer keymap to point to the default
-  // layer (layer 0).
-  memset(active_layer_keymap_, 0, kaleidoscope_internal::device.numKeys());
+void Layer_::updateLayerMasks(void) {
+  masked_get_key_     = getKey;
+  masked_layer_count_ = layer_count;
+
+  for (uint8_t layer = 0; layer < MAX_MASKED_LAYERS; ++layer) {
+    layer_masks_[layer].clear();
+    if (layer >= layer_count)
+      continue;
+    for (auto key_addr : KeyAddr::all()) {
+      if ((*getKey)(layer, key_addr) != Key_Transparent)
+        layer_masks_[layer].set(key_addr);
+    }
+  }
 
-  // For each key address, set its entry in the active layer keymap to the value
-  // of the top active layer that has a non-transparent entry for that address.
-  for (auto key_addr : KeyAddr::all()) {
-    for (uint8_t i = active_layer_count_; i > 0; --i) {
-      uint8_t layer = unshifted(active_layers_[i - 1]);
+  updateActiveLayers();
+}
 
-      Key key = (*getKey)(layer, key_addr);
-      if (key != Key_Transparent) {
-        active_layer_keymap_[key_addr.toInt()] = layer;
-        break;
-      }
-    }
+// If `getKey` or `layer_count` changed since the layer masks were computed,
+// recompute them (and the whole active layer cache), and return `true`.
+bool Layer_::refreshLayerMasks() {
+  if (getKey == masked_get_key_ && layer_count == masked_layer_count_)
+    return false;
+  updateLayerMasks();
+  return true;
+}
+
+bool Layer_::isTransparent(uint8_t layer, KeyAddr key_addr) {
+  if (layer < MAX_MASKED_LAYERS)
+    return !layer_masks_[layer].read(key_addr);
+  return (*getKey)(layer, key_addr) == Key_Transparent;
+}
+
+// Returns the top active layer that has a non-transparent entry for
+// `key_addr`. Even if there are no active layers (a situation that should be
+// prevented by `deactivate()`), each key will be mapped from the base layer
+// (layer 0). Likewise, for any address where all active layers have a
+// transparent entry, that key will be mapped from the base layer, even if the
+// base layer has been deactivated.
+uint8_t Layer_::resolveLayer(KeyAddr key_addr) {
+  for (uint8_t i = active_layer_count_; i > 0; --i) {
+    uint8_t layer = unshifted(active_layers_[i - 1]);
+    if (!isTransparent(layer, key_addr))
+      return layer;
+  }
+  return 0;
+}
+
+void Layer_::updateActiveLayers(void) {
+  for (auto key_addr : KeyAddr::all()) {
+    active_layer_keymap_[key_addr.toInt()] = resolveLayer(key_addr);
   }
-  // Even if there are no active layers (a situation that should be prevented by
-  // `deactivate()`), each key will be mapped from the base layer (layer
-  // 0). Likewise, for any address where all active layers have a transparent
-  // entry, that key will be mapped from the base layer, even if the base layer
-  // has been deactivated.
 }
 
 void Layer_::move(uint8_t layer) {
@@ -183,7 +221,8 @@ void Layer_::move(uint8_t layer) {
   active_layer_count_ = 1;
   active_layers_[0]   = layer;
 
-  updateActiveLayers();
+  if (!refreshLayerMasks())
+    updateActiveLayers();
 
   kaleidoscope::Hooks::onLayerChange();
 }
@@ -204,16 +243,33 @@ void Layer_::activate(uint8_t layer) {
 
   // Guarantee that we don't overflow by removing layers from the bottom if
   // we're about to exceed the size of the active layers array.
+  bool removed_bottom = false;
   while (active_layer_count_ >= MAX_ACTIVE_LAYERS) {
     remove(0);
+    removed_bottom = true;
   }
 
   // Otherwise, push it onto the active layer stack
   active_layers_[active_layer_count_++] = layer;
 
   // Update the keymap cache (but not live_composite_keymap_; that gets
-  // updated separately, when keys toggle on or off. See layers.h)
-  updateActiveLayers();
+  // updated separately, when keys toggle on or off. See layers.h). The new
+  // layer is on top, so only the keys it doesn't have as transparent change,
+  // unless layers had to be removed from the bottom too.
+  if (!refreshLayerMasks()) {
+    if (removed_bottom) {
+      updateActiveLayers();
+    } else if (layer_unshifted < MAX_MASKED_LAYERS) {
+      for (KeyAddr key_addr : layer_masks_[layer_unshifted]) {
+        active_layer_keymap_[key_addr.toInt()] = layer_unshifted;
+      }
+    } else {
+      for (auto key_addr : KeyAddr::all()) {
+        if (!isTransparent(layer_unshifted, key_addr))
+          active_layer_keymap_[key_addr.toInt()] = layer_unshifted;
+      }
+    }
+  }
 
   kaleidoscope::Hooks::onLayerChange();
 }
@@ -242,8 +298,15 @@ void Layer_::deactivate(uint8_t layer) {
   // above it down to fill in the gap.
   remove(current_pos);
 
-  // Update the keymap cache.
-  updateActiveLayers();
+  // Update the keymap cache. Only the keys that were mapped from the removed
+  // layer can change.
+  if (!refreshLayerMasks()) {
+    uint8_t layer_unshifted = unshifted(layer);
+    for (auto key_addr : KeyAddr::all()) {
+      if (active_layer_keymap_[key_addr.toInt()] == layer_unshifted)
+        active_layer_keymap_[key_addr.toInt()] = resolveLayer(key_addr);
+    }
+  }
 
   kaleidoscope::Hooks::onLayerChange();
 }
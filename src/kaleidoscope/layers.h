@@ -26,7 +26,9 @@
 #include <stdint.h>   // for uint8_t, int8_t
 
 #include "kaleidoscope/KeyAddr.h"                                         // for KeyAddr
+#include "kaleidoscope/KeyAddrBitfield.h"                                 // for KeyAddrBitfield
 #include "kaleidoscope/KeyEvent.h"                                        // for KeyEvent
+#include "kaleidoscope/SparseKeymap.h"                                    // for Table, countKeys
 #include "kaleidoscope/device/device.h"                                   // for Device
 #include "kaleidoscope/key_defs.h"                                        // for Key
 #include "kaleidoscope/keymaps.h"                                         // IWYU pragma: keep
@@ -52,6 +54,14 @@
 #define MAX_ACTIVE_LAYERS 16
 #endif
 
+// The number of layers for which `Layer` keeps a bitmap of the keys that aren't
+// transparent, to update the active layer cache without reading the keymap.
+// Each one takes one bit per key of RAM; layers beyond this still work, but are
+// read from the keymap whenever they are activated or deactivated.
+#ifndef MAX_MASKED_LAYERS
+#define MAX_MASKED_LAYERS 8
+#endif
+
 #define START_KEYMAPS                                                   __NL__ \
    constexpr Key keymaps_linear[][kaleidoscope_internal::device.matrix_rows * kaleidoscope_internal::device.matrix_columns] PROGMEM = {
 
@@ -60,10 +70,35 @@
    uint8_t layer_count                                                  __NL__ \
       = sizeof(keymaps_linear) / sizeof(*keymaps_linear);               __NL__ \
                                                                         __NL__ \
+  _INIT_SPARSE_KEYMAPS                                                  __NL__ \
   _INIT_SKETCH_EXPLORATION                                              __NL__ \
   _INIT_HID_GETSHORTNAME
   // TODO(jesse): re-enable GETSHORTNAME once we figure out how to do that for non-keyboardiohid devices
 
+// When the sketch defines `KALEIDOSCOPE_SPARSE_KEYMAPS` before including
+// Kaleidoscope.h, `KEYMAPS()` also encodes the keymap as a
+// `sparse_keymap::Table` at compile time, and looks keys up from that. Nothing
+// refers to `keymaps_linear` then, so it is left out of the firmware.
+#ifdef KALEIDOSCOPE_SPARSE_KEYMAPS
+#define _INIT_SPARSE_KEYMAPS                                            __NL__ \
+  namespace kaleidoscope_internal {                                     __NL__ \
+  typedef ::kaleidoscope::sparse_keymap::Table<                         __NL__ \
+    sizeof(::keymaps_linear) / sizeof(*::keymaps_linear),               __NL__ \
+    ::kaleidoscope::sparse_keymap::countKeys(::keymaps_linear)>         __NL__ \
+    SparseKeymap;                                                       __NL__ \
+  constexpr SparseKeymap sparse_keymaps PROGMEM =                       __NL__ \
+    SparseKeymap(::keymaps_linear);                                     __NL__ \
+  }                                                                     __NL__ \
+  namespace kaleidoscope {                                              __NL__ \
+  Key keyFromKeymap(uint8_t layer, KeyAddr key_addr) {                  __NL__ \
+    return ::kaleidoscope_internal::sparse_keymaps                      __NL__ \
+      .lookup(layer, key_addr);                                         __NL__ \
+  }                                                                     __NL__ \
+  }
+#else
+#define _INIT_SPARSE_KEYMAPS
+#endif
+
 // Macro for defining the keymap. This should be used in the sketch
 // file (*.ino) to define the keymap[] array that holds the user's
 // layers. It also computes the number of layers in that keymap.
@@ -137,6 +172,12 @@ class Layer_ {
 
   static void updateActiveLayers(void);
 
+  // Recomputes which keys of each layer are not transparent, and then the
+  // active layer cache. Changing `getKey` or `layer_count` is detected by the
+  // next layer change, but anything that changes the contents of the keymap
+  // has to call this.
+  static void updateLayerMasks(void);
+
  private:
   using forEachHandler = void (*)(uint8_t index, uint8_t layer);
 
@@ -148,6 +189,17 @@ class Layer_ {
   static int8_t active_layers_[MAX_ACTIVE_LAYERS];
   static uint8_t active_layer_keymap_[kaleidoscope_internal::device.numKeys()];
 
+  // For each of the first `MAX_MASKED_LAYERS` layers, the keys that are not
+  // transparent on that layer, and the `getKey` and `layer_count` they were
+  // computed with.
+  static KeyAddrBitfield layer_masks_[MAX_MASKED_LAYERS];
+  static GetKeyFunction masked_get_key_;
+  static uint8_t masked_layer_count_;
+
+  static bool isTransparent(uint8_t layer, KeyAddr key_addr);
+  static uint8_t resolveLayer(KeyAddr key_addr);
+  static bool refreshLayerMasks();
+
   static int8_t stackPosition(uint8_t layer);
   static void remove(uint8_t stack_index);
   static uint8_t unshifted(uint8_t layer);
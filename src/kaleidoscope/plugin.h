@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <stdint.h>  // for uint16_t
+
 #if KALEIDOSCOPE_ENABLE_V1_PLUGIN_API
 #error The V1 plugin API has been removed, please see UPGRADING.md.
 #endif
@@ -33,6 +35,14 @@ class Plugin {
  public:
   // Please see "event_handlers.h" for a list of supported event handlers and
   // their documentation!
+
+  // Focus commands are only offered to the plugins that handle them. Plugins
+  // list theirs with `FOCUS_COMMANDS()` (see Kaleidoscope-FocusSerial), which
+  // hides this default: plugins that don't are offered every command, and
+  // asked for help with the others.
+  static bool focusCommand(uint16_t /*hash*/, const char * /*command*/) {
+    return true;
+  }
 };
 
 }  // namespace kaleidoscope
@@ -22,9 +22,10 @@
 
 #include "kaleidoscope/plugin/LEDControl.h"
 
-#include <Arduino.h>                   // for PSTR, strncmp_P
+#include <Arduino.h>                   // for bitRead, bitSet, micros, PSTR, strncmp_P
 #include <Kaleidoscope-FocusSerial.h>  // for Focus, FocusSerial
 
+#include "kaleidoscope/KeyAddrBitfield.h"          // for bitfieldSize
 #include "kaleidoscope/KeyAddrMap.h"               // for KeyAddrMap<>::Iterator, KeyAddrMap
 #include "kaleidoscope/KeyEvent.h"                 // for KeyEvent
 #include "kaleidoscope/KeyMap.h"                   // for KeyMap
@@ -44,12 +45,25 @@ uint8_t LEDControl::mode_id_       = uninitialized_mode_id;
 uint8_t LEDControl::num_led_modes_ = LEDModeManager::numLEDModes();
 LEDMode *LEDControl::cur_led_mode_ = nullptr;
 bool LEDControl::enabled_          = true;
+LEDOverlay *LEDControl::overlays_  = nullptr;
+
+cRGB LEDControl::frame_[];
 
 LEDControl::LEDControl(void) {
 }
 uint8_t LEDControl::sync_interval_   = 32;
 uint16_t LEDControl::last_sync_time_ = 0;
 
+uint16_t LEDControl::last_frame_time_    = 0;
+uint16_t LEDControl::last_stats_time_    = 0;
+uint16_t LEDControl::frames_this_second_ = 0;
+uint16_t LEDControl::frames_per_second_  = 0;
+uint16_t LEDControl::frame_overruns_     = 0;
+uint16_t LEDControl::deferred_frames_    = 0;
+uint8_t LEDControl::next_slice_          = 0;
+bool LEDControl::key_event_seen_         = false;
+bool LEDControl::skip_frame_             = false;
+
 void LEDControl::next_mode() {
   ++mode_id_;
 
@@ -81,6 +95,9 @@ void LEDControl::set_mode(uint8_t mode_) {
   //
   cur_led_mode_ = LEDModeManager::getLEDMode(mode_id_);
 
+  last_frame_time_ = Runtime.millisAtCycleStart();
+  next_slice_      = 0;
+  skip_frame_      = false;
   refreshAll();
 
   Hooks::onLEDModeChange();
@@ -115,27 +132,20 @@ void LEDControl::set_all_leds_to(cRGB color) {
   if (!Runtime.has_leds)
     return;
 
-  bool will_be_on = (color.r != 0 || color.g != 0 || color.b != 0);
-  bool was_off    = !Runtime.device().ledDriver().areAnyLEDsOn();
-
-  for (auto led_index : Runtime.device().LEDs().all()) {
-    Runtime.device().ledDriver().setCrgbAt(led_index.offset(), color);
+  for (uint8_t led_index = 0; led_index < led_count_; led_index++) {
+    frame_[led_index] = color;
   }
-
-  Runtime.device().ledDriver().updateAllLEDState(will_be_on, was_off);
 }
 
 void LEDControl::setCrgbAt(uint8_t led_index, cRGB crgb) {
   if (!Runtime.has_leds)
     return;
 
-  // Check LED state change
-  cRGB current    = Runtime.device().ledDriver().getCrgbAt(led_index);
-  bool was_off    = (current.r == 0 && current.g == 0 && current.b == 0);
-  bool will_be_on = (crgb.r != 0 || crgb.g != 0 || crgb.b != 0);
+  // Keys without an LED have an index of `no_led`, which is out of range too.
+  if (led_index >= led_count_)
+    return;
 
-  Runtime.device().ledDriver().setCrgbAt(led_index, crgb);
-  Runtime.device().ledDriver().updateLEDState(will_be_on, was_off);
+  frame_[led_index] = crgb;
 }
 
 void LEDControl::setCrgbAt(KeyAddr key_addr, cRGB color) {
@@ -143,22 +153,84 @@ void LEDControl::setCrgbAt(KeyAddr key_addr, cRGB color) {
 }
 
 cRGB LEDControl::getCrgbAt(uint8_t led_index) {
-  return Runtime.device().getCrgbAt(led_index);
+  if (led_index >= led_count_)
+    return CRGB(0, 0, 0);
+
+  return frame_[led_index];
 }
 cRGB LEDControl::getCrgbAt(KeyAddr key_addr) {
-  return Runtime.device().getCrgbAt(Runtime.device().getLedIndex(key_addr));
+  return getCrgbAt(Runtime.device().getLedIndex(key_addr));
+}
+
+void LEDControl::addOverlay(LEDOverlay &overlay) {
+  for (LEDOverlay *o = overlays_; o != nullptr; o = o->next_) {
+    if (o == &overlay)
+      return;
+  }
+
+  // The list starts with the topmost overlay.
+  overlay.next_ = overlays_;
+  overlays_     = &overlay;
+}
+
+void LEDControl::composite() {
+  if (!Runtime.has_leds)
+    return;
+
+  // One bit per LED, set once it was painted by an overlay, so that every LED
+  // is written to the driver at most once per frame.
+  uint8_t painted[bitfieldSize(led_count_ > 0 ? led_count_ : 1)] = {};
+
+  if (enabled_) {
+    for (LEDOverlay *overlay = overlays_; overlay != nullptr; overlay = overlay->next_) {
+      for (KeyAddr key_addr : overlay->mask_) {
+        uint8_t led_index = Runtime.device().getLedIndex(key_addr);
+        if (led_index >= led_count_ || bitRead(painted[led_index / 8], led_index % 8))
+          continue;
+
+        cRGB color;
+        if (!overlay->overlayColorAt(key_addr, color))
+          continue;
+
+        bitSet(painted[led_index / 8], led_index % 8);
+        Runtime.device().ledDriver().setCrgbAt(led_index, color);
+      }
+    }
+  }
+
+  // The rest of the frame goes to the driver in runs of LEDs no overlay
+  // painted: without any overlays, that is a single `blit()` of the whole
+  // frame, which the driver compares with what it has in bulk.
+  uint8_t first = 0;
+  while (first < led_count_) {
+    if (bitRead(painted[first / 8], first % 8)) {
+      first++;
+      continue;
+    }
+
+    uint8_t end = first + 1;
+    while (end < led_count_ && !bitRead(painted[end / 8], end % 8))
+      end++;
+
+    Runtime.device().ledDriver().blit(&frame_[first], first, end - first);
+    first = end;
+  }
+}
+
+void LEDControl::showFrame(void) {
+  composite();
+  Runtime.device().syncLeds();
 }
 
 void LEDControl::syncLeds(void) {
   if (!enabled_)
     return;
 
-  // This would be a good spot to introduce a new hook function so that a plugin
-  // that needs to override the color of an LED used by an LED mode can do so
-  // efficiently.
+  // Plugins that predate overlays paint over the frame of the LED mode from
+  // this hook, and rely on `refreshAt()` to undo it.
   Hooks::beforeSyncingLeds();
 
-  Runtime.device().syncLeds();
+  showFrame();
 }
 
 EventHandlerResult LEDControl::onSetup() {
@@ -174,18 +246,27 @@ EventHandlerResult LEDControl::onSetup() {
 }
 
 void LEDControl::disable() {
-  set_all_leds_to(CRGB(0, 0, 0));
-  Runtime.device().syncLeds();
   enabled_ = false;
+  set_all_leds_to(CRGB(0, 0, 0));
+  showFrame();
 }
 
 void LEDControl::enable() {
-  enabled_ = true;
+  enabled_         = true;
+  last_frame_time_ = Runtime.millisAtCycleStart();
+  next_slice_      = 0;
   refreshAll();
-  Runtime.device().syncLeds();
+  showFrame();
+}
+
+EventHandlerResult LEDControl::onKeyswitchEvent(KeyEvent &event) {
+  key_event_seen_ = true;
+  return EventHandlerResult::OK;
 }
 
 EventHandlerResult LEDControl::onKeyEvent(KeyEvent &event) {
+  key_event_seen_ = true;
+
   if (event.key.getFlags() != (SYNTHETIC | IS_INTERNAL | LED_TOGGLE))
     return EventHandlerResult::OK;
 
@@ -222,16 +303,79 @@ EventHandlerResult LEDControl::onKeyEvent(KeyEvent &event) {
   return EventHandlerResult::EVENT_CONSUMED;
 }
 
+void LEDControl::runSlice(uint16_t interval) {
+  uint16_t budget = cur_led_mode_->frameBudget();
+  uint32_t start  = micros();
+
+  cur_led_mode_->updateSlice(next_slice_);
+
+  if (budget != 0 && micros() - start > budget) {
+    frame_overruns_++;
+    skip_frame_ = true;
+  }
+
+  if (++next_slice_ < cur_led_mode_->frameSlices())
+    return;
+
+  // The frame is complete, and will be shown by the next sync.
+  next_slice_ = 0;
+  frames_this_second_++;
+
+  // A frame that is late by more than an interval is not made up for.
+  last_frame_time_ += interval;
+  if (Runtime.hasTimeExpired(last_frame_time_, interval))
+    last_frame_time_ = Runtime.millisAtCycleStart();
+}
+
 EventHandlerResult LEDControl::afterEachCycle() {
+  bool key_event_seen = key_event_seen_;
+  key_event_seen_     = false;
+
+  if (Runtime.hasTimeExpired(last_stats_time_, uint16_t(1000))) {
+    frames_per_second_  = frames_this_second_;
+    frames_this_second_ = 0;
+    last_stats_time_    = Runtime.millisAtCycleStart();
+  }
+
   if (!enabled_)
     return EventHandlerResult::OK;
 
-  if (Runtime.hasTimeExpired(last_sync_time_, sync_interval_)) {
+  // While a frame is painted in slices, the LEDs keep showing the previous
+  // one: syncing is held until the last slice is painted.
+  if (next_slice_ == 0 && Runtime.hasTimeExpired(last_sync_time_, sync_interval_)) {
     syncLeds();
     last_sync_time_ += sync_interval_;
-    update();
+    // Syncing takes long enough on its own, the frame can wait for the next
+    // cycle.
+    return EventHandlerResult::OK;
+  }
+
+  if (!Runtime.has_leds || cur_led_mode_ == nullptr)
+    return EventHandlerResult::OK;
+
+  uint16_t interval = cur_led_mode_->frameInterval();
+  if (interval == 0)
+    interval = sync_interval_;
+
+  // Once a frame is started, its slices are painted one per cycle.
+  if (next_slice_ == 0 && !Runtime.hasTimeExpired(last_frame_time_, interval))
+    return EventHandlerResult::OK;
+
+  // Typing comes first: while keys are toggling, frames are deferred, one cycle
+  // at a time, so that an animation never delays the next scan.
+  if (key_event_seen) {
+    deferred_frames_++;
+    return EventHandlerResult::OK;
   }
 
+  if (next_slice_ == 0 && skip_frame_) {
+    skip_frame_      = false;
+    last_frame_time_ = Runtime.millisAtCycleStart();
+    return EventHandlerResult::OK;
+  }
+
+  runSlice(interval);
+
   return EventHandlerResult::OK;
 }
 
@@ -33,6 +33,7 @@
 #include "kaleidoscope/plugin.h"                   // for Plugin
 #include "kaleidoscope/plugin/LEDMode.h"           // for LEDMode
 #include "kaleidoscope/plugin/LEDModeInterface.h"  // for LEDModeInterface
+#include "kaleidoscope/plugin/LEDOverlay.h"        // for LEDOverlay
 
 constexpr uint8_t LED_TOGGLE = 0b00000001;  // Synthetic, internal
 
@@ -54,8 +55,13 @@ class LEDControl : public kaleidoscope::Plugin {
     if (!Runtime.has_leds)
       return;
 
-    if (cur_led_mode_ != nullptr)
-      cur_led_mode_->update();
+    if (cur_led_mode_ == nullptr)
+      return;
+
+    // Paints a whole frame, even if the mode paints it in slices
+    for (uint8_t slice = 0; slice < cur_led_mode_->frameSlices(); slice++)
+      cur_led_mode_->updateSlice(slice);
+    next_slice_ = 0;
   }
   static void refreshAt(KeyAddr key_addr) {
     if (!Runtime.has_leds)
@@ -89,11 +95,20 @@ class LEDControl : public kaleidoscope::Plugin {
       cur_led_mode_->onActivate();
   }
 
+  // LED modes paint into a frame buffer, which is composited with the
+  // overlays, and written to the LED driver once per frame, by `syncLeds()`.
+  // Only the LEDs whose color changed since the previous frame are written.
   static void setCrgbAt(uint8_t led_index, cRGB crgb);
   static void setCrgbAt(KeyAddr key_addr, cRGB color);
   static cRGB getCrgbAt(uint8_t led_index);
   static cRGB getCrgbAt(KeyAddr key_addr);
   static void syncLeds(void);
+  // Composites the frame, and sends it to the LEDs, without calling the
+  // `beforeSyncingLeds()` hooks. The overlays are left out while LEDs are
+  // disabled.
+  static void showFrame(void);
+
+  static void addOverlay(LEDOverlay &overlay);
 
   static void set_all_leds_to(uint8_t r, uint8_t g, uint8_t b);
   static void set_all_leds_to(cRGB color);
@@ -108,7 +123,25 @@ class LEDControl : public kaleidoscope::Plugin {
     sync_interval_ = interval;
   }
 
+  // Frame statistics of the active LED mode: the number of frames in the last
+  // second, the number of frames that took longer than the mode's budget, and
+  // the number of cycles a due frame was deferred by, because of key events.
+  static uint16_t framesPerSecond() {
+    return frames_per_second_;
+  }
+  static uint16_t frameOverruns() {
+    return frame_overruns_;
+  }
+  static uint16_t deferredFrames() {
+    return deferred_frames_;
+  }
+  static void resetFrameStats() {
+    frame_overruns_  = 0;
+    deferred_frames_ = 0;
+  }
+
   EventHandlerResult onSetup();
+  EventHandlerResult onKeyswitchEvent(KeyEvent &event);
   EventHandlerResult onKeyEvent(KeyEvent &event);
   EventHandlerResult afterEachCycle();
 
@@ -126,6 +159,25 @@ class LEDControl : public kaleidoscope::Plugin {
   }
 
  private:
+  static constexpr uint8_t led_count_ = kaleidoscope::Device::led_count;
+
+  static cRGB frame_[led_count_ > 0 ? led_count_ : 1];
+  static LEDOverlay *overlays_;
+
+  static void composite(void);
+
+  static uint16_t last_frame_time_;
+  static uint16_t last_stats_time_;
+  static uint16_t frames_this_second_;
+  static uint16_t frames_per_second_;
+  static uint16_t frame_overruns_;
+  static uint16_t deferred_frames_;
+  static uint8_t next_slice_;
+  static bool key_event_seen_;
+  static bool skip_frame_;
+
+  static void runSlice(uint16_t interval);
+
   static uint16_t last_sync_time_;
   static uint8_t sync_interval_;
   static uint8_t mode_id_;
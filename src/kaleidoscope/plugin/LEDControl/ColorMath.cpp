@@ -0,0 +1,143 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kaleidoscope/plugin/LEDControl/ColorMath.h"
+
+#include <Arduino.h>  // for pgm_read_byte, PROGMEM
+#include <stdint.h>   // for uint8_t, uint16_t
+
+#include "kaleidoscope/device/device.h"                 // for cRGB
+#include "kaleidoscope/driver/color/GammaCorrection.h"  // for gamma_correction
+
+namespace kaleidoscope {
+namespace color_math {
+
+// The rising half of a breath: the `3x² - 2x³` curve breath_compute() used to
+// compute on every call (adapted from FastLED's lib8tion), scaled to 0-128, and
+// offset by 80.
+static const uint8_t breath_curve[] PROGMEM = {
+  // clang-format off
+   80,  80,  80,  80,  80,  80,  80,  80,  81,  81,  81,  81,  83,  83,  84,  84,
+   86,  86,  87,  87,  89,  89,  89,  91,  92,  92,  93,  94,  96,  97,  98,  99,
+  100, 101, 103, 103, 105, 105, 107, 107, 110, 111, 112, 113, 115, 116, 118, 119,
+  121, 121, 123, 125, 126, 127, 129, 130, 132, 133, 135, 137, 138, 140, 141, 143,
+  144, 146, 147, 149, 150, 152, 153, 154, 156, 157, 158, 160, 162, 163, 165, 166,
+  168, 169, 170, 171, 173, 174, 175, 177, 178, 179, 181, 182, 184, 184, 186, 187,
+  188, 189, 191, 191, 193, 193, 194, 195, 196, 197, 198, 199, 200, 200, 201, 202,
+  203, 203, 204, 204, 205, 205, 205, 206, 207, 207, 207, 208, 208, 208, 208, 208,
+  // clang-format on
+};
+
+// Which of the `v`, `p`, `q` and `t` values of hsvToRgb() go to the red, green
+// and blue channels, two bits each, for each sixth of the color wheel.
+enum : uint8_t { V, P, Q, T };
+#define HSV_REGION(r, g, b) ((r) | ((g) << 2) | ((b) << 4))
+static const uint8_t hsv_regions[] PROGMEM = {
+  HSV_REGION(V, T, P),
+  HSV_REGION(Q, V, P),
+  HSV_REGION(P, V, T),
+  HSV_REGION(P, Q, V),
+  HSV_REGION(T, P, V),
+  HSV_REGION(V, P, Q),
+};
+#undef HSV_REGION
+
+uint8_t breath8(uint8_t phase) {
+  if (phase & 0x80)
+    phase = 255 - phase;
+  return pgm_read_byte(&breath_curve[phase]);
+}
+
+uint8_t gamma8(uint8_t i) {
+  return pgm_read_byte(&driver::color::gamma_correction[i]);
+}
+
+// Integer HSV to RGB conversion, originally from
+// http://web.mit.edu/storborg/Public/hsvtorgb.c. All the multiplications are
+// 8x8 bits, and the color cone region is looked up, rather than switched on.
+cRGB hsvToRgb(uint8_t hue, uint8_t saturation, uint8_t value) {
+  cRGB color;
+
+  if (saturation == 0) {
+    // color is grayscale
+    color.r = color.g = color.b = value;
+    return color;
+  }
+
+  // make hue 0-5, and find the remainder part, from 0 to 255
+  uint16_t hue6   = hue * 6;
+  uint8_t region  = hue6 >> 8;
+  uint8_t fpart   = hue6 & 0xff;
+  uint8_t vals[4] = {
+    value,
+    uint8_t(((uint16_t)value * uint8_t(255 - saturation)) >> 8),
+    uint8_t(((uint16_t)value * uint8_t(255 - (((uint16_t)saturation * fpart) >> 8))) >> 8),
+    uint8_t(((uint16_t)value * uint8_t(255 - (((uint16_t)saturation * uint8_t(255 - fpart)) >> 8))) >> 8),
+  };
+
+  uint8_t channels = pgm_read_byte(&hsv_regions[region]);
+  color.r          = vals[channels & 0x03];
+  color.g          = vals[(channels >> 2) & 0x03];
+  color.b          = vals[(channels >> 4) & 0x03];
+
+  return color;
+}
+
+cRGB paletteColor(const cRGB *palette, uint8_t length, uint8_t position) {
+  // 8.8 fixed point index into the palette, with the last color at 255
+  uint16_t index   = position == 255 ? (length - 1) << 8 : position * (length - 1);
+  uint8_t fraction = index & 0xff;
+  const cRGB *from = &palette[index >> 8];
+  const cRGB *to   = fraction ? from + 1 : from;
+
+  cRGB color;
+  color.r = lerp8(pgm_read_byte(&from->r), pgm_read_byte(&to->r), fraction);
+  color.g = lerp8(pgm_read_byte(&from->g), pgm_read_byte(&to->g), fraction);
+  color.b = lerp8(pgm_read_byte(&from->b), pgm_read_byte(&to->b), fraction);
+  return color;
+}
+
+void hsvToRgb(cRGB *colors, const uint8_t *hues, uint8_t count, uint8_t saturation, uint8_t value) {
+  for (uint8_t i = 0; i < count; i++)
+    colors[i] = hsvToRgb(hues[i], saturation, value);
+}
+
+void paletteColors(cRGB *colors, const uint8_t *positions, uint8_t count, const cRGB *palette, uint8_t length) {
+  for (uint8_t i = 0; i < count; i++)
+    colors[i] = paletteColor(palette, length, positions[i]);
+}
+
+void nscale8(cRGB *colors, uint8_t count, uint8_t scale) {
+  for (uint8_t i = 0; i < count; i++)
+    nscale8(colors[i], scale);
+}
+
+void gamma8(cRGB *colors, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    colors[i].r = gamma8(colors[i].r);
+    colors[i].g = gamma8(colors[i].g);
+    colors[i].b = gamma8(colors[i].b);
+  }
+}
+
+}  // namespace color_math
+}  // namespace kaleidoscope
@@ -0,0 +1,88 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>  // for uint8_t, uint16_t
+
+#include "kaleidoscope/device/device.h"  // for cRGB
+
+namespace kaleidoscope {
+namespace color_math {
+
+// Integer color math for LED modes, for MCUs without a floating point unit,
+// and with an 8x8 bit hardware multiplier at best.
+//
+// Fractions are 8-bit fixed point: a `uint8_t` fraction `f` stands for
+// `f / 256`, except for `scale8()`, which treats 255 as a whole, so that scaling
+// by 255 leaves a value unchanged.
+
+// Scales `i` by `scale / 256`, or leaves it alone if `scale` is 255.
+inline uint8_t scale8(uint8_t i, uint8_t scale) {
+  return (((uint16_t)i * scale) + i) >> 8;
+}
+
+// Linear interpolation from `a` to `b`, by `fraction`.
+inline uint8_t lerp8(uint8_t a, uint8_t b, uint8_t fraction) {
+  if (b > a)
+    return a + scale8(b - a, fraction);
+  return a - scale8(a - b, fraction);
+}
+
+// Blends `amount` of `b` into `a`.
+inline cRGB blend(cRGB a, cRGB b, uint8_t amount) {
+  cRGB color;
+  color.r = lerp8(a.r, b.r, amount);
+  color.g = lerp8(a.g, b.g, amount);
+  color.b = lerp8(a.b, b.b, amount);
+  return color;
+}
+
+// Scales the brightness of a color, in place.
+inline void nscale8(cRGB &color, uint8_t scale) {
+  color.r = scale8(color.r, scale);
+  color.g = scale8(color.g, scale);
+  color.b = scale8(color.b, scale);
+}
+
+// Gamma corrects a channel, with the table the LED drivers use.
+uint8_t gamma8(uint8_t i);
+
+// The brightness of a breathing LED, from 80 to 208, at `phase` (0 to 255) of
+// the breath.
+uint8_t breath8(uint8_t phase);
+
+// Converts a color from HSV to RGB. All three components range from 0 to 255.
+cRGB hsvToRgb(uint8_t hue, uint8_t saturation, uint8_t value);
+
+// The color at `position` (0 to 255) of a gradient through the `length` colors
+// of `palette`, which is in PROGMEM.
+cRGB paletteColor(const cRGB *palette, uint8_t length, uint8_t position);
+
+// Batched versions of the above, to convert a whole row of keys at once.
+void hsvToRgb(cRGB *colors, const uint8_t *hues, uint8_t count, uint8_t saturation, uint8_t value);
+void paletteColors(cRGB *colors, const uint8_t *positions, uint8_t count, const cRGB *palette, uint8_t length);
+void nscale8(cRGB *colors, uint8_t count, uint8_t scale);
+void gamma8(cRGB *colors, uint8_t count);
+
+}  // namespace color_math
+}  // namespace kaleidoscope
@@ -27,4 +27,6 @@
 #include "kaleidoscope/device/device.h"  // for cRGB
 
 cRGB breath_compute(uint8_t hue = 170, uint8_t saturation = 255, uint8_t phase_offset = 0);
+// All three components range from 0 to 255. See `kaleidoscope::color_math` in
+// ColorMath.h for the rest of the color math.
 cRGB hsvToRgb(uint16_t h, uint16_t s, uint16_t v);
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <stdint.h>  // for uint16_t, uint8_t
+
 #include "kaleidoscope/KeyAddr.h"                        // for KeyAddr
 #include "kaleidoscope/event_handler_result.h"           // for EventHandlerResult, EventHandlerResult...
 #include "kaleidoscope/plugin.h"                         // for Plugin
@@ -83,13 +85,60 @@ class LEDMode : public kaleidoscope::Plugin,
    */
   virtual void onActivate(void) {}
 
-  /** Update the LEDs once per cycle.
+  /** Update the LEDs once per frame.
    *
-   * Usually the brains of the plugin, which updates the LEDs each cycle. It is
-   * called after the matrix has been scanned, once per cycle.
+   * Usually the brains of the plugin, which updates the LEDs each frame. It is
+   * called by @ref LEDControl at the end of a cycle, once per @ref
+   * frameInterval, but never in the cycle that synced the LEDs, nor in one
+   * that handled a key event: such frames are deferred to the next cycle.
    */
   virtual void update(void) {}
 
+  /** The number of slices a frame is painted in.
+   *
+   * Modes whose frames are too costly to paint in a single cycle can split
+   * them into slices, usually one per row, by returning their number from
+   * here, and painting them in @ref updateSlice instead of @ref update. @ref
+   * LEDControl paints one slice per cycle, and holds the LEDs at the previous
+   * frame until the last slice is painted, so that a half-painted frame is
+   * never shown. The default is a single slice.
+   */
+  virtual uint8_t frameSlices(void) const {
+    return 1;
+  }
+
+  /** Paint one slice of a frame.
+   *
+   * Called with slices from zero to `frameSlices() - 1`, in order, one per
+   * cycle. The default calls @ref update.
+   *
+   * @param slice is the slice to paint.
+   */
+  virtual void updateSlice(uint8_t slice) {
+    update();
+  }
+
+  /** The time between two frames, in milliseconds.
+   *
+   * Modes that animate at a rate of their own return it from here, instead of
+   * checking timers in @ref update. The default, zero, has @ref update called
+   * once per LED sync interval.
+   */
+  virtual uint16_t frameInterval(void) const {
+    return 0;
+  }
+
+  /** The longest @ref updateSlice is expected to take, in microseconds.
+   *
+   * Slices that take longer are counted as overruns (see the `profile.leds`
+   * command of CycleTimeReport), and have the frame after them skipped, so
+   * that a mode can't take more of the CPU than it claims. The default, zero,
+   * disables the check.
+   */
+  virtual uint16_t frameBudget(void) const {
+    return 0;
+  }
+
   /** Refresh the color of a given key.
    *
    * If we have another plugin that overrides colors set by the active LED mode
@@ -0,0 +1,77 @@
+/* Kaleidoscope - Firmware for computer input devices
+ * Copyright (C) 2025 Keyboard.io, inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * Additional Permissions:
+ * As an additional permission under Section 7 of the GNU General Public
+ * License Version 3, you may link this software against a Vendor-provided
+ * Hardware Specific Software Module under the terms of the MCU Vendor
+ * Firmware Library Additional Permission Version 1.0.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "kaleidoscope/KeyAddr.h"          // for KeyAddr
+#include "kaleidoscope/KeyAddrBitfield.h"  // for KeyAddrBitfield
+#include "kaleidoscope/device/device.h"    // for cRGB
+
+namespace kaleidoscope {
+namespace plugin {
+
+/** Base class for LED overlays.
+*
+* An overlay covers some of the keys with colors of its own, drawn over the
+* frame the active LED mode painted, without changing it. Once the overlay
+* uncovers a key, the color the LED mode painted there shows through again,
+* without the mode having to repaint it.
+*
+* Overlays are added to @ref LEDControl with `LEDControl::addOverlay()`,
+* usually from `onSetup()`, and are drawn in the order they were added: the
+* last one on top.
+*/
+class LEDOverlay {
+  friend class LEDControl;
+
+ protected:
+  /** Returns the color of a covered key.
+   *
+   * Called by @ref LEDControl once per frame, for each key the overlay covers,
+   * unless an overlay on top of it already painted that key.
+   *
+   * @param key_addr is the matrix coordinate of the key.
+   * @param color is where to store the color of the key.
+   * @returns `false` to leave the key to the overlays and LED mode below.
+   */
+  virtual bool overlayColorAt(KeyAddr key_addr, cRGB &color) = 0;
+
+  void cover(KeyAddr key_addr) {
+    mask_.set(key_addr);
+  }
+  void uncover(KeyAddr key_addr) {
+    mask_.clear(key_addr);
+  }
+  void uncoverAll() {
+    mask_.clear();
+  }
+  bool covers(KeyAddr key_addr) const {
+    return mask_.read(key_addr);
+  }
+
+ private:
+  KeyAddrBitfield mask_;
+  LEDOverlay *next_ = nullptr;
+};
+
+}  // namespace plugin
+}  // namespace kaleidoscope
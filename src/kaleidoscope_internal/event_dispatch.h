@@ -41,6 +41,7 @@
 
 #pragma once
 
+#include "kaleidoscope/HookProfile.h"                                     // IWYU pragma: keep
 #include "kaleidoscope/event_handlers.h"                                  // for _FOR_EACH_EVENT...
 #include "kaleidoscope/macro_helpers.h"                                   // for __NL__, UNWRAP
 #include "kaleidoscope/plugin.h"  // IWYU pragma: keep
@@ -128,6 +129,16 @@
         return SHOULD_EXIT_IF_RESULT_NOT_OK;                              __NL__ \
       }                                                                   __NL__ \
                                                                           __NL__ \
+      /* These two are only used by the hook profiler.             */     __NL__ \
+      static const __FlashStringHelper *name() {                          __NL__ \
+        return F(#HOOK_NAME);                                             __NL__ \
+      }                                                                   __NL__ \
+      template<typename Plugin__>                                         __NL__ \
+      static constexpr bool isImplementedBy() {                           __NL__ \
+        return HookVersionImplemented_##HOOK_NAME<                        __NL__ \
+                 Plugin__, HOOK_VERSION>::value;                          __NL__ \
+      }                                                                   __NL__ \
+                                                                          __NL__ \
       template<typename Plugin__,                                         __NL__ \
                typename... Args__>                                        __NL__ \
       static kaleidoscope::EventHandlerResult                             __NL__ \
@@ -170,15 +181,51 @@
                                                                           __NL__ \
    }
 
+// This evaluates to `|| true` for each plugin that implements any version of
+// the `onAddToReport()` handler.
+#define _PLUGIN_IMPLEMENTS_ON_ADD_TO_REPORT(PLUGIN)                         \
+                                                                     __NL__ \
+   || (NumberOfImplementationsOf_onAddToReport<                      __NL__ \
+         typename kaleidoscope::sketch_exploration::BareType<        __NL__ \
+           decltype(PLUGIN)>::Type>::value != 0)
+
+#ifdef KALEIDOSCOPE_PROFILE_HOOKS
+// With the hook profiler enabled, each handler that a plugin implements is
+// timed, and the result recorded in a `HookStats` of its own (see
+// `kaleidoscope/HookProfile.h`).
+#define _CALL_EVENT_HANDLER_FOR_PLUGIN(PLUGIN)                              \
+                                                                     __NL__ \
+   kaleidoscope::profiling::ProfiledCall<                            __NL__ \
+     EventHandler__::template isImplementedBy<                       __NL__ \
+       typename kaleidoscope::sketch_exploration::BareType<          __NL__ \
+         decltype(PLUGIN)>::Type>()>                                 __NL__ \
+     ::template call<EventHandler__, __COUNTER__>(                   __NL__ \
+       F(#PLUGIN), PLUGIN, hook_args...)
+#else
+#define _CALL_EVENT_HANDLER_FOR_PLUGIN(PLUGIN)                              \
+                                                                     __NL__ \
+   EventHandler__::call(PLUGIN, hook_args...)
+#endif
+
 #define _INLINE_EVENT_HANDLER_FOR_PLUGIN(PLUGIN)                            \
                                                                      __NL__ \
-   result = EventHandler__::call(PLUGIN, hook_args...);              __NL__ \
+   result = _CALL_EVENT_HANDLER_FOR_PLUGIN(PLUGIN);                  __NL__ \
                                                                      __NL__ \
    if (EventHandler__::shouldExitIfResultNotOk() &&                  __NL__ \
        result != kaleidoscope::EventHandlerResult::OK) {             __NL__ \
       return result;                                                 __NL__ \
    }                                                                 __NL__
 
+// Plugins that don't list their Focus commands are offered all of them (see
+// `kaleidoscope::Plugin::focusCommand()`).
+#define _INLINE_FOCUS_COMMAND_FOR_PLUGIN(PLUGIN)                            \
+                                                                     __NL__ \
+   if (kaleidoscope::sketch_exploration::BareType<                   __NL__ \
+         decltype(PLUGIN)>::Type::focusCommand(command_hash,         __NL__ \
+                                               command)) {           __NL__ \
+      _INLINE_EVENT_HANDLER_FOR_PLUGIN(PLUGIN)                       __NL__ \
+   }                                                                 __NL__
+
 // _KALEIDOSCOPE_INIT_PLUGINS builds the loops that execute the plugins'
 // implementations of the various event handlers.
 //
@@ -202,6 +249,20 @@
       MAP(_INLINE_EVENT_HANDLER_FOR_PLUGIN, __VA_ARGS__)                      __NL__ \
                                                                               __NL__ \
       return result;                                                          __NL__ \
+    }                                                                         __NL__ \
+                                                                              __NL__ \
+    /* The same, for Focus commands, skipping the plugins whose command    */ __NL__ \
+    /* table doesn't have `command`. A null `command` lists the tables.    */ __NL__ \
+    template<typename EventHandler__, typename... Args__ >                    __NL__ \
+    static kaleidoscope::EventHandlerResult                                   __NL__ \
+      applyFocusCommand(uint16_t command_hash, const char *command,           __NL__ \
+                        Args__&&... hook_args) {                              __NL__ \
+                                                                              __NL__ \
+      kaleidoscope::EventHandlerResult result =                               __NL__ \
+        kaleidoscope::EventHandlerResult::OK;                                 __NL__ \
+      MAP(_INLINE_FOCUS_COMMAND_FOR_PLUGIN, __VA_ARGS__)                      __NL__ \
+                                                                              __NL__ \
+      return result;                                                          __NL__ \
     }                                                                         __NL__ \
   };                                                                          __NL__ \
                                                                               __NL__ \
@@ -220,6 +281,29 @@
                                                                               __NL__ \
   _FOR_EACH_EVENT_HANDLER(_REGISTER_EVENT_HANDLER)                            __NL__ \
                                                                               __NL__ \
+  /* Plugin instance names must be resolved in kaleidoscope_internal (see  */ __NL__ \
+  /* the top of this file), so the onAddToReport() check lives here, too.  */ __NL__ \
+  namespace kaleidoscope_internal {                                           __NL__ \
+  struct AddToReportHandlers {                                                __NL__ \
+    static constexpr bool implemented =                                       __NL__ \
+      false MAP(_PLUGIN_IMPLEMENTS_ON_ADD_TO_REPORT, __VA_ARGS__);            __NL__ \
+  };                                                                          __NL__ \
+  }                                                                           __NL__ \
+                                                                              __NL__ \
+  namespace kaleidoscope {                                                    __NL__ \
+  bool Hooks::onAddToReportIsImplemented() {                                  __NL__ \
+    return kaleidoscope_internal::AddToReportHandlers::implemented;           __NL__ \
+  }                                                                           __NL__ \
+                                                                              __NL__ \
+  EventHandlerResult Hooks::onFocusCommand(const char *input,                 __NL__ \
+                                           uint16_t hash,                     __NL__ \
+                                           bool help) {                       __NL__ \
+    return kaleidoscope_internal::EventDispatcher::template                   __NL__ \
+      applyFocusCommand<kaleidoscope_internal::EventHandler_onFocusEvent_v1>( __NL__ \
+        hash, help ? nullptr : input, input);                                 __NL__ \
+  }                                                                           __NL__ \
+  }                                                                           __NL__ \
+                                                                              __NL__ \
   /* This generates a PROGMEM array-kind-of data structure that contains   */ __NL__ \
   /* LEDModeFactory entries                                                */ __NL__ \
   _INIT_LED_MODE_MANAGER(__VA_ARGS__)                                         __NL__ \
@@ -0,0 +1,293 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kaleidoscope/driver/storage/JournaledFlash.h"
+#include "kaleidoscope/driver/storage/SimulatedFlash.h"
+#include "testing/setup-googletest.h"
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+using driver::storage::JournaledFlash;
+using driver::storage::JournaledFlashProps;
+using driver::storage::SimulatedFlash;
+
+struct TestProps : JournaledFlashProps {
+  static constexpr uint16_t length       = 1024;
+  static constexpr uint16_t commit_delay = 10;
+  typedef SimulatedFlash<512, 12> Flash;
+};
+
+class JournaledFlashTest : public ::testing::Test {
+ protected:
+  JournaledFlash<TestProps> storage_;
+
+  void SetUp() override {
+    flash().cutPowerAfter(-1);
+    storage_.erase();
+    storage_.setup();
+  }
+
+  TestProps::Flash &flash() {
+    return storage_.flash();
+  }
+
+  uint32_t totalErases() {
+    uint32_t total = 0;
+    for (uint8_t page = 0; page < TestProps::Flash::page_count; page++)
+      total += flash().eraseCount(page);
+    return total;
+  }
+
+  // Runs cycles until the pending flush, if any, is done.
+  void runUntilFlushed() {
+    while (storage_.isFlushPending())
+      storage_.betweenCycles();
+  }
+
+  // Simulates a reset: everything not in flash is lost.
+  void reboot() {
+    flash().cutPowerAfter(-1);
+    storage_.setup();
+  }
+};
+
+TEST_F(JournaledFlashTest, CommittedChangesSurviveAReboot) {
+  uint16_t value = 0x1234;
+  storage_.put(100, value);
+  storage_.update(1023, 0x42);
+  storage_.flush();
+  storage_.update(5, 0x99);
+
+  reboot();
+  uint16_t read_back = 0;
+  EXPECT_EQ(storage_.get(100, read_back), 0x1234);
+  EXPECT_EQ(storage_.read(1023), 0x42);
+  EXPECT_EQ(storage_.read(5), 0xff) << "Unflushed changes are lost";
+  EXPECT_TRUE(storage_.isSliceUninitialized(0, 100));
+  EXPECT_FALSE(storage_.isSliceUninitialized(100, 2));
+  EXPECT_EQ(flash().programErrors(), 0u);
+}
+
+TEST_F(JournaledFlashTest, SmallCommitsAreAppended) {
+  uint32_t programmed = flash().bytesProgrammed();
+  uint32_t erases     = totalErases();
+
+  storage_.update(10, 0x01);
+  storage_.update(11, 0x02);
+  storage_.flush();
+
+  // A single 8-byte chunk, in a 12-byte record
+  EXPECT_EQ(flash().bytesProgrammed() - programmed, 12u);
+  EXPECT_EQ(totalErases(), erases);
+
+  programmed = flash().bytesProgrammed();
+  storage_.update(10, 0x01);
+  storage_.flush();
+  EXPECT_EQ(flash().bytesProgrammed(), programmed) << "Unchanged bytes aren't written";
+}
+
+TEST_F(JournaledFlashTest, BlockWritesOnlyJournalChangedChunks) {
+  uint8_t data[64];
+  for (uint8_t i = 0; i < sizeof(data); i++)
+    data[i] = i;
+
+  storage_.writeBlock(100, data, sizeof(data));
+  storage_.flush();
+  EXPECT_EQ(storage_.compareBlock(100, data, sizeof(data)), 0);
+
+  // Rewriting the same data changes nothing
+  uint32_t programmed = flash().bytesProgrammed();
+  storage_.writeBlock(100, data, sizeof(data));
+  storage_.flush();
+  EXPECT_EQ(flash().bytesProgrammed(), programmed);
+
+  // Changing a single byte journals a single chunk
+  data[30] = 0xaa;
+  EXPECT_NE(storage_.compareBlock(100, data, sizeof(data)), 0);
+  storage_.writeBlock(100, data, sizeof(data));
+  storage_.flush();
+  EXPECT_EQ(flash().bytesProgrammed() - programmed, 12u);
+
+  storage_.fill(104, 0x11, 4);
+  storage_.flush();
+
+  reboot();
+  uint8_t read_back[64];
+  storage_.readBlock(100, read_back, sizeof(read_back));
+  EXPECT_EQ(read_back[0], 0);
+  EXPECT_EQ(read_back[4], 0x11);
+  EXPECT_EQ(read_back[7], 0x11);
+  EXPECT_EQ(read_back[8], 8);
+  EXPECT_EQ(read_back[30], 0xaa);
+  EXPECT_EQ(read_back[63], 63);
+}
+
+TEST_F(JournaledFlashTest, CompactsInTheBackground) {
+  uint32_t erases = totalErases();
+
+  for (uint16_t i = 0; i < 1000; i++) {
+    storage_.update(i, i & 0xff);
+    storage_.flush();
+    storage_.betweenCycles();
+  }
+  EXPECT_EQ(flash().programErrors(), 0u);
+
+  // Each flush is one 12-byte record, and compaction starts once a journal is
+  // half full, so it takes about 24 compactions of 5 page erases each: far
+  // fewer than the 3000 it would take to rewrite the storage on every flush.
+  EXPECT_LT(totalErases() - erases, 150u);
+
+  while (storage_.isCompacting())
+    storage_.betweenCycles();
+
+  reboot();
+  for (uint16_t i = 0; i < 1000; i++)
+    ASSERT_EQ(storage_.read(i), i & 0xff) << i;
+  EXPECT_TRUE(storage_.isSliceUninitialized(1000, 24));
+}
+
+TEST_F(JournaledFlashTest, SurvivesAnInterruptedCompaction) {
+  uint16_t i = 0;
+  while (!storage_.isCompacting()) {
+    storage_.update(i % 512, 0x55);
+    storage_.flush();
+    i++;
+  }
+
+  // Lose power halfway through the compaction
+  storage_.betweenCycles();
+  storage_.betweenCycles();
+  storage_.betweenCycles();
+  storage_.betweenCycles();
+  flash().cutPowerAfter(100);
+  storage_.betweenCycles();
+  storage_.betweenCycles();
+
+  reboot();
+  EXPECT_TRUE(storage_.isCompacting()) << "The compaction is resumed";
+  for (uint16_t j = 0; j < i; j++)
+    ASSERT_EQ(storage_.read(j % 512), 0x55) << j;
+
+  storage_.update(600, 0x66);
+  storage_.flush();
+  while (storage_.isCompacting())
+    storage_.betweenCycles();
+
+  reboot();
+  EXPECT_FALSE(storage_.isCompacting());
+  EXPECT_EQ(storage_.read(600), 0x66);
+  EXPECT_EQ(storage_.read(0), 0x55);
+  EXPECT_EQ(flash().programErrors(), 0u);
+}
+
+TEST_F(JournaledFlashTest, DropsATornFlush) {
+  storage_.update(0, 0x01);
+  storage_.flush();
+
+  flash().cutPowerAfter(6);
+  storage_.update(8, 0x02);
+  storage_.flush();
+
+  reboot();
+  EXPECT_EQ(storage_.read(0), 0x01);
+  EXPECT_EQ(storage_.read(8), 0xff);
+
+  // The torn record can't be appended to, so the next flush moves on
+  storage_.update(16, 0x03);
+  storage_.flush();
+  while (storage_.isCompacting())
+    storage_.betweenCycles();
+
+  reboot();
+  EXPECT_EQ(storage_.read(0), 0x01);
+  EXPECT_EQ(storage_.read(16), 0x03);
+  EXPECT_EQ(flash().programErrors(), 0u);
+}
+
+TEST_F(JournaledFlashTest, CoalescesCommits) {
+  uint32_t programmed = flash().bytesProgrammed();
+
+  // Each commit restarts the quiet period
+  for (uint8_t i = 0; i < 20; i++) {
+    storage_.update(i * 8, i);
+    storage_.commit();
+    storage_.betweenCycles();
+  }
+  EXPECT_EQ(flash().bytesProgrammed(), programmed);
+
+  // All 20 chunks are flushed as one record
+  runUntilFlushed();
+  EXPECT_EQ(flash().bytesProgrammed() - programmed, 164u);
+
+  reboot();
+  for (uint8_t i = 0; i < 20; i++)
+    EXPECT_EQ(storage_.read(i * 8), i);
+}
+
+TEST_F(JournaledFlashTest, SpreadsFlushesOverCycles) {
+  for (uint16_t i = 0; i < 1024; i++)
+    storage_.update(i, i & 0xff);
+  storage_.commit();
+
+  uint8_t cycles = 0;
+  while (storage_.isFlushPending()) {
+    uint32_t programmed = flash().bytesProgrammed();
+    storage_.betweenCycles();
+    // About a page per cycle: the budget, plus at most one more record
+    EXPECT_LE(flash().bytesProgrammed() - programmed, 512u + 252u);
+    cycles++;
+  }
+  EXPECT_GT(cycles, 2);
+
+  reboot();
+  for (uint16_t i = 0; i < 1024; i++)
+    ASSERT_EQ(storage_.read(i), i & 0xff) << i;
+  EXPECT_EQ(flash().programErrors(), 0u);
+}
+
+TEST_F(JournaledFlashTest, PowerLossKeepsCompleteFlushesAndWholeChunks) {
+  for (uint16_t cut = 0; cut < 1500; cut += 97) {
+    storage_.erase();
+    storage_.setup();
+
+    for (uint16_t i = 0; i < 1024; i++)
+      storage_.update(i, 0xa0 | (i / 8 % 8));
+    storage_.flush();
+
+    for (uint16_t i = 0; i < 1024; i++)
+      storage_.update(i, 0xb0 | (i / 8 % 8));
+    storage_.commit();
+    flash().cutPowerAfter(cut);
+    runUntilFlushed();
+
+    reboot();
+    for (uint16_t chunk = 0; chunk < 128; chunk++) {
+      uint8_t first = storage_.read(chunk * 8) & 0xf0;
+      ASSERT_TRUE(first == 0xa0 || first == 0xb0) << "cut=" << cut << " chunk=" << chunk;
+      for (uint8_t i = 0; i < 8; i++)
+        ASSERT_EQ(storage_.read(chunk * 8 + i), first | (chunk % 8)) << "cut=" << cut << " chunk=" << chunk;
+    }
+  }
+  EXPECT_EQ(flash().programErrors(), 0u);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
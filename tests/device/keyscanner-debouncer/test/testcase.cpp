@@ -0,0 +1,143 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kaleidoscope/driver/keyscanner/Debouncer.h"
+#include "testing/setup-googletest.h"
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+using driver::keyscanner::EagerPressDebouncer;
+using driver::keyscanner::SymmetricDebouncer;
+using driver::keyscanner::TimestampDebouncer;
+
+struct Props {
+  static constexpr uint8_t matrix_rows    = 2;
+  static constexpr uint8_t matrix_columns = 16;
+  typedef uint16_t RowState;
+};
+
+constexpr uint32_t scan_interval = 1000;
+
+TEST(SymmetricDebouncer, ChangesAfterTheFullDebounceTime) {
+  SymmetricDebouncer<Props> debouncer;
+  debouncer.setDebounceTime(4, scan_interval);
+
+  for (uint8_t i = 0; i < 3; ++i)
+    EXPECT_EQ(debouncer.debounce(0, 0x0101, i), 0) << "Scan " << int(i);
+  EXPECT_EQ(debouncer.debounce(0, 0x0101, 3), 0x0101);
+  EXPECT_EQ(debouncer.state(0), 0x0101);
+  EXPECT_EQ(debouncer.state(1), 0) << "Rows are debounced separately";
+
+  for (uint8_t i = 0; i < 3; ++i)
+    EXPECT_EQ(debouncer.debounce(0, 0x0001, i), 0);
+  EXPECT_EQ(debouncer.debounce(0, 0x0001, 3), 0x0100);
+  EXPECT_EQ(debouncer.state(0), 0x0001);
+}
+
+TEST(SymmetricDebouncer, BounceRestartsTheCount) {
+  SymmetricDebouncer<Props> debouncer;
+  debouncer.setDebounceTime(3, scan_interval);
+
+  EXPECT_EQ(debouncer.debounce(1, 0x8000, 0), 0);
+  EXPECT_EQ(debouncer.debounce(1, 0x8000, 1), 0);
+  EXPECT_EQ(debouncer.debounce(1, 0x0000, 2), 0);
+  EXPECT_EQ(debouncer.debounce(1, 0x8000, 3), 0);
+  EXPECT_EQ(debouncer.debounce(1, 0x8000, 4), 0);
+  EXPECT_EQ(debouncer.debounce(1, 0x8000, 5), 0x8000);
+}
+
+TEST(SymmetricDebouncer, ZeroDebounceTimeReportsEverySample) {
+  SymmetricDebouncer<Props> debouncer;
+  debouncer.setDebounceTime(0, scan_interval);
+
+  EXPECT_EQ(debouncer.debounce(0, 0x0002, 0), 0x0002);
+  EXPECT_EQ(debouncer.debounce(0, 0x0000, 1), 0x0002);
+}
+
+TEST(SymmetricDebouncer, ReportsTheDebounceTimeItCanCover) {
+  SymmetricDebouncer<Props> debouncer;
+  debouncer.setDebounceTime(5, scan_interval);
+  EXPECT_EQ(debouncer.debounceTime(), 5);
+
+  // The counters stop at seven scans
+  debouncer.setDebounceTime(20, scan_interval);
+  EXPECT_EQ(debouncer.debounceTime(), 7);
+  for (uint8_t i = 0; i < 6; ++i)
+    EXPECT_EQ(debouncer.debounce(0, 0x0004, i), 0) << "Scan " << int(i);
+  EXPECT_EQ(debouncer.debounce(0, 0x0004, 6), 0x0004);
+}
+
+TEST(EagerPressDebouncer, ReportsPressesRightAway) {
+  EagerPressDebouncer<Props> debouncer;
+  debouncer.setDebounceTime(3, scan_interval);
+
+  EXPECT_EQ(debouncer.debounce(0, 0x0010, 0), 0x0010);
+  EXPECT_EQ(debouncer.state(0), 0x0010);
+}
+
+TEST(EagerPressDebouncer, IgnoresBounceAfterAPress) {
+  EagerPressDebouncer<Props> debouncer;
+  debouncer.setDebounceTime(3, scan_interval);
+
+  EXPECT_EQ(debouncer.debounce(0, 0x0010, 0), 0x0010);
+  EXPECT_EQ(debouncer.debounce(0, 0x0000, 1), 0);
+  EXPECT_EQ(debouncer.debounce(0, 0x0010, 2), 0);
+  EXPECT_EQ(debouncer.debounce(0, 0x0000, 3), 0);
+  EXPECT_EQ(debouncer.debounce(0, 0x0000, 4), 0);
+  EXPECT_EQ(debouncer.debounce(0, 0x0000, 5), 0x0010);
+  EXPECT_EQ(debouncer.state(0), 0);
+}
+
+TEST(EagerPressDebouncer, NeverReleasesOnASingleSample) {
+  EagerPressDebouncer<Props> debouncer;
+  // Shorter than one scan
+  debouncer.setDebounceTime(1, 1500);
+
+  EXPECT_EQ(debouncer.debounce(0, 0x0001, 0), 0x0001);
+  EXPECT_EQ(debouncer.debounce(0, 0x0000, 1), 0);
+  EXPECT_EQ(debouncer.debounce(0, 0x0001, 3), 0);
+  EXPECT_EQ(debouncer.debounce(0, 0x0000, 4), 0);
+  EXPECT_EQ(debouncer.debounce(0, 0x0000, 6), 0x0001);
+}
+
+TEST(TimestampDebouncer, ReportsBothWaysAndLocksTheKey) {
+  TimestampDebouncer<Props> debouncer;
+  debouncer.setDebounceTime(5, scan_interval);
+
+  EXPECT_EQ(debouncer.debounce(0, 0x0004, 10), 0x0004);
+  EXPECT_EQ(debouncer.debounce(0, 0x0000, 11), 0) << "Locked after a press";
+  EXPECT_EQ(debouncer.debounce(0, 0x0006, 12), 0x0002) << "Other keys are not locked";
+  EXPECT_EQ(debouncer.debounce(0, 0x0006, 14), 0);
+  EXPECT_EQ(debouncer.debounce(0, 0x0002, 15), 0x0004);
+  EXPECT_EQ(debouncer.state(0), 0x0002);
+}
+
+TEST(TimestampDebouncer, HandlesTimestampWraparound) {
+  TimestampDebouncer<Props> debouncer;
+  debouncer.setDebounceTime(5, scan_interval);
+
+  EXPECT_EQ(debouncer.debounce(1, 0x0100, 253), 0x0100);
+  EXPECT_EQ(debouncer.debounce(1, 0x0000, 1), 0);
+  EXPECT_EQ(debouncer.debounce(1, 0x0000, 2), 0x0100);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
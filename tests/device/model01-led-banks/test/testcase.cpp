@@ -0,0 +1,83 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+
+#include <vector>
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+using driver::keyboardio::DirtyLEDBanks;
+using driver::keyboardio::sendChangedLEDBanks;
+
+// A half that records the banks it sends, in place of the I2C writes.
+class VirtualSide {
+ public:
+  DirtyLEDBanks<LED_BANKS> banks;
+  std::vector<uint8_t> sent;
+
+  VirtualSide() {
+    // Start out clean, as after a sync
+    while (banks.take() != DirtyLEDBanks<LED_BANKS>::no_bank) {}
+  }
+
+  bool sendLEDData() {
+    uint8_t bank = banks.take();
+    if (bank == DirtyLEDBanks<LED_BANKS>::no_bank)
+      return false;
+    sent.push_back(bank);
+    return true;
+  }
+};
+
+TEST(Model01LEDBanks, EveryChangedBankIsSentInOneSync) {
+  VirtualSide left, right;
+  left.banks.markAll();
+  right.banks.mark(2);
+
+  EXPECT_EQ(sendChangedLEDBanks(left, right), 5);
+  EXPECT_EQ(left.sent.size(), 4u) << "The half with more changed banks sends all of them";
+  EXPECT_EQ(right.sent.size(), 1u);
+  EXPECT_FALSE(left.banks.any());
+  EXPECT_FALSE(right.banks.any());
+
+  EXPECT_EQ(sendChangedLEDBanks(left, right), 0) << "Nothing is left for the next sync";
+}
+
+TEST(Model01LEDBanks, BanksAreSentRoundRobin) {
+  VirtualSide left, right;
+
+  // A bank that changes all the time doesn't keep the others from being sent
+  left.banks.mark(1);
+  sendChangedLEDBanks(left, right);
+  left.banks.mark(1);
+  left.banks.mark(0);
+  sendChangedLEDBanks(left, right);
+  left.banks.mark(3);
+  sendChangedLEDBanks(left, right);
+
+  std::vector<uint8_t> expected = {1, 0, 1, 3};
+  EXPECT_EQ(left.sent, expected);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
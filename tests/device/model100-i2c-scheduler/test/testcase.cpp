@@ -0,0 +1,184 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Kaleidoscope-Hardware-Keyboardio-Model100/src/kaleidoscope/driver/keyboardio/I2CScheduler.h"
+#include "testing/setup-googletest.h"
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+using driver::keyboardio::I2CScheduler;
+using driver::keyboardio::VirtualI2CTransport;
+
+constexpr uint8_t left_addr  = 0x58;
+constexpr uint8_t right_addr = 0x5B;
+
+class Model100I2CScheduler : public ::testing::Test {
+ protected:
+  I2CScheduler<VirtualI2CTransport> bus_;
+  uint8_t left_keys_[5]  = {1, 0x01, 0x02, 0x03, 0x04};
+  uint8_t right_keys_[5] = {1, 0x10, 0x20, 0x30, 0x40};
+  uint8_t bank_[25]      = {};
+  uint8_t data_[5]       = {};
+
+  void SetUp() override {
+    bus_.transport().setReadData(left_addr, left_keys_, 5);
+    bus_.transport().setReadData(right_addr, right_keys_, 5);
+  }
+};
+
+TEST_F(Model100I2CScheduler, BlockingReadCompletesInTheSameUpdate) {
+  bus_.requestRead(0, left_addr, 5);
+  EXPECT_FALSE(bus_.takeReadData(0, data_)) << "Nothing is read before the update";
+
+  bus_.update();
+  ASSERT_TRUE(bus_.takeReadData(0, data_));
+  EXPECT_EQ(data_[1], 0x01);
+  EXPECT_EQ(data_[4], 0x04);
+  EXPECT_FALSE(bus_.takeReadData(0, data_)) << "A snapshot can only be taken once";
+}
+
+TEST_F(Model100I2CScheduler, LatencyDelaysTheSnapshot) {
+  bus_.transport().setLatency(2);
+  bus_.requestRead(0, left_addr, 5);
+  bus_.requestRead(1, right_addr, 5);
+
+  bus_.update();
+  EXPECT_TRUE(bus_.transport().isBusy());
+  EXPECT_FALSE(bus_.takeReadData(0, data_));
+  bus_.update();
+  EXPECT_FALSE(bus_.takeReadData(0, data_));
+
+  // The left read completes, and the right one starts.
+  bus_.update();
+  ASSERT_TRUE(bus_.takeReadData(0, data_));
+  EXPECT_EQ(data_[1], 0x01);
+  EXPECT_FALSE(bus_.takeReadData(1, data_));
+
+  bus_.update();
+  bus_.update();
+  ASSERT_TRUE(bus_.takeReadData(1, data_));
+  EXPECT_EQ(data_[1], 0x10);
+  EXPECT_TRUE(bus_.isIdle());
+}
+
+TEST_F(Model100I2CScheduler, ReadsGoBeforeWrites) {
+  ASSERT_TRUE(bus_.queueWrite(0, left_addr, bank_, sizeof(bank_)));
+  bus_.requestRead(0, left_addr, 5);
+
+  bus_.transport().setLatency(1);
+  bus_.update();
+  bus_.update();
+  EXPECT_EQ(bus_.transport().readCount(left_addr), 1);
+  EXPECT_EQ(bus_.transport().writeCount(left_addr), 0);
+
+  bus_.update();
+  EXPECT_EQ(bus_.transport().writeCount(left_addr), 1);
+}
+
+TEST_F(Model100I2CScheduler, AlternatingWritesGoInOneUpdate) {
+  for (uint8_t i = 0; i < 4; ++i) {
+    ASSERT_TRUE(bus_.queueWrite(0, left_addr, bank_, sizeof(bank_)));
+    ASSERT_TRUE(bus_.queueWrite(1, right_addr, bank_, sizeof(bank_)));
+  }
+
+  bus_.update();
+  EXPECT_EQ(bus_.transport().writeCount(left_addr), 4);
+  EXPECT_EQ(bus_.transport().writeCount(right_addr), 4);
+  EXPECT_TRUE(bus_.isIdle());
+}
+
+TEST_F(Model100I2CScheduler, NoTwoWritesInARowToOneDevice) {
+  ASSERT_TRUE(bus_.queueWrite(0, left_addr, bank_, sizeof(bank_)));
+  ASSERT_TRUE(bus_.queueWrite(1, right_addr, bank_, sizeof(bank_)));
+  ASSERT_TRUE(bus_.queueWrite(0, left_addr, bank_, sizeof(bank_)));
+  ASSERT_TRUE(bus_.queueWrite(0, left_addr, bank_, sizeof(bank_)));
+
+  bus_.update();
+  EXPECT_EQ(bus_.transport().writeCount(left_addr), 2);
+  EXPECT_EQ(bus_.transport().writeCount(right_addr), 1);
+
+  bus_.update();
+  EXPECT_EQ(bus_.transport().writeCount(left_addr), 3);
+  EXPECT_TRUE(bus_.isIdle());
+}
+
+TEST_F(Model100I2CScheduler, WriteQueueFillsUp) {
+  for (uint8_t i = 0; i < 8; ++i)
+    ASSERT_TRUE(bus_.queueWrite(0, left_addr, bank_, sizeof(bank_)));
+  EXPECT_TRUE(bus_.isWriteQueueFull());
+  EXPECT_FALSE(bus_.queueWrite(1, right_addr, bank_, sizeof(bank_)));
+
+  bus_.update();
+  EXPECT_TRUE(bus_.queueWrite(1, right_addr, bank_, sizeof(bank_)));
+}
+
+TEST_F(Model100I2CScheduler, FailedReadKeepsTheLastSnapshot) {
+  bus_.requestRead(0, left_addr, 5);
+  bus_.update();
+  ASSERT_TRUE(bus_.takeReadData(0, data_));
+
+  bus_.transport().setConnected(left_addr, false);
+  bus_.requestRead(0, left_addr, 5);
+  bus_.update();
+  EXPECT_FALSE(bus_.takeReadData(0, data_));
+  EXPECT_TRUE(bus_.takeReadError(0));
+  EXPECT_FALSE(bus_.takeReadError(0)) << "An error is only reported once";
+  EXPECT_EQ(data_[1], 0x01);
+}
+
+TEST_F(Model100I2CScheduler, FailedWriteIsReportedToItsSlot) {
+  bus_.transport().setConnected(right_addr, false);
+  ASSERT_TRUE(bus_.queueWrite(0, left_addr, bank_, sizeof(bank_)));
+  ASSERT_TRUE(bus_.queueWrite(1, right_addr, bank_, sizeof(bank_)));
+  bus_.update();
+
+  EXPECT_FALSE(bus_.takeWriteError(0));
+  EXPECT_TRUE(bus_.takeWriteError(1));
+  EXPECT_FALSE(bus_.takeWriteError(1)) << "An error is only reported once";
+  EXPECT_FALSE(bus_.takeReadError(1)) << "Write errors aren't read errors";
+}
+
+TEST_F(Model100I2CScheduler, FailedWriteIsReportedAfterLatency) {
+  bus_.transport().setLatency(1);
+  bus_.transport().setConnected(left_addr, false);
+  ASSERT_TRUE(bus_.queueWrite(0, left_addr, bank_, sizeof(bank_)));
+
+  bus_.update();
+  EXPECT_FALSE(bus_.takeWriteError(0)) << "The write is still in flight";
+  bus_.update();
+  EXPECT_TRUE(bus_.takeWriteError(0));
+}
+
+TEST_F(Model100I2CScheduler, FlushRunsEverything) {
+  bus_.transport().setLatency(3);
+  bus_.requestRead(0, left_addr, 5);
+  ASSERT_TRUE(bus_.queueWrite(0, left_addr, bank_, sizeof(bank_)));
+  ASSERT_TRUE(bus_.queueWrite(0, left_addr, bank_, sizeof(bank_)));
+
+  bus_.flush();
+  EXPECT_TRUE(bus_.isIdle());
+  EXPECT_EQ(bus_.transport().readCount(left_addr), 1);
+  EXPECT_EQ(bus_.transport().writeCount(left_addr), 2);
+  EXPECT_TRUE(bus_.takeReadData(0, data_));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
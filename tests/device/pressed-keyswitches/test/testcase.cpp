@@ -0,0 +1,73 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+constexpr KeyAddr key_addr_A{2, 1};
+constexpr KeyAddr key_addr_B{0, 7};
+constexpr KeyAddr key_addr_C{3, 15};
+
+class PressedKeyswitches : public VirtualDeviceTest {
+ protected:
+  std::vector<KeyAddr> pressed() {
+    std::vector<KeyAddr> addrs;
+    Runtime.device().forEachPressedKeyswitch([&addrs](KeyAddr key_addr) {
+      addrs.push_back(key_addr);
+    });
+    return addrs;
+  }
+};
+
+TEST_F(PressedKeyswitches, NoneWhenIdle) {
+  RunCycle();
+  EXPECT_TRUE(pressed().empty());
+}
+
+TEST_F(PressedKeyswitches, VisitsEveryHeldKey) {
+  sim_.Press(key_addr_A);
+  sim_.Press(key_addr_B);
+  sim_.Press(key_addr_C);
+  RunCycle();
+
+  auto addrs = pressed();
+  ASSERT_EQ(addrs.size(), 3);
+  EXPECT_EQ(addrs.size(), Runtime.device().pressedKeyswitchCount());
+  for (KeyAddr addr : addrs)
+    EXPECT_TRUE(Runtime.device().isKeyswitchPressed(addr));
+
+  // Held keys stay in the set, and don't make any new reports.
+  auto state = RunCycle();
+  EXPECT_EQ(state->HIDReports()->Keyboard().size(), 0);
+  EXPECT_EQ(pressed().size(), 3);
+
+  sim_.Release(key_addr_B);
+  RunCycle();
+  addrs = pressed();
+  ASSERT_EQ(addrs.size(), 2);
+  EXPECT_EQ(addrs[0], key_addr_A);
+  EXPECT_EQ(addrs[1], key_addr_C);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
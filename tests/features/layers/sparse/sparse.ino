@@ -0,0 +1,87 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Store the keymap in the sparse encoding; layer 0 is mostly `Key_NoKey`, and
+// the others mostly `Key_Transparent`, so both kinds of fill key are used.
+#define KALEIDOSCOPE_SPARSE_KEYMAPS
+
+#include "Kaleidoscope.h"
+
+// *INDENT-OFF*
+
+KEYMAPS(
+  [0] = KEYMAP_STACKED
+  (
+    Key_0 ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX
+   ,ShiftToLayer(1)
+
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,Key_A
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+          ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX
+   ,ShiftToLayer(2)
+  ),
+
+  [1] =  KEYMAP_STACKED
+  (
+    ___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___
+   ,___
+
+   ,___   ,___   ,___   ,___   ,___   ,___   ,Key_1
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+          ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___
+   ,___
+  ),
+
+  [2] =  KEYMAP_STACKED
+  (
+    Key_2 ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___
+   ,___
+
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+          ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___
+   ,___
+  )
+) // KEYMAPS(
+
+// *INDENT-ON*
+
+void setup() {
+  Kaleidoscope.setup();
+}
+
+void loop() {
+  Kaleidoscope.loop();
+}
@@ -0,0 +1,160 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Kaleidoscope.h>
+#include <Kaleidoscope-Chord.h>
+
+#include "./common.h"
+
+// *INDENT-OFF*
+KEYMAPS(
+    [0] = KEYMAP_STACKED
+    (
+        Key_A,           Key_B, Key_C, Key_D, Key_E, Key_F, Key_G,
+        Key_H,           Key_I, Key_J, Key_K, Key_L, Key_M, Key_N,
+        Key_O,           ___,   ___,   ___,   ___,   ___,
+        Key_LeftControl, ___,   ___,   ___,   ___,   ___,   ___,
+        ___,             ___,   ___,   ___,
+        ___,
+
+        ___, ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___,
+        ___
+    ),
+)
+// *INDENT-ON*
+
+KALEIDOSCOPE_INIT_PLUGINS(Chord);
+
+void setup() {
+  Kaleidoscope.setup();
+  // Every pair of the keys A to O is a chord, each with a different result,
+  // for a table of 105 chords, spread over 14 bytes of chord bitmap.
+  CHORDS(
+    CHORD(Key_A, Key_B), Key_P,
+    CHORD(Key_A, Key_C), Key_Q,
+    CHORD(Key_A, Key_D), Key_R,
+    CHORD(Key_A, Key_E), Key_S,
+    CHORD(Key_A, Key_F), Key_T,
+    CHORD(Key_A, Key_G), Key_U,
+    CHORD(Key_A, Key_H), Key_V,
+    CHORD(Key_A, Key_I), Key_W,
+    CHORD(Key_A, Key_J), Key_X,
+    CHORD(Key_A, Key_K), Key_Y,
+    CHORD(Key_A, Key_L), Key_Z,
+    CHORD(Key_A, Key_M), Key_1,
+    CHORD(Key_A, Key_N), Key_2,
+    CHORD(Key_A, Key_O), Key_3,
+    CHORD(Key_B, Key_C), Key_4,
+    CHORD(Key_B, Key_D), Key_5,
+    CHORD(Key_B, Key_E), Key_6,
+    CHORD(Key_B, Key_F), Key_7,
+    CHORD(Key_B, Key_G), Key_8,
+    CHORD(Key_B, Key_H), Key_9,
+    CHORD(Key_B, Key_I), Key_0,
+    CHORD(Key_B, Key_J), Key_F1,
+    CHORD(Key_B, Key_K), Key_F2,
+    CHORD(Key_B, Key_L), Key_F3,
+    CHORD(Key_B, Key_M), Key_F4,
+    CHORD(Key_B, Key_N), Key_F5,
+    CHORD(Key_B, Key_O), Key_F6,
+    CHORD(Key_C, Key_D), Key_F7,
+    CHORD(Key_C, Key_E), Key_F8,
+    CHORD(Key_C, Key_F), Key_F9,
+    CHORD(Key_C, Key_G), Key_F10,
+    CHORD(Key_C, Key_H), Key_F11,
+    CHORD(Key_C, Key_I), Key_F12,
+    CHORD(Key_C, Key_J), Key_F13,
+    CHORD(Key_C, Key_K), Key_F14,
+    CHORD(Key_C, Key_L), Key_F15,
+    CHORD(Key_C, Key_M), Key_F16,
+    CHORD(Key_C, Key_N), Key_F17,
+    CHORD(Key_C, Key_O), Key_F18,
+    CHORD(Key_D, Key_E), Key_F19,
+    CHORD(Key_D, Key_F), Key_F20,
+    CHORD(Key_D, Key_G), Key_F21,
+    CHORD(Key_D, Key_H), Key_F22,
+    CHORD(Key_D, Key_I), Key_F23,
+    CHORD(Key_D, Key_J), Key_F24,
+    CHORD(Key_D, Key_K), Key_Enter,
+    CHORD(Key_D, Key_L), Key_Escape,
+    CHORD(Key_D, Key_M), Key_Backspace,
+    CHORD(Key_D, Key_N), Key_Tab,
+    CHORD(Key_D, Key_O), Key_Spacebar,
+    CHORD(Key_E, Key_F), Key_Minus,
+    CHORD(Key_E, Key_G), Key_Equals,
+    CHORD(Key_E, Key_H), Key_LeftBracket,
+    CHORD(Key_E, Key_I), Key_RightBracket,
+    CHORD(Key_E, Key_J), Key_Backslash,
+    CHORD(Key_E, Key_K), Key_Semicolon,
+    CHORD(Key_E, Key_L), Key_Quote,
+    CHORD(Key_E, Key_M), Key_Backtick,
+    CHORD(Key_E, Key_N), Key_Comma,
+    CHORD(Key_E, Key_O), Key_Period,
+    CHORD(Key_F, Key_G), Key_Slash,
+    CHORD(Key_F, Key_H), Key_PrintScreen,
+    CHORD(Key_F, Key_I), Key_ScrollLock,
+    CHORD(Key_F, Key_J), Key_Pause,
+    CHORD(Key_F, Key_K), Key_Insert,
+    CHORD(Key_F, Key_L), Key_Home,
+    CHORD(Key_F, Key_M), Key_PageUp,
+    CHORD(Key_F, Key_N), Key_Delete,
+    CHORD(Key_F, Key_O), Key_End,
+    CHORD(Key_G, Key_H), Key_PageDown,
+    CHORD(Key_G, Key_I), Key_RightArrow,
+    CHORD(Key_G, Key_J), Key_LeftArrow,
+    CHORD(Key_G, Key_K), Key_DownArrow,
+    CHORD(Key_G, Key_L), Key_UpArrow,
+    CHORD(Key_G, Key_M), Key_KeypadNumLock,
+    CHORD(Key_G, Key_N), Key_KeypadDivide,
+    CHORD(Key_G, Key_O), Key_KeypadMultiply,
+    CHORD(Key_H, Key_I), Key_KeypadSubtract,
+    CHORD(Key_H, Key_J), Key_KeypadAdd,
+    CHORD(Key_H, Key_K), Key_KeypadEnter,
+    CHORD(Key_H, Key_L), Key_Keypad1,
+    CHORD(Key_H, Key_M), Key_Keypad2,
+    CHORD(Key_H, Key_N), Key_Keypad3,
+    CHORD(Key_H, Key_O), Key_Keypad4,
+    CHORD(Key_I, Key_J), Key_Keypad5,
+    CHORD(Key_I, Key_K), Key_Keypad6,
+    CHORD(Key_I, Key_L), Key_Keypad7,
+    CHORD(Key_I, Key_M), Key_Keypad8,
+    CHORD(Key_I, Key_N), Key_Keypad9,
+    CHORD(Key_I, Key_O), Key_Keypad0,
+    CHORD(Key_J, Key_K), Key_KeypadDot,
+    CHORD(Key_J, Key_L), Key_Execute,
+    CHORD(Key_J, Key_M), Key_Help,
+    CHORD(Key_J, Key_N), Key_Menu,
+    CHORD(Key_J, Key_O), Key_Select,
+    CHORD(Key_K, Key_L), Key_Stop,
+    CHORD(Key_K, Key_M), Key_Again,
+    CHORD(Key_K, Key_N), Key_Undo,
+    CHORD(Key_K, Key_O), Key_Cut,
+    CHORD(Key_L, Key_M), Key_Copy,
+    CHORD(Key_L, Key_N), Key_Paste,
+    CHORD(Key_L, Key_O), Key_Find,
+    CHORD(Key_M, Key_N), Key_KeypadEquals,
+    CHORD(Key_M, Key_O), Key_NonUsBackslashAndPipe,
+    CHORD(Key_N, Key_O), Key_PcApplication,
+  )
+}
+
+void loop() {
+  Kaleidoscope.loop();
+}
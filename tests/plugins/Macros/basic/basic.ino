@@ -22,7 +22,7 @@ KEYMAPS(
   [0] = KEYMAP_STACKED
   (
       M(0), M(1), M(255), M(2), M(3), ___, ___,
-      Key_X, ___, ___, ___, ___, ___, ___,
+      Key_X, Key_LeftShift, ___, ___, ___, ___, ___,
       ___, ___, ___, ___, ___, ___,
       ___, ___, ___, ___, ___, ___, ___,
 
@@ -0,0 +1,86 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <Kaleidoscope.h>
+#include <Kaleidoscope-MagicCombo.h>
+
+// *INDENT-OFF*
+KEYMAPS(
+    [0] = KEYMAP_STACKED
+    (
+        ___, ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___,
+        ___,
+
+        ___, ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___, ___, ___, ___,
+        ___, ___, ___, ___,
+        ___
+    ),
+)
+// *INDENT-ON*
+
+namespace kaleidoscope {
+namespace plugin {
+
+// Aborts every keyswitch event of R0C3, before MagicCombo sees it.
+class AbortR0C3 : public Plugin {
+ public:
+  EventHandlerResult onKeyswitchEvent(KeyEvent &event) {
+    if (event.addr == KeyAddr(0, 3))
+      return EventHandlerResult::ABORT;
+    return EventHandlerResult::OK;
+  }
+};
+
+}  // namespace plugin
+}  // namespace kaleidoscope
+
+kaleidoscope::plugin::AbortR0C3 AbortR0C3;
+
+void tapKey(Key key) {
+  KeyAddr k{1, 0};
+  Kaleidoscope.handleKeyEvent(KeyEvent{k, IS_PRESSED | INJECTED, key});
+  Kaleidoscope.handleKeyEvent(KeyEvent{k, WAS_PRESSED | INJECTED});
+}
+
+void tapKeyA(uint8_t magic_combo_index) {
+  tapKey(Key_A);
+}
+
+void tapKeyB(uint8_t magic_combo_index) {
+  tapKey(Key_B);
+}
+
+USE_MAGIC_COMBOS({.action = tapKeyA, .keys = {R0C0, R0C1, R0C2}},
+                 {.action = tapKeyB, .keys = {R0C0, R0C3}});
+
+KALEIDOSCOPE_INIT_PLUGINS(AbortR0C3, MagicCombo);
+
+void setup() {
+  Kaleidoscope.setup();
+  MagicCombo.setMinInterval(20);
+}
+
+void loop() {
+  Kaleidoscope.loop();
+}
@@ -0,0 +1,101 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kaleidoscope/plugin/LEDControl/ColorMath.h"
+#include "testing/setup-googletest.h"
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+// The floating point HSV to RGB conversion the integer one approximates.
+cRGB referenceHsv(uint8_t h, uint8_t s, uint8_t v) {
+  float hue   = h * 6.0f / 256;
+  int region  = static_cast<int>(hue);
+  float fpart = hue - region;
+  float sat   = s / 255.0f;
+  float val   = v;
+  float p     = val * (1 - sat);
+  float q     = val * (1 - sat * fpart);
+  float t     = val * (1 - sat * (1 - fpart));
+
+  float rgb[6][3] = {{val, t, p}, {q, val, p}, {p, val, t}, {p, q, val}, {t, p, val}, {val, p, q}};
+  return CRGB(uint8_t(rgb[region][0]), uint8_t(rgb[region][1]), uint8_t(rgb[region][2]));
+}
+
+TEST(ColorMath, Scale8KeepsTheFullRange) {
+  EXPECT_EQ(color_math::scale8(255, 255), 255);
+  EXPECT_EQ(color_math::scale8(255, 0), 0);
+  EXPECT_EQ(color_math::scale8(200, 128), 100);
+  EXPECT_EQ(color_math::lerp8(10, 200, 0), 10);
+  EXPECT_EQ(color_math::lerp8(200, 10, 255), 10);
+}
+
+TEST(ColorMath, HsvIsCloseToFloatingPoint) {
+  for (uint16_t h = 0; h < 256; h += 5) {
+    for (uint16_t s = 0; s < 256; s += 15) {
+      for (uint16_t v = 0; v < 256; v += 15) {
+        cRGB actual   = color_math::hsvToRgb(h, s, v);
+        cRGB expected = referenceHsv(h, s, v);
+        // Each of the 8-bit multiplications can be off by one
+        ASSERT_NEAR(actual.r, expected.r, 3) << h << " " << s << " " << v;
+        ASSERT_NEAR(actual.g, expected.g, 3) << h << " " << s << " " << v;
+        ASSERT_NEAR(actual.b, expected.b, 3) << h << " " << s << " " << v;
+      }
+    }
+  }
+}
+
+TEST(ColorMath, BreathRisesAndFalls) {
+  EXPECT_EQ(color_math::breath8(0), 80);
+  EXPECT_EQ(color_math::breath8(127), 208);
+  for (uint8_t phase = 1; phase < 128; phase++) {
+    EXPECT_GE(color_math::breath8(phase), color_math::breath8(phase - 1));
+    EXPECT_EQ(color_math::breath8(phase), color_math::breath8(255 - phase));
+  }
+}
+
+TEST(ColorMath, PalettesSpanAllTheColors) {
+  static const cRGB palette[] = {CRGB(0, 0, 0), CRGB(0, 250, 0), CRGB(250, 0, 0)};
+
+  cRGB color = color_math::paletteColor(palette, 3, 0);
+  EXPECT_EQ(color.r, 0);
+  EXPECT_EQ(color.g, 0);
+
+  color = color_math::paletteColor(palette, 3, 64);
+  EXPECT_EQ(color.r, 0);
+  EXPECT_NEAR(color.g, 125, 1);
+
+  color = color_math::paletteColor(palette, 3, 128);
+  EXPECT_EQ(color.g, 250);
+
+  color = color_math::paletteColor(palette, 3, 255);
+  EXPECT_EQ(color.r, 250);
+  EXPECT_EQ(color.g, 0);
+
+  // A whole row at once
+  uint8_t positions[] = {0, 128, 255};
+  cRGB colors[3];
+  color_math::paletteColors(colors, positions, 3, palette, 3);
+  EXPECT_EQ(colors[1].g, 250);
+  EXPECT_EQ(colors[2].r, 250);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
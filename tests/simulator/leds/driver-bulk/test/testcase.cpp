@@ -0,0 +1,70 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-LEDControl.h"
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+// A few sync intervals, so that the LEDs are up to date.
+constexpr uint32_t frame_time = 100;
+
+class LEDDriverBulk : public VirtualDeviceTest {
+ protected:
+  void expectColor(cRGB actual, cRGB expected) {
+    EXPECT_EQ(actual.r, expected.r);
+    EXPECT_EQ(actual.g, expected.g);
+    EXPECT_EQ(actual.b, expected.b);
+  }
+};
+
+TEST_F(LEDDriverBulk, TracksTheDirtyRange) {
+  auto &driver = Runtime.device().ledDriver();
+  uint8_t first, last;
+
+  sim_.RunForMillis(frame_time);
+  EXPECT_FALSE(driver.dirtyRange(first, last)) << "Syncing cleans every LED";
+  EXPECT_TRUE(driver.areAnyLEDsOn());
+
+  cRGB colors[] = {CRGB(0, 0, 160), CRGB(1, 2, 3), CRGB(0, 0, 0), CRGB(0, 0, 160)};
+  driver.blit(colors, 10, 4);
+  ASSERT_TRUE(driver.dirtyRange(first, last));
+  EXPECT_EQ(first, 11) << "LEDs that keep their color stay clean";
+  EXPECT_EQ(last, 12);
+  expectColor(driver.getCrgbAt(11), CRGB(1, 2, 3));
+  expectColor(driver.getCrgbAt(12), CRGB(0, 0, 0));
+
+  // The next frame puts the LED mode's colors back
+  sim_.RunForMillis(frame_time);
+  EXPECT_FALSE(driver.dirtyRange(first, last));
+  expectColor(driver.getCrgbAt(11), CRGB(0, 0, 160));
+  expectColor(driver.getCrgbAt(12), CRGB(0, 0, 160));
+
+  driver.fill(CRGB(0, 0, 0));
+  ASSERT_TRUE(driver.dirtyRange(first, last));
+  EXPECT_EQ(first, 0);
+  EXPECT_EQ(last, Runtime.device().led_count - 1);
+  EXPECT_FALSE(driver.areAnyLEDsOn());
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
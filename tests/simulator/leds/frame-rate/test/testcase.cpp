@@ -0,0 +1,65 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-LEDControl.h"
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+using plugin::LEDControl;
+
+constexpr KeyAddr key_addr_A{2, 1};
+
+class LEDFrameRate : public VirtualDeviceTest {};
+
+TEST_F(LEDFrameRate, ModesAreUpdatedAtTheirOwnRate) {
+  sim_.RunForMillis(2100);
+
+  // The chase effect asks for a frame every 100ms
+  EXPECT_GE(LEDControl::framesPerSecond(), 9);
+  EXPECT_LE(LEDControl::framesPerSecond(), 10);
+  EXPECT_EQ(LEDControl::frameOverruns(), 0);
+}
+
+TEST_F(LEDFrameRate, FramesAreDeferredWhileTyping) {
+  LEDControl::resetFrameStats();
+
+  // A key event in every cycle, for a few frames' worth of time
+  for (uint16_t i = 0; i < 150; i++) {
+    sim_.Press(key_addr_A);
+    sim_.RunCycle();
+    sim_.Release(key_addr_A);
+    sim_.RunCycle();
+  }
+  EXPECT_GT(LEDControl::deferredFrames(), 0);
+
+  // Once typing stops, frames are painted on time again
+  uint16_t deferred = LEDControl::deferredFrames();
+  sim_.RunForMillis(200);
+  EXPECT_EQ(LEDControl::deferredFrames(), deferred);
+
+  LEDControl::resetFrameStats();
+  EXPECT_EQ(LEDControl::deferredFrames(), 0);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
@@ -0,0 +1,95 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-HardwareTestMode.h"
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+constexpr KeyAddr key_addr_tested{2, 1};
+constexpr KeyAddr key_addr_chattering{2, 2};
+constexpr KeyAddr key_addr_untested{2, 3};
+
+constexpr cRGB red    = CRGB(201, 0, 0);
+constexpr cRGB blue   = CRGB(0, 0, 201);
+constexpr cRGB green  = CRGB(0, 201, 0);
+constexpr cRGB yellow = CRGB(201, 100, 0);
+
+// Enough passes for a key to not count as chattering when it's pressed again.
+constexpr uint8_t settle_passes = 32;
+
+class HardwareTestModeMatrix : public VirtualDeviceTest {
+ protected:
+  plugin::HardwareTestMode::chatter_data state_[Runtime.device().numKeys()] = {};
+
+  // One pass of the matrix test, followed by a scan of the matrix, so that the
+  // next pass sees which keys were pressed before.
+  void Pass(uint8_t count = 1) {
+    for (uint8_t i = 0; i < count; i++) {
+      ::HardwareTestMode.updateMatrixTest(state_);
+      sim_.RunCycle();
+    }
+  }
+
+  // The color the LED driver was last given for a key.
+  cRGB shownAt(KeyAddr key_addr) {
+    return Runtime.device().ledDriver().getCrgbAt(Runtime.device().getLedIndex(key_addr));
+  }
+
+  void expectColor(cRGB actual, cRGB expected) {
+    EXPECT_EQ(actual.r, expected.r);
+    EXPECT_EQ(actual.g, expected.g);
+    EXPECT_EQ(actual.b, expected.b);
+  }
+};
+
+TEST_F(HardwareTestModeMatrix, ShowsTheStateOfEachKey) {
+  Pass(settle_passes);
+  expectColor(shownAt(key_addr_tested), yellow);
+
+  sim_.Press(key_addr_tested);
+  Pass(2);
+  expectColor(shownAt(key_addr_tested), green);
+
+  sim_.Release(key_addr_tested);
+  Pass();
+  expectColor(shownAt(key_addr_tested), blue);
+  expectColor(shownAt(key_addr_untested), yellow);
+}
+
+TEST_F(HardwareTestModeMatrix, ShowsChatteringKeys) {
+  Pass(settle_passes);
+
+  sim_.Press(key_addr_chattering);
+  Pass();
+  sim_.Release(key_addr_chattering);
+  Pass();
+  sim_.Press(key_addr_chattering);
+  Pass();
+  sim_.Release(key_addr_chattering);
+  Pass();
+  expectColor(shownAt(key_addr_chattering), red);
+  expectColor(shownAt(key_addr_untested), yellow);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
@@ -0,0 +1,80 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-LEDControl.h"
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+constexpr KeyAddr key_addr_A{2, 1};
+constexpr KeyAddr key_addr_LeftShift{3, 7};
+constexpr KeyAddr key_addr_OneShotAlt{2, 8};
+
+// A few sync intervals, so that the LEDs are up to date.
+constexpr uint32_t frame_time = 100;
+
+class LEDOverlays : public VirtualDeviceTest {
+ protected:
+  // The color the LED driver was last given for a key.
+  cRGB shownAt(KeyAddr key_addr) {
+    return Runtime.device().ledDriver().getCrgbAt(Runtime.device().getLedIndex(key_addr));
+  }
+
+  void expectColor(cRGB actual, cRGB expected) {
+    EXPECT_EQ(actual.r, expected.r);
+    EXPECT_EQ(actual.g, expected.g);
+    EXPECT_EQ(actual.b, expected.b);
+  }
+};
+
+TEST_F(LEDOverlays, ReleasedKeysShowTheLEDModeAgain) {
+  sim_.RunForMillis(frame_time);
+  expectColor(shownAt(key_addr_LeftShift), CRGB(0, 0, 160));
+
+  sim_.Press(key_addr_LeftShift);
+  sim_.RunForMillis(frame_time);
+  expectColor(shownAt(key_addr_LeftShift), CRGB(160, 160, 160));
+  expectColor(shownAt(key_addr_A), CRGB(0, 0, 160));
+  // The frame of the LED mode is left alone
+  expectColor(::LEDControl.getCrgbAt(key_addr_LeftShift), CRGB(0, 0, 160));
+
+  sim_.Release(key_addr_LeftShift);
+  sim_.RunForMillis(frame_time);
+  expectColor(shownAt(key_addr_LeftShift), CRGB(0, 0, 160));
+}
+
+TEST_F(LEDOverlays, OneShotKeysAreUncoveredOnceUsed) {
+  sim_.Press(key_addr_OneShotAlt);
+  sim_.RunCycle();
+  sim_.Release(key_addr_OneShotAlt);
+  sim_.RunForMillis(frame_time);
+  expectColor(shownAt(key_addr_OneShotAlt), CRGB(160, 160, 0));
+
+  sim_.Press(key_addr_A);
+  sim_.RunCycle();
+  sim_.Release(key_addr_A);
+  sim_.RunForMillis(frame_time);
+  expectColor(shownAt(key_addr_OneShotAlt), CRGB(0, 0, 160));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
@@ -0,0 +1,67 @@
+// -*- mode: c++ -*-
+// Copyright 2016 Keyboardio, inc. <jesse@keyboard.io>
+// See "LICENSE" for license details
+
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-EEPROM-Settings.h"
+#include "Kaleidoscope-FocusSerial.h"
+#include "Kaleidoscope-LEDControl.h"
+#include "Kaleidoscope-LED-Palette-Theme.h"
+#include "Kaleidoscope-Colormap.h"
+
+// *INDENT-OFF*
+
+KEYMAPS(
+  [0] = KEYMAP_STACKED
+  (
+    XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX
+
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+          ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX
+  ),
+
+  [1] = KEYMAP_STACKED
+  (
+    ___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___
+   ,___
+
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+          ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___   ,___   ,___   ,___
+   ,___   ,___   ,___   ,___
+   ,___
+  )
+) // KEYMAPS(
+
+// *INDENT-ON*
+
+KALEIDOSCOPE_INIT_PLUGINS(EEPROMSettings,
+                          LEDControl,
+                          LEDPaletteTheme,
+                          ColormapEffect,
+                          Focus);
+
+void setup() {
+  Kaleidoscope.setup();
+
+  ColormapEffect.max_layers(2);
+  ColormapEffect.activate();
+}
+
+void loop() {
+  Kaleidoscope.loop();
+}
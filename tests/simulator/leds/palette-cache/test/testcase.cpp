@@ -0,0 +1,67 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-LEDControl.h"
+#include "Kaleidoscope-Colormap.h"
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+class PaletteCache : public VirtualDeviceTest {
+ protected:
+  void expectColorAt(uint8_t led_index, cRGB expected) {
+    cRGB actual = ::LEDControl.getCrgbAt(led_index);
+    EXPECT_EQ(actual.r, expected.r) << "LED " << int(led_index);
+    EXPECT_EQ(actual.g, expected.g) << "LED " << int(led_index);
+    EXPECT_EQ(actual.b, expected.b) << "LED " << int(led_index);
+  }
+};
+
+TEST_F(PaletteCache, WritesThrough) {
+  // Run a cycle, so EEPROMSettings seals the storage layout
+  RunCycle();
+
+  sim_.SendFocusCommand("palette 10 20 30 40 50 60");
+  sim_.SendFocusCommand("colormap.map 0 1");
+  expectColorAt(0, CRGB(10, 20, 30));
+  expectColorAt(1, CRGB(40, 50, 60));
+
+  // Once the palette is cached, updates must be written through to it
+  sim_.SendFocusCommand("palette 70 80 90");
+  expectColorAt(0, CRGB(70, 80, 90));
+  expectColorAt(1, CRGB(40, 50, 60));
+
+  // The same goes for cached themes
+  ::ColormapEffect.updateColorIndexAtPosition(0, 0, 1);
+  ::LEDControl.refreshAll();
+  expectColorAt(0, CRGB(40, 50, 60));
+
+  // Including the ones not shown at the moment
+  ::ColormapEffect.updateColorIndexAtPosition(1, 1, 0);
+  Layer.activate(1);
+  expectColorAt(1, CRGB(70, 80, 90));
+  Layer.deactivate(1);
+  expectColorAt(1, CRGB(40, 50, 60));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
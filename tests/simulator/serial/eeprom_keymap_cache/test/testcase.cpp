@@ -0,0 +1,65 @@
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-EEPROM-Keymap.h"
+#include "gmock/gmock.h"  // For matchers like Eq()
+
+#include <string>
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+class EEPROMKeymapCache : public VirtualDeviceTest {};
+
+TEST_F(EEPROMKeymapCache, WritesThroughAndFlushes) {
+  // Run a cycle, so EEPROMSettings seals the storage layout
+  RunCycle();
+
+  KeyAddr key_addr{0, 0};
+
+  // Write Key_A to the first key of the first custom layer
+  sim_.SendFocusCommand("keymap.custom 4");
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, key_addr), Key_A);
+
+  // Once that layer is cached, updates must be written through to it
+  sim_.SendFocusCommand("keymap.custom 5");
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, key_addr), Key_B);
+
+  // Writing storage directly bypasses the cache...
+  Runtime.storage().update(::EEPROMKeymap.keymap_base() + 1, Key_C.getKeyCode());
+  Runtime.storage().commit();
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, key_addr), Key_B);
+
+  // ...until it is flushed
+  ::EEPROMKeymap.flushCache();
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, key_addr), Key_C);
+
+  // The second custom layer is unaffected by all of the above
+  EXPECT_NE(::EEPROMKeymap.getKey(1, key_addr), Key_C);
+}
+
+TEST_F(EEPROMKeymapCache, FlushesOnStorageUploads) {
+  RunCycle();
+
+  KeyAddr key_addr{0, 0};
+  uint16_t pos = ::EEPROMKeymap.keymap_base() + 1;
+
+  sim_.SendFocusCommand("keymap.custom 4");
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, key_addr), Key_A);
+
+  // Upload the storage as it is, up to the first key, changed to Key_D
+  std::string command = "eeprom.contents";
+  for (uint16_t i = 0; i < pos; i++)
+    command += " " + std::to_string(Runtime.storage().read(i));
+  command += " " + std::to_string(Key_D.getKeyCode());
+  sim_.SendFocusCommand(command);
+
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, key_addr), Key_D)
+    << "The cached layer is dropped once the upload is over";
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
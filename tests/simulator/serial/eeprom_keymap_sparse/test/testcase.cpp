@@ -0,0 +1,84 @@
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-EEPROM-Keymap.h"
+#include "gmock/gmock.h"  // For matchers like Eq()
+
+#include <string>
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+class EEPROMKeymapSparse : public VirtualDeviceTest {
+ protected:
+  Key getKey(uint8_t layer, uint8_t index) {
+    return ::EEPROMKeymap.getKey(layer, KeyAddr(index));
+  }
+};
+
+TEST_F(EEPROMKeymapSparse, StoresAndUpdatesSparseLayers) {
+  RunCycle();
+
+  // Every layer starts out empty
+  EXPECT_EQ(getKey(0, 0), Key_Transparent);
+  EXPECT_EQ(getKey(2, 63), Key_Transparent);
+
+  // Layer 0: transparent, except for Key_A and Key_B at both ends
+  // Layer 1: blank, except for Key_C at index 10
+  sim_.SendFocusCommand("keymap.sparse 65535 2 0 4 63 5 0 1 10 6");
+  EXPECT_EQ(getKey(0, 0), Key_A);
+  EXPECT_EQ(getKey(0, 5), Key_Transparent);
+  EXPECT_EQ(getKey(0, 63), Key_B);
+  EXPECT_EQ(getKey(1, 10), Key_C);
+  EXPECT_EQ(getKey(1, 11), Key_NoKey);
+  EXPECT_EQ(getKey(2, 0), Key_Transparent);
+
+  // Adding a key to a layer moves the ones after it
+  ::EEPROMKeymap.updateKey(64 + 11, Key_D);
+  EXPECT_EQ(getKey(1, 10), Key_C);
+  EXPECT_EQ(getKey(1, 11), Key_D);
+  EXPECT_EQ(getKey(0, 63), Key_B);
+  EXPECT_EQ(getKey(2, 0), Key_Transparent);
+
+  // Keys stored on their own are changed in place, as are fill keys that stay
+  ::EEPROMKeymap.updateKey(63, Key_C);
+  ::EEPROMKeymap.updateKey(64 + 12, Key_NoKey);
+  EXPECT_EQ(getKey(0, 63), Key_C);
+  EXPECT_EQ(getKey(1, 10), Key_C);
+  EXPECT_EQ(getKey(1, 11), Key_D);
+  EXPECT_EQ(getKey(1, 12), Key_NoKey);
+  EXPECT_EQ(getKey(2, 0), Key_Transparent);
+
+  // keymap.custom keeps the rest of a layer it only partially writes
+  sim_.SendFocusCommand("keymap.custom 8");
+  EXPECT_EQ(getKey(0, 0), Key_E);
+  EXPECT_EQ(getKey(0, 63), Key_C);
+  EXPECT_EQ(getKey(1, 10), Key_C);
+}
+
+TEST_F(EEPROMKeymapSparse, KeepsLayersThatDoNotFit) {
+  RunCycle();
+
+  sim_.SendFocusCommand("keymap.sparse 65535 0 0 1 10 6");
+
+  // Two full layers don't fit in 200 bytes: the first one is written, and the
+  // second one keeps its previous contents.
+  std::string command = "keymap.custom";
+  for (uint8_t i = 0; i < 128; i++)
+    command += " 4";
+  std::string response = sim_.SendFocusCommand(command);
+  EXPECT_THAT(response, ::testing::HasSubstr("error: no room for 1 layers"))
+    << "The host is told that a layer didn't fit";
+
+  EXPECT_EQ(getKey(0, 0), Key_A);
+  EXPECT_EQ(getKey(0, 63), Key_A);
+  EXPECT_EQ(getKey(1, 10), Key_C);
+  EXPECT_EQ(getKey(1, 11), Key_NoKey);
+  EXPECT_EQ(getKey(2, 0), Key_Transparent);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
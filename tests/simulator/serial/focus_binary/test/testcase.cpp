@@ -0,0 +1,180 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>  // for fill, min
+#include <string>     // for string, to_string
+#include <vector>     // for vector
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-EEPROM-Keymap.h"
+#include "Kaleidoscope-FocusSerial.h"
+#include "kaleidoscope/util/crc16.h"
+#include "gmock/gmock.h"  // For matchers like Eq()
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+class FocusBinary : public VirtualDeviceTest {
+ protected:
+  // Frames `data` for a binary transfer, `frame_size` bytes at a time.
+  static std::string BinaryTransfer(const std::vector<uint8_t> &data,
+                                    uint8_t frame_size = ::Focus.binary_frame_size) {
+    std::string transfer(1, ::Focus.BINARY);
+    size_t pos = 0;
+    uint8_t size;
+
+    do {
+      size = std::min<size_t>(frame_size, data.size() - pos);
+      uint16_t crc = _crc16_update(0xffff, size);
+      transfer += static_cast<char>(size);
+      for (uint8_t i = 0; i < size; i++) {
+        crc = _crc16_update(crc, data[pos + i]);
+        transfer += static_cast<char>(data[pos + i]);
+      }
+      transfer += static_cast<char>(crc & 0xff);
+      transfer += static_cast<char>(crc >> 8);
+      pos += size;
+    } while (size > 0);
+
+    return transfer;
+  }
+
+  static std::string TextTransfer(const std::vector<uint8_t> &data) {
+    std::string transfer;
+    for (uint8_t b : data)
+      transfer += std::to_string(b) + " ";
+    return transfer;
+  }
+
+  // Like `SendFocusCommand()`, but returns how many cycles it took to
+  // respond, and leaves the response in `response_`.
+  size_t CyclesToRespond(const std::string &command) {
+    sim_.SendString(command + "\n");
+    size_t cycles = 0;
+    do {
+      sim_.RunCycle();
+      cycles++;
+      response_ = sim_.GetSerialOutputAsString();
+    } while (!sim_.IsFocusResponse(response_) && cycles < 10000);
+    response_ = sim_.StripFocusTerminator(response_);
+    return cycles;
+  }
+
+  std::string response_;
+};
+
+TEST_F(FocusBinary, IsAnnounced) {
+  auto response = sim_.SendFocusCommand("focus.binary");
+  EXPECT_THAT(response, ::testing::EndsWith("32 "));
+}
+
+TEST_F(FocusBinary, UploadsEEPROMContents) {
+  uint16_t length = Runtime.storage().length();
+  std::vector<uint8_t> text_data(length), binary_data(length);
+  for (uint16_t i = 0; i < length; i++) {
+    text_data[i]   = (i * 7) & 0xff;
+    binary_data[i] = (i * 13) & 0xff;
+  }
+  std::string text   = TextTransfer(text_data);
+  std::string binary = BinaryTransfer(binary_data);
+
+  // Each byte takes 2-4 characters as text, but little more than one in
+  // binary frames. Input is processed a bounded number of bytes per cycle, so
+  // the number of cycles an upload takes follows its size on the wire.
+  EXPECT_LT(binary.size() * 3, text.size());
+  size_t text_cycles   = CyclesToRespond("eeprom.contents " + text);
+  size_t binary_cycles = CyclesToRespond("eeprom.contents " + binary);
+  RecordProperty("text_cycles", text_cycles);
+  RecordProperty("binary_cycles", binary_cycles);
+  EXPECT_LT(binary_cycles * 3, text_cycles);
+
+  EXPECT_THAT(response_, ::testing::EndsWith(std::to_string(length) + " "));
+
+  std::vector<uint8_t> contents(length);
+  Runtime.storage().readBlock(0, contents.data(), length);
+  EXPECT_EQ(contents, binary_data);
+}
+
+TEST_F(FocusBinary, UploadsKeymapsAcrossFrames) {
+  uint8_t num_keys = Runtime.device().numKeys();
+  std::vector<uint8_t> data;
+  // All of the first layer, and half of the second.
+  for (uint16_t i = 0; i < num_keys + num_keys / 2; i++) {
+    Key key = Key(Key_A.getKeyCode() + i % 26, KEY_FLAGS);
+    data.push_back(key.getRaw() & 0xff);
+    data.push_back(key.getRaw() >> 8);
+  }
+
+  // Odd frame sizes split keys between frames
+  auto response = sim_.SendFocusCommand("keymap.custom " + BinaryTransfer(data, 31));
+  EXPECT_THAT(response, ::testing::EndsWith(std::to_string(data.size()) + " "));
+
+  for (auto key_addr : KeyAddr::all()) {
+    uint8_t i = key_addr.toInt();
+    EXPECT_EQ(::EEPROMKeymap.getKey(0, key_addr), Key(Key_A.getKeyCode() + i % 26, KEY_FLAGS));
+    if (i < num_keys / 2) {
+      EXPECT_EQ(::EEPROMKeymap.getKey(1, key_addr),
+                Key(Key_A.getKeyCode() + (num_keys + i) % 26, KEY_FLAGS));
+    }
+  }
+}
+
+TEST_F(FocusBinary, DropsTheRestOfABrokenTransfer) {
+  std::vector<uint8_t> data(64, 0x11);
+  sim_.SendFocusCommand("eeprom.contents " + BinaryTransfer(data));
+
+  std::fill(data.begin(), data.end(), 0x22);
+  std::string transfer = BinaryTransfer(data);
+  // Corrupt the payload of the second frame
+  transfer[1 + 35 + 5] ^= 0xff;
+
+  // The rest of the transfer is dropped until the host stops sending for a
+  // second, and the transfer is aborted
+  CyclesToRespond("eeprom.contents " + transfer);
+  EXPECT_THAT(response_, ::testing::HasSubstr("error: transfer aborted after 32 bytes"));
+  EXPECT_EQ(Runtime.storage().read(31), 0x22);
+  EXPECT_EQ(Runtime.storage().read(32), 0x11) << "Nothing past the broken frame is written";
+
+  // The port is usable afterwards
+  auto response = sim_.SendFocusCommand("focus.binary");
+  EXPECT_THAT(response, ::testing::EndsWith("32 "));
+}
+
+TEST_F(FocusBinary, AbortsAnUnfinishedTransfer) {
+  // Half a layer, which is only stored once the transfer is over
+  uint8_t num_keys = Runtime.device().numKeys() / 2;
+  std::vector<uint8_t> data(num_keys * 2, 0);
+  for (uint8_t i = 0; i < num_keys; i++)
+    data[i * 2] = Key_A.getKeyCode();
+  std::string transfer = BinaryTransfer(data);
+  // Drop the empty frame, as if the host went away
+  transfer.resize(transfer.size() - 3);
+
+  // An aborted transfer leaves the layer as it was
+  Key before = ::EEPROMKeymap.getKey(0, KeyAddr(0, 0));
+  CyclesToRespond("keymap.custom " + transfer);
+  EXPECT_THAT(response_, ::testing::HasSubstr("error: transfer aborted after " +
+                                              std::to_string(data.size()) + " bytes"));
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, KeyAddr(0, 0)), before);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
@@ -0,0 +1,77 @@
+// -*- mode: c++ -*-
+// Copyright 2016 Keyboardio, inc. <jesse@keyboard.io>
+// See "LICENSE" for license details
+
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-FocusSerial.h"
+
+#define KALEIDOSCOPE_FIRMWARE_VERSION "0.1.2"
+
+#include "Kaleidoscope-FirmwareVersion.h"
+
+// *INDENT-OFF*
+
+KEYMAPS(
+  [0] = KEYMAP_STACKED
+  (
+    XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX
+
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+          ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX
+  )
+) // KEYMAPS(
+
+// *INDENT-ON*
+
+namespace kaleidoscope {
+
+// Lists its command, and echoes whatever it is called with.
+class TableCommand : public Plugin {
+ public:
+  EventHandlerResult onFocusEvent(const char *input) {
+    ::Focus.sendRaw(F("table:"), input);
+    return EventHandlerResult::EVENT_CONSUMED;
+  }
+  static bool focusCommand(uint16_t hash, const char *command);
+};
+
+FOCUS_COMMANDS(TableCommand, "table")
+
+// Doesn't list its command, so it is offered all of them.
+class LegacyCommand : public Plugin {
+ public:
+  EventHandlerResult onFocusEvent(const char *input) {
+    if (::Focus.inputMatchesHelp(input))
+      return ::Focus.printHelp(PSTR("legacy"));
+
+    if (!::Focus.inputMatchesCommand(input, PSTR("legacy")))
+      return EventHandlerResult::OK;
+
+    ::Focus.sendRaw(F("legacy:"), input);
+    return EventHandlerResult::EVENT_CONSUMED;
+  }
+};
+
+}  // namespace kaleidoscope
+
+kaleidoscope::TableCommand TableCommand;
+kaleidoscope::LegacyCommand LegacyCommand;
+
+KALEIDOSCOPE_INIT_PLUGINS(Focus, FirmwareVersion, TableCommand, LegacyCommand);
+
+void setup() {
+  Kaleidoscope.setup();
+}
+
+void loop() {
+  Kaleidoscope.loop();
+}
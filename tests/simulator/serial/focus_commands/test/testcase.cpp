@@ -0,0 +1,70 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "gmock/gmock.h"  // For matchers like Eq()
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+class FocusCommandTable : public VirtualDeviceTest {
+ protected:
+  // Sends a command, and returns its response alone, without the output of
+  // the commands sent before it.
+  std::string Send(const std::string &command) {
+    std::string output = sim_.SendFocusCommand(command);
+    size_t end         = output.rfind("\r\n.\r\n");
+    return end == std::string::npos ? output : output.substr(end + 5);
+  }
+};
+
+TEST_F(FocusCommandTable, HelpListsTheTables) {
+  RunCycle();
+
+  EXPECT_EQ(Send("help"),
+            "help\r\n"
+            "device.reset\r\n"
+            "led.modes\r\n"
+            "plugins\r\n"
+            "focus.binary\r\n"
+            "version\r\n"
+            "table\r\n"
+            "legacy\r\n")
+    << "The tables are listed, and the plugin without one is asked for help";
+}
+
+TEST_F(FocusCommandTable, OnlyThePluginWithTheCommandIsCalled) {
+  RunCycle();
+
+  EXPECT_EQ(Send("version"), "0.1.2");
+  EXPECT_EQ(Send("table"), "table:table");
+}
+
+TEST_F(FocusCommandTable, PluginsWithoutATableGetEveryCommand) {
+  RunCycle();
+
+  EXPECT_EQ(Send("legacy"), "legacy:legacy");
+  EXPECT_EQ(Send("tablet"), "")
+    << "A command that isn't in any table only reaches the plugin without one";
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
@@ -0,0 +1,86 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-EEPROM-Keymap.h"
+#include "Kaleidoscope-EEPROM-Settings.h"
+#include "gmock/gmock.h"  // For matchers like Eq()
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+constexpr KeyAddr key_addr_A{2, 1};
+
+class FocusStreaming : public VirtualDeviceTest {};
+
+TEST_F(FocusStreaming, KeepsScanningDuringAnUpload) {
+  RunCycle();
+
+  // Start uploading keys to the first custom layer, and pause halfway
+  sim_.SendString("keymap.custom 4 5 6 ");
+  sim_.RunCycles(10);
+
+  sim_.Press(key_addr_A);
+  auto state = RunCycle();
+  ASSERT_EQ(state->HIDReports()->Keyboard().size(), 1)
+    << "Keys are scanned while the upload is in progress";
+  sim_.Release(key_addr_A);
+  RunCycle();
+
+  EXPECT_FALSE(sim_.IsFocusResponse(sim_.GetSerialOutputAsString()))
+    << "The command is not over until its line is";
+
+  sim_.SendFocusCommand("7");
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, KeyAddr{0, 0}), Key_A);
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, KeyAddr{0, 1}), Key_B);
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, KeyAddr{0, 2}), Key_C);
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, KeyAddr{0, 3}), Key_D);
+}
+
+TEST_F(FocusStreaming, EndsAnAbandonedUpload) {
+  sim_.SendString("keymap.custom 8 9");
+  sim_.RunForMillis(1100);
+
+  EXPECT_TRUE(sim_.IsFocusResponse(sim_.GetSerialOutputAsString()))
+    << "The command is over once the host stopped sending for a second";
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, KeyAddr{0, 0}), Key_E);
+  EXPECT_EQ(::EEPROMKeymap.getKey(0, KeyAddr{0, 1}), Key_F);
+}
+
+TEST_F(FocusStreaming, DispatchesOnceTheArgumentsArrived) {
+  RunCycle();
+  sim_.SendFocusCommand("keymap.onlyCustom 0");
+
+  // A command that reads its arguments is only dispatched once they're
+  // all there, so that reading them never waits for the host.
+  sim_.SendString("keymap.onlyCustom 1");
+  sim_.RunCycles(5);
+  EXPECT_FALSE(::EEPROMSettings.ignoreHardcodedLayers());
+  EXPECT_FALSE(sim_.IsFocusResponse(sim_.GetSerialOutputAsString()));
+
+  sim_.SendString("\n");
+  RunCycle();
+  EXPECT_TRUE(::EEPROMSettings.ignoreHardcodedLayers());
+  EXPECT_TRUE(sim_.IsFocusResponse(sim_.GetSerialOutputAsString()));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
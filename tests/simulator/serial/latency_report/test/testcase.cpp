@@ -0,0 +1,104 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sstream>  // for istringstream
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-LatencyReport.h"
+#include "gmock/gmock.h"  // For matchers like Eq()
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+class LatencyReportTest : public VirtualDeviceTest {
+ protected:
+  // Sends `latency.histogram`, and returns its buckets, as the start of each,
+  // and the number of presses in it.
+  std::vector<std::pair<uint32_t, uint16_t>> QueryHistogram() {
+    std::istringstream response(sim_.SendFocusCommand("latency.histogram"));
+    std::vector<std::pair<uint32_t, uint16_t>> buckets;
+    uint32_t start;
+    uint16_t count;
+    while (response >> start >> count)
+      buckets.emplace_back(start, count);
+    return buckets;
+  }
+
+  uint32_t TotalCount() {
+    uint32_t total = 0;
+    for (auto bucket : QueryHistogram())
+      total += bucket.second;
+    return total;
+  }
+
+  void Tap(uint8_t row, uint8_t col) {
+    sim_.Press(row, col);
+    RunCycle();
+    sim_.Release(row, col);
+    RunCycle();
+  }
+};
+
+TEST_F(LatencyReportTest, HasDoublingBuckets) {
+  auto buckets = QueryHistogram();
+  ASSERT_EQ(buckets.size(), ::LatencyReport.bucket_count);
+
+  EXPECT_EQ(buckets[0].first, 0u);
+  EXPECT_EQ(buckets[1].first, 500u);
+  for (uint8_t i = 2; i < buckets.size(); i++)
+    EXPECT_EQ(buckets[i].first, buckets[i - 1].first * 2) << "Bucket " << int(i);
+  EXPECT_EQ(buckets.back().first, 512000u);
+}
+
+TEST_F(LatencyReportTest, CountsReportedPresses) {
+  sim_.SendFocusCommand("latency.reset");
+  EXPECT_EQ(TotalCount(), 0u);
+
+  Tap(0, 0);
+  Tap(0, 1);
+  Tap(0, 0);
+  EXPECT_EQ(TotalCount(), 3u) << "Every press is counted once, releases aren't";
+
+  // The histogram agrees with the plugin's own view of it
+  auto buckets = QueryHistogram();
+  for (uint8_t i = 0; i < buckets.size(); i++)
+    EXPECT_EQ(buckets[i].second, ::LatencyReport.bucket(i)) << "Bucket " << int(i);
+
+  // A key that doesn't send anything has no latency to measure
+  Tap(0, 2);
+  EXPECT_EQ(TotalCount(), 3u);
+}
+
+TEST_F(LatencyReportTest, ResetClearsTheHistogram) {
+  Tap(0, 0);
+  Tap(0, 1);
+  EXPECT_GT(TotalCount(), 0u);
+
+  sim_.SendFocusCommand("latency.reset");
+  EXPECT_EQ(TotalCount(), 0u);
+  for (uint8_t i = 0; i < ::LatencyReport.bucket_count; i++)
+    EXPECT_EQ(::LatencyReport.bucket(i), 0u) << "Bucket " << int(i);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope
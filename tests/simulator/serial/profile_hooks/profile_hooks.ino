@@ -0,0 +1,64 @@
+// -*- mode: c++ -*-
+// Copyright 2025 Keyboardio, inc. <jesse@keyboard.io>
+// See "LICENSE" for license details
+
+#define KALEIDOSCOPE_PROFILE_HOOKS
+
+#include "Kaleidoscope.h"
+#include "Kaleidoscope-CycleTimeReport.h"
+#include "Kaleidoscope-FocusSerial.h"
+
+// *INDENT-OFF*
+
+KEYMAPS(
+  [0] = KEYMAP_STACKED
+  (
+    XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX
+
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+          ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX   ,XXX   ,XXX   ,XXX
+   ,XXX
+  )
+) // KEYMAPS(
+
+// *INDENT-ON*
+
+namespace kaleidoscope {
+namespace plugin {
+
+// A plugin with two handlers, for the profiler to time.
+class ProfiledPlugin : public kaleidoscope::Plugin {
+ public:
+  EventHandlerResult onKeyswitchEvent(KeyEvent &event) {
+    return EventHandlerResult::OK;
+  }
+  EventHandlerResult afterEachCycle() {
+    return EventHandlerResult::OK;
+  }
+};
+
+}  // namespace plugin
+}  // namespace kaleidoscope
+
+kaleidoscope::plugin::ProfiledPlugin ProfiledPlugin;
+
+// The periodic cycle time report would get mixed up with Focus responses.
+void kaleidoscope::plugin::CycleTimeReport::report(uint16_t mean_cycle_time) {}
+
+KALEIDOSCOPE_INIT_PLUGINS(ProfiledPlugin, Focus, CycleTimeReport);
+
+void setup() {
+  Kaleidoscope.setup();
+}
+
+void loop() {
+  Kaleidoscope.loop();
+}
@@ -0,0 +1,89 @@
+/* -*- mode: c++ -*-
+ * Copyright (C) 2025  Keyboard.io, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <map>      // for map
+#include <sstream>  // for istringstream
+#include <string>   // for string
+
+#include "testing/setup-googletest.h"
+#include "Kaleidoscope.h"
+#include "gmock/gmock.h"  // For matchers like Eq()
+
+SETUP_GOOGLETEST();
+
+namespace kaleidoscope {
+namespace testing {
+namespace {
+
+struct HookLine {
+  uint32_t calls, min_us, mean_us, max_us;
+};
+
+class ProfileHooks : public VirtualDeviceTest {
+ protected:
+  // Sends `profile.hooks`, and returns its lines, by plugin and hook name.
+  std::map<std::string, HookLine> QueryHooks() {
+    std::istringstream response(sim_.SendFocusCommand("profile.hooks"));
+    std::map<std::string, HookLine> lines;
+    std::string plugin, hook;
+    HookLine line;
+    while (response >> plugin >> hook >> line.calls >> line.min_us >> line.mean_us >> line.max_us)
+      lines[plugin + " " + hook] = line;
+    return lines;
+  }
+};
+
+TEST_F(ProfileHooks, CountsEveryCallOfEveryHandler) {
+  sim_.SendFocusCommand("profile.reset");
+  sim_.RunCycles(100);
+
+  auto lines = QueryHooks();
+  ASSERT_EQ(lines.count("ProfiledPlugin afterEachCycle"), 1u);
+  HookLine cycles = lines["ProfiledPlugin afterEachCycle"];
+  // The cycles that ran the Focus commands are counted too
+  EXPECT_GE(cycles.calls, 100u);
+  EXPECT_LE(cycles.calls, 110u);
+  EXPECT_LE(cycles.min_us, cycles.mean_us);
+  EXPECT_LE(cycles.mean_us, cycles.max_us);
+
+  // Only the handlers that have been called are listed
+  EXPECT_EQ(lines.count("ProfiledPlugin onKeyswitchEvent"), 0u);
+  EXPECT_EQ(lines.count("ProfiledPlugin beforeReportingState"), 0u)
+    << "Hooks the plugin doesn't implement are never profiled";
+  EXPECT_EQ(lines.count("Focus afterEachCycle"), 1u);
+
+  sim_.Press(0, 0);
+  RunCycle();
+  sim_.Release(0, 0);
+  RunCycle();
+
+  lines = QueryHooks();
+  ASSERT_EQ(lines.count("ProfiledPlugin onKeyswitchEvent"), 1u);
+  EXPECT_EQ(lines["ProfiledPlugin onKeyswitchEvent"].calls, 2u);
+}
+
+TEST_F(ProfileHooks, ResetsTheCounts) {
+  sim_.RunCycles(100);
+  sim_.SendFocusCommand("profile.reset");
+
+  auto lines = QueryHooks();
+  ASSERT_EQ(lines.count("ProfiledPlugin afterEachCycle"), 1u);
+  EXPECT_LT(lines["ProfiledPlugin afterEachCycle"].calls, 10u);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace kaleidoscope